@@ -1,4 +1,21 @@
 #include "include/ShapeLoaderAPI.h"
+#include "include/MappedFile.h"
+#include "include/ChunkTable.h"
+#include "include/ChunkValidator.h"
+#include "include/ByteSwap.h"
+#include "include/PackedVertexKernel.h"
+#include "include/VertexDecoder.h"
+#include "include/VertexProcessor.h"
+#include "include/IntegerGeometry.h"
+#include "include/FaceDeduplicator.h"
+#include "include/MemoryPool.h"
+#include "include/MemoryTracker.h"
+#include "include/ParseContext.h"
+#include "include/StreamingChunkReader.h"
+#include "include/ErrorHandler.h"
+#include "include/ThreadPool.h"
+#include "include/BatchFileList.h"
+#include "include/AsyncFileLoader.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -12,6 +29,11 @@
 #include <cmath>
 #include <set>
 #include <algorithm>
+#include <sstream>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <memory_resource>
 
 using namespace ShapeLoader;
 
@@ -20,21 +42,46 @@ struct Triangle {
     Triangle(int a, int b, int c) : v1(a), v2(b), v3(c) {}
 };
 
+// Buffered conversions size these once in the ParseArena; streamed ones grow
+// them chunk by chunk on the tracked heap, which frees the outgrown buffers
+typedef std::pmr::vector<VertexData> VertexArray;
+typedef std::pmr::vector<Triangle> TriangleArray;
+
 class Converter {
 private:
     std::ofstream objFile;
     std::ofstream mtlFile;
     std::string baseName;
     std::string materialName;
-
-    struct ChunkInfo {
-        std::string name;
-        size_t position;
-        size_t size;
-    };
+    std::ostream& logOut;
+    std::ostream& errorOut;
+    size_t writtenVertexCount = 0;
+    size_t writtenFaceCount = 0;
+    float shapeBounds[6] = {};      // Min x/y/z then max x/y/z of the decoded vertices
+    bool hasShapeBounds = false;
+    bool weldVertices = false;      // Weld Dot2/cDot shapes in the integer domain before writing
+    bool integerDomain = false;     // Positions of the current shape are still in integerPositions
+    ThreadPool* decodePool = nullptr;   // Runs vertex batch tiles, nullptr decodes on the calling thread
+    std::unique_ptr<ParseContext> ownContext;   // Only when no context is shared in
+    ParseContext& parseContext;     // Buffers reused from shape to shape
+    ParseArena& arena;              // Temporaries of the current shape, sized once
+    std::pmr::memory_resource* growable = MemoryTracker::GetResource(MemorySubsystem::ConverterHeap);  // Arrays that grow per chunk
+    IntegerVertexArray integerPositions{growable};
+    FaceDeduplicator faceSet{growable};     // Triangles the Prim and Line paths have emitted for the current shape
 
 public:
-    Converter(const std::string& outputPath) {
+    /**
+     * @param outputPath Output base name, ".obj" extension optional
+     * @param log Progress output (batch mode gives every file its own buffer)
+     * @param errors Error output
+     * @param context Parse buffers to reuse (batch mode keeps one per worker), nullptr = own buffers
+     */
+    Converter(const std::string& outputPath, std::ostream& log = std::cout, std::ostream& errors = std::cerr,
+              ParseContext* context = nullptr)
+        : logOut(log), errorOut(errors),
+          ownContext(context ? nullptr : std::make_unique<ParseContext>()),
+          parseContext(context ? *context : *ownContext),
+          arena(parseContext.GetArena()) {
         baseName = outputPath;
 
         if (baseName.length() >= 4) {
@@ -90,35 +137,192 @@ public:
         mtlFile << std::endl;
     }
     
-    bool ConvertFrom3GM(const std::vector<uint8_t>& data, const std::string& shapeName) {
-        std::cout << "\n=== 3GM to OBJ Conversion ===" << std::endl;
-        std::cout << "Input file size: " << data.size() << " bytes" << std::endl;
+    /**
+     * First half of ConvertFrom3GM: find the chunks and measure the shape
+     * Batch mode calls it to size its memory reservation (GetMemoryEstimate)
+     * before converting; ConvertFrom3GM then goes on from the chunk table
+     * and sizes found here instead of walking the file again.
+     * @return false if no chunks were found
+     */
+    bool MeasureFrom3GM(ByteSpan data) {
+        logOut << "\n=== 3GM to OBJ Conversion ===" << std::endl;
+        logOut << "Input file size: " << data.size() << " bytes" << std::endl;
+        
+        BeginShape();
+        measuredData = data;
+        if (!FindAllChunks(data, parseContext.GetChunkTable())) {
+            return false;
+        }
+        measuredSizes = MeasureShape(data, parseContext.GetChunkTable(), measuredLayouts);
+        return true;
+    }
+    
+    /**
+     * Expected peak of converting the data MeasureFrom3GM measured, its contents excluded
+     * @param largestChunk Set to the size of the largest chunk
+     */
+    size_t GetMemoryEstimate(size_t* largestChunk = nullptr) const {
+        return EstimateMemory(measuredSizes, parseContext.GetChunkTable(), weldVertices, largestChunk);
+    }
+    
+    bool ConvertFrom3GM(ByteSpan data, const std::string& shapeName) {
+        if (measuredData.empty() || measuredData.data() != data.data() || measuredData.size() != data.size()) {
+            MeasureFrom3GM(data);
+        }
+        measuredData = ByteSpan();
         
-        std::map<std::string, ChunkInfo> chunks;
-        if (!FindAllChunks(data, chunks)) {
-            std::cerr << "ERROR: Could not find valid chunks in 3GM file" << std::endl;
+        ChunkTable& chunks = parseContext.GetChunkTable();
+        if (chunks.IsEmpty()) {
+            errorOut << "ERROR: Could not find valid chunks in 3GM file" << std::endl;
             return false;
         }
         
-        std::vector<VertexData> vertices;
-        int totalVertices = ParseAllVertexChunks(data, chunks, vertices);
+        // Every output buffer is allocated once, at its measured size
+        const ShapeSizes& sizes = measuredSizes;
+        const CDotLayoutArray& cDotLayouts = measuredLayouts;
+        logOut << "Pre-sized for " << sizes.GetVertexCount() << " vertices, " << sizes.faceCount << " faces" << std::endl;
+        
+        VertexArray vertices(&arena);
+        TriangleArray faces(&arena);
+        if (integerDomain && sizes.floatVertexCount == 0) {
+            integerPositions.reserve(sizes.integerVertexCount);
+        } else {
+            vertices.reserve(sizes.GetVertexCount() + sizes.batchSlots);
+        }
+        faces.reserve(sizes.faceCount);
+        faceSet.Reserve(sizes.faceCount);
+        
+        int totalVertices = ParseAllVertexChunks(data, chunks, cDotLayouts, vertices);
         
         if (totalVertices == 0) {
-            std::cerr << "ERROR: No vertices found in any chunk" << std::endl;
+            errorOut << "ERROR: No vertices found in any chunk" << std::endl;
             return false;
         }
         
-        std::vector<Triangle> faces;
-        
         // Handle Line chunks with original surface creation system
-        if (chunks.find("Line") != chunks.end()) {
-            ParseLineChunkWithSurfaceSystem(data, chunks, faces, vertices);
+        if (chunks.Contains(ChunkType::Line)) {
+            ParseLineChunkWithSurfaceSystem(data, chunks, faces, GetParsedVertexCount(vertices));
         } else {
             // Fallback to Prim chunks
-            ParsePrimChunk(data, chunks, faces, vertices.size());
+            ParsePrimChunk(data, chunks, faces, GetParsedVertexCount(vertices));
         }
         int totalFaces = faces.size();
         
+        if (integerDomain) {
+            WeldIntegerShape(vertices, faces);
+        }
+        WriteShape(vertices, faces, shapeName);
+        return true;
+    }
+    
+    /**
+     * Convert from a byte stream with bounded memory
+     * Each vertex, Prim and Line chunk is decoded as soon as it is complete;
+     * only the decoded shape is kept, never the whole input file.
+     */
+    bool ConvertFromStream(ByteSource& source, const std::string& shapeName, size_t windowSize) {
+        logOut << "\n=== 3GM to OBJ Conversion (streaming) ===" << std::endl;
+        logOut << "Streaming window: " << windowSize << " bytes" << std::endl;
+        
+        BeginShape();
+        // Sizes are only known once the last chunk is in: grow where outgrown buffers are freed
+        VertexArray vertices(growable);
+        TriangleArray faces(growable);
+        bool hasLine = false;
+        bool hasPrim = false;
+        
+        StreamingChunkReader reader(windowSize);
+        reader.SetWindowBuffer(&parseContext.GetStreamWindow());
+        
+        // Chunk handlers see one chunk at a time; the table entry is relative to the chunk span
+        auto makeEntry = [](const ChunkHeader& header, ByteSpan chunk) {
+            ChunkTableEntry entry;
+            entry.header = header;
+            entry.position = 0;
+            entry.size = chunk.size();
+            return entry;
+        };
+        
+        auto vertexHandler = [&](const ChunkHeader& header, ByteSpan chunk, size_t streamOffset) {
+            logOut << "Streamed chunk: '" << header.GetName() << "' at position " << streamOffset << std::endl;
+            ChunkTableEntry entry = makeEntry(header, chunk);
+            switch (header.type) {
+                case ChunkType::Dot2: ParseDot2Chunk(chunk, entry, vertices); break;
+                case ChunkType::FDot: ParseFDotChunk(chunk, entry, vertices); break;
+                case ChunkType::Dots: ParseDotsChunk(chunk, entry, vertices); break;
+                case ChunkType::cDot: ParseCDotChunk(chunk, entry, vertices); break;
+                default: break;
+            }
+            return true;
+        };
+        reader.SetHandler(ChunkType::Dot2, vertexHandler);
+        reader.SetHandler(ChunkType::FDot, vertexHandler);
+        reader.SetHandler(ChunkType::Dots, vertexHandler);
+        reader.SetHandler(ChunkType::cDot, vertexHandler);
+        
+        reader.SetHandler(ChunkType::Prim, [&](const ChunkHeader& header, ByteSpan chunk, size_t streamOffset) {
+            logOut << "Streamed chunk: 'Prim' at position " << streamOffset << std::endl;
+            if (!hasLine) {
+                hasPrim = true;
+                ChunkTableEntry entry = makeEntry(header, chunk);
+                ReserveAtLeast(faces, faces.size() + GetPrimFaceBound(entry));
+                faceSet.Reserve(faces.size() + GetPrimFaceBound(entry));
+                ParsePrimEntry(chunk, entry, faces, GetParsedVertexCount(vertices));
+            }
+            return true;
+        });
+        
+        reader.SetHandler(ChunkType::Line, [&](const ChunkHeader& header, ByteSpan chunk, size_t streamOffset) {
+            logOut << "Streamed chunk: 'Line' at position " << streamOffset << std::endl;
+            // Line takes precedence over Prim, same as the buffered path
+            if (!hasLine && hasPrim) {
+                faces.clear();
+                faceSet.Clear();
+            }
+            hasLine = true;
+            ChunkTableEntry entry = makeEntry(header, chunk);
+            ReserveAtLeast(faces, faces.size() + GetLineFaceBound(entry));
+            faceSet.Reserve(faces.size() + GetLineFaceBound(entry));
+            ParseLineChunk(chunk, entry, faces, GetParsedVertexCount(vertices));
+            return true;
+        });
+        
+        if (!reader.Run(source)) {
+            if (reader.GetOversizeChunkBytes() > 0) {
+                errorOut << "ERROR: Chunk of " << reader.GetOversizeChunkBytes() << " bytes does not fit the "
+                          << reader.GetWindowSize() << "-byte streaming window (raise --window or --max-memory)" << std::endl;
+                return false;
+            }
+            errorOut << "ERROR: Streaming parse failed after " << reader.GetBytesRead() 
+                      << " bytes (run with -d for details, --window to raise the chunk limit)" << std::endl;
+            return false;
+        }
+        
+        logOut << "Streamed " << reader.GetBytesRead() << " bytes, " << reader.GetChunksDelivered()
+                  << " chunks decoded, " << reader.GetChunksSkipped() << " skipped, peak window "
+                  << reader.GetPeakBuffered() << " bytes" << std::endl;
+        
+        size_t vertexCount = GetParsedVertexCount(vertices);
+        if (vertexCount == 0) {
+            errorOut << "ERROR: No vertices found in any chunk" << std::endl;
+            return false;
+        }
+        
+        if (!hasLine && !hasPrim) {
+            faces.reserve(vertexCount / 3);
+            for (size_t i = 0; i + 2 < vertexCount; i += 3) {
+                faces.push_back(Triangle(static_cast<int>(i), static_cast<int>(i + 1), static_cast<int>(i + 2)));
+            }
+        }
+        
+        if (integerDomain) {
+            WeldIntegerShape(vertices, faces);
+        }
+        WriteShape(vertices, faces, shapeName);
+        return true;
+    }
+    
+    void WriteShape(const VertexArray& vertices, const TriangleArray& faces, const std::string& shapeName) {
         objFile << "# Total vertices: " << vertices.size() << std::endl;
         objFile << "# Total faces: " << faces.size() << std::endl;
         objFile << std::endl;
@@ -154,17 +358,61 @@ public:
                     << " " << (face.v3 + 1) << "/" << (face.v3 + 1) << std::endl;
         }
         
-        std::cout << "\n✓ Conversion completed!" << std::endl;
-        std::cout << "  - Vertices: " << vertices.size() << std::endl;
-        std::cout << "  - Faces: " << faces.size() << std::endl;
-        std::cout << "  - Output: " << baseName << ".obj" << std::endl;
+        writtenVertexCount = vertices.size();
+        writtenFaceCount = faces.size();
         
-        return true;
+        logOut << "\n✓ Conversion completed!" << std::endl;
+        logOut << "  - Vertices: " << vertices.size() << std::endl;
+        logOut << "  - Faces: " << faces.size() << std::endl;
+        if (hasShapeBounds) {
+            logOut << "  - Bounds: (" << shapeBounds[0] << ", " << shapeBounds[1] << ", " << shapeBounds[2] 
+                      << ") - (" << shapeBounds[3] << ", " << shapeBounds[4] << ", " << shapeBounds[5] << ")" << std::endl;
+        }
+        logOut << "  - Output: " << baseName << ".obj" << std::endl;
+    }
+    
+    size_t GetVertexCount() const { return writtenVertexCount; }
+    
+    /**
+     * Weld vertices with identical positions in Dot2/cDot shapes
+     * Positions stay integers until the shape is complete; a float vertex
+     * chunk (FDot, Dots) switches the shape back to the float path unwelded.
+     */
+    void SetWeldVertices(bool weld) { weldVertices = weld; }
+    
+    /**
+     * Pool for the tiles of the compressed FDot batch
+     * Batch mode leaves it unset: files already run in parallel there, and
+     * a converter on one of the pool's workers would run its tiles inline.
+     */
+    void SetDecodePool(ThreadPool* pool) { decodePool = pool; }
+    
+    /**
+     * Treat triangles with the same indices in any order as duplicates
+     * By default only rotations of a triangle are, so two-sided faces stay.
+     */
+    void SetIgnoreWinding(bool ignore) {
+        faceSet.SetWinding(ignore ? FaceDeduplicator::Winding::Ignore : FaceDeduplicator::Winding::Preserve);
     }
+    size_t GetFaceCount() const { return writtenFaceCount; }
     
-    void ConvertPackedVerticesUsingCppFunction(uint32_t* packedData, uint32_t vertexCount, std::vector<VertexData>& vertices) {
+    /**
+     * Expected peak of converting data, its contents excluded
+     * For input that is streamed rather than measured by MeasureFrom3GM:
+     * builds its own chunk table.
+     * @param largestChunk Set to the size of the largest chunk, the window a stream needs
+     */
+    static size_t EstimateMemory(ByteSpan data, bool weld, size_t* largestChunk = nullptr) {
+        ChunkTable chunks;
+        chunks.Build(data);
+        CDotLayoutArray cDotLayouts;
+        return EstimateMemory(MeasureShape(data, chunks, cDotLayouts), chunks, weld, largestChunk);
+    }
+    
+    void ConvertPackedVerticesUsingCppFunction(uint32_t* packedData, uint32_t vertexCount, VertexArray& vertices) {
         size_t outputSize = vertexCount * 8 + 1;
         std::vector<float> floatBuffer(outputSize);
+        vertices.reserve(vertices.size() + vertexCount);
         
         uint32_t result = Conversion::ConvertPackedToFloatVertices3Component(packedData, floatBuffer.data(), vertexCount);
         
@@ -185,13 +433,13 @@ public:
                 isValid = false;
             }
 
-            if (abs(vertex.x) > 100000.0f || abs(vertex.y) > 100000.0f || abs(vertex.z) > 100000.0f) {
+            if (std::abs(vertex.x) > 100000.0f || std::abs(vertex.y) > 100000.0f || std::abs(vertex.z) > 100000.0f) {
                 isValid = false;
             }
             
             if (!isValid) {
                 if (i < 5) {
-                    std::cout << "  SKIPPING Invalid C++ vertex " << i << ": (" << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
+                    logOut << "  SKIPPING Invalid C++ vertex " << i << ": (" << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
                 }
                 continue;
             }
@@ -217,455 +465,1014 @@ public:
     }
     
 private:
-    bool FindAllChunks(const std::vector<uint8_t>& data, std::map<std::string, ChunkInfo>& chunks) {
-        std::cout << "\nSearching for chunks..." << std::endl;
+    // Decoders write positions straight into VertexData, one vertex per stride
+    static_assert(sizeof(VertexData) % sizeof(float) == 0, "VertexData must be a whole number of floats");
+    static const size_t VERTEX_STRIDE = sizeof(VertexData) / sizeof(float);
+    
+    // Integer position, its welded copy, remap entry and hash node with bucket
+    static const size_t WELD_BYTES_PER_VERTEX = 2 * sizeof(IntegerVertex) + sizeof(uint32_t) + 64;
+    
+    // Vertices decoded and finished together, about 9 KB: the block is still in L1 when it is finished
+    static const size_t DECODE_BLOCK_VERTICES = 256;
+    
+    /**
+     * Decode records block by block, handing each block on while it is in cache
+     * Positions, bounds and the caller's per-vertex work (CompleteVertex,
+     * validation) touch a block one after the other, so the vertex array is
+     * walked once instead of decoded in one pass and finished in a second.
+     * @param stats Optional, reset and filled block by block
+     * @param finish Called as finish(first, count) after each block is decoded
+     */
+    template <typename Decoder, typename Finish>
+    static void DecodeInBlocks(const uint8_t* records, VertexData* out, size_t count,
+                               PackedVertexKernel::DecodeStats* stats, Finish finish) {
+        PackedVertexKernel::DecodeStats blockStats;
+        if (stats) {
+            stats->Reset(count);
+        }
+        for (size_t first = 0; first < count; first += DECODE_BLOCK_VERTICES) {
+            size_t blockCount = count - first < DECODE_BLOCK_VERTICES ? count - first : DECODE_BLOCK_VERTICES;
+            Decoder::Run(records + first * Decoder::RECORD_SIZE, &out[first].x, VERTEX_STRIDE, blockCount,
+                         stats ? &blockStats : nullptr);
+            if (stats) {
+                stats->Merge(blockStats, first);
+            }
+            finish(first, blockCount);
+        }
+    }
+    
+    /**
+     * Grow the shape bounds by the bounds gathered while decoding one chunk
+     */
+    void MergeBounds(const PackedVertexKernel::DecodeStats& stats) {
+        if (!stats.HasBounds()) {
+            return;
+        }
         
-        // Check for standard "3DGM" magic number, but don't require it
-        if (data.size() >= 4 && memcmp(data.data(), "3DGM", 4) == 0) {
-            std::cout << "✓ Valid 3DGM magic number found" << std::endl;
-        } else {
-            std::cout << "ℹ No 3DGM header found - checking for level file format" << std::endl;
+        float chunkBounds[6];
+        stats.GetBoundingBox(chunkBounds);
+        MergeBounds(chunkBounds);
+    }
+    
+    void MergeBounds(const float chunkBounds[6]) {
+        if (!hasShapeBounds) {
+            std::copy(chunkBounds, chunkBounds + 6, shapeBounds);
+            hasShapeBounds = true;
+            return;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            shapeBounds[axis] = std::min(shapeBounds[axis], chunkBounds[axis]);
+            shapeBounds[3 + axis] = std::max(shapeBounds[3 + axis], chunkBounds[3 + axis]);
+        }
+    }
+    
+    /**
+     * Start a shape: nothing from the previous one may still use the parse context
+     */
+    void BeginShape() {
+        hasShapeBounds = false;
+        integerDomain = weldVertices;
+        IntegerVertexArray(growable).swap(integerPositions);
+        faceSet.Release();
+        measuredData = ByteSpan();
+        measuredSizes = ShapeSizes();
+        CDotLayoutArray(&arena).swap(measuredLayouts);     // Its storage goes with the arena rewind below
+        parseContext.Begin();
+    }
+    
+    /**
+     * Get number of vertices parsed so far, whichever domain holds them
+     */
+    size_t GetParsedVertexCount(const VertexArray& vertices) const {
+        return integerDomain ? integerPositions.size() : vertices.size();
+    }
+    
+    /**
+     * Grow the shape bounds by integer positions, compared before any float conversion
+     */
+    void MergeIntegerBounds(const IntegerVertexArray& positions) {
+        int64_t minMax[6];
+        if (!IntegerGeometry::GetBounds(positions, minMax)) {
+            return;
+        }
+        
+        float bounds[6];
+        for (int i = 0; i < 6; i++) {
+            bounds[i] = IntegerGeometry::ToFloat(minMax[i]);
+        }
+        MergeBounds(bounds);
+    }
+    
+    /**
+     * Append integer positions as completed float vertices
+     */
+    static void AppendIntegerVertices(const IntegerVertexArray& positions, VertexArray& vertices) {
+        size_t first = vertices.size();
+        vertices.resize(first + positions.size());
+        VertexData* out = vertices.data() + first;
+        for (size_t i = 0; i < positions.size(); i++) {
+            out[i].x = IntegerGeometry::ToFloat(positions[i].x);
+            out[i].y = IntegerGeometry::ToFloat(positions[i].y);
+            out[i].z = IntegerGeometry::ToFloat(positions[i].z);
+            CompleteVertex(out[i], true, 0.001f);
+        }
+    }
+    
+    /**
+     * Move the shape to the float path before a float vertex chunk
+     * Vertices decoded so far are converted in order, so indices stay valid.
+     */
+    void LeaveIntegerDomain(VertexArray& vertices) {
+        if (!integerDomain) {
+            return;
         }
         
-        std::vector<std::string> knownChunks = {
-            "3DGM", "FDot", "Dot2", "Dots", "cDot", "Prim", "Line", 
-            "Pos ", "fPos", "Grp2", "Atr2", "TxNm", "SmGr", "End "
+        logOut << "Float vertex chunk in shape, vertices are not welded" << std::endl;
+        MergeIntegerBounds(integerPositions);
+        AppendIntegerVertices(integerPositions, vertices);
+        integerPositions.clear();
+        integerDomain = false;
+    }
+    
+    /**
+     * Weld the integer positions, remap faces and convert the unique positions
+     * Faces that collapse onto fewer than three distinct vertices are dropped,
+     * and faces that only become identical once welded are deduplicated again.
+     */
+    void WeldIntegerShape(VertexArray& vertices, TriangleArray& faces) {
+        IntegerVertexArray unique(&arena);
+        std::pmr::vector<uint32_t> remap(&arena);
+        size_t uniqueCount = IntegerGeometry::Weld(integerPositions, unique, remap);
+        
+        // The set still holds pre-weld keys; it is rebuilt over the welded indices
+        faceSet.Clear();
+        faceSet.Reserve(faces.size());
+        
+        size_t kept = 0;
+        size_t degenerate = 0;
+        for (const Triangle& face : faces) {
+            uint32_t v1 = remap[face.v1];
+            uint32_t v2 = remap[face.v2];
+            uint32_t v3 = remap[face.v3];
+            if (v1 == v2 || v2 == v3 || v1 == v3) {
+                degenerate++;
+                continue;
+            }
+            if (faceSet.Insert(v1, v2, v3)) {
+                faces[kept++] = Triangle(static_cast<int>(v1), static_cast<int>(v2), static_cast<int>(v3));
+            }
+        }
+        
+        logOut << "Welded " << integerPositions.size() << " vertices to " << uniqueCount
+               << ", dropped " << degenerate << " degenerate and " << (faces.size() - kept - degenerate)
+               << " duplicate faces" << std::endl;
+        faces.erase(faces.begin() + kept, faces.end());
+        
+        MergeIntegerBounds(unique);
+        vertices.clear();
+        AppendIntegerVertices(unique, vertices);
+        integerPositions.clear();
+        integerDomain = false;
+    }
+    
+    /**
+     * How a cDot chunk's header word was interpreted
+     * The word in front of the vertices has been seen both as the payload
+     * size and as a vertex count in either byte order. Probed once per chunk;
+     * the count never exceeds what the table's payload size can hold.
+     */
+    struct CDotFormat {
+        enum class CountSource {
+            PayloadSize,        // Header word is the byte size, count = payload / 6
+            BigEndianCount,
+            LittleEndianCount
         };
         
-        for (size_t pos = 0; pos <= data.size() - 4; pos++) {
-            std::string chunkName(reinterpret_cast<const char*>(&data[pos]), 4);
-            
-            for (const auto& known : knownChunks) {
-                if (chunkName == known) {
-                    ChunkInfo chunk;
-                    chunk.name = chunkName;
-                    chunk.position = pos;
-                    chunk.size = data.size() - pos;
-
-                    for (size_t nextPos = pos + 4; nextPos <= data.size() - 4; nextPos++) {
-                        std::string nextChunk(reinterpret_cast<const char*>(&data[nextPos]), 4);
-
-                        for (const auto& knownNext : knownChunks) {
-                            if (nextChunk == knownNext && nextPos > pos + 4) {
-                                chunk.size = nextPos - pos;
-                                break;
-                            }
-                        }
-
-                        if (chunk.size != data.size() - pos) break;
-                    }
-                    
-                    chunks[chunkName] = chunk;
-                    std::cout << "Found chunk: '" << chunkName << "' at position " << pos 
-                              << ", size: " << chunk.size << " bytes" << std::endl;
+        CountSource source;
+        size_t vertexCount;
+        
+        const char* GetSourceName() const {
+            switch (source) {
+                case CountSource::BigEndianCount:    return "big-endian vertex count";
+                case CountSource::LittleEndianCount: return "little-endian vertex count";
+                default:                             return "payload size";
+            }
+        }
+    };
+    
+    /**
+     * Record layout of a cDot chunk and the probe its count came from
+     */
+    struct CDotLayout {
+        bool valid = false;         // False if the chunk is too short for its header word
+        ChunkRecordLayout records;
+        CDotFormat format;
+    };
+    typedef std::pmr::vector<CDotLayout> CDotLayoutArray;
+    
+    /**
+     * Buffer sizes of a shape, measured from the chunk table before decoding
+     */
+    struct ShapeSizes {
+        size_t integerVertexCount = 0;  // Dot2, cDot records (exact)
+        size_t floatVertexCount = 0;    // FDot, Dots records (bound, invalid vertices are dropped)
+        size_t batchSlots = 0;          // Spare vertex per compressed FDot chunk for its batch terminator
+        size_t faceCount = 0;           // Bound for the face generator that will run
+        
+        size_t GetVertexCount() const { return integerVertexCount + floatVertexCount; }
+    };
+    
+    // What MeasureFrom3GM found, for ConvertFrom3GM; the layouts live in the arena until the next shape
+    ByteSpan measuredData;
+    ShapeSizes measuredSizes;
+    CDotLayoutArray measuredLayouts{&arena};
+    
+    /**
+     * Sizing pre-pass over the chunk table
+     * Record counts come from the same layouts the decoders validate, each
+     * bounded by its chunk's table entry, so Dot2/cDot vertex counts are
+     * exact. FDot/Dots decoders drop invalid records, so theirs are bounds,
+     * as are the face counts of the generators.
+     */
+    static ShapeSizes MeasureShape(ByteSpan data, const ChunkTable& chunks, CDotLayoutArray& cDotLayouts) {
+        ShapeSizes sizes;
+        size_t lineFaces = 0;
+        size_t primFaces = 0;
+        bool hasPrim = false;
+        
+        for (const auto& chunk : chunks.GetEntries()) {
+            ChunkRecordLayout layout;
+            bool hasLayout = false;
+            switch (chunk.GetType()) {
+                case ChunkType::Dot2: hasLayout = GetDot2Layout(data, chunk, layout); break;
+                case ChunkType::FDot: hasLayout = GetFDotLayout(data, chunk, layout); break;
+                case ChunkType::Dots: hasLayout = GetDotsLayout(data, chunk, layout); break;
+                case ChunkType::cDot:
+                    // Kept for ParseAllVertexChunks, so the header word is probed once
+                    cDotLayouts.emplace_back();
+                    hasLayout = GetCDotLayout(data, chunk, cDotLayouts.back());
+                    layout = cDotLayouts.back().records;
                     break;
-                }
+                case ChunkType::Line: lineFaces += GetLineFaceBound(chunk); break;
+                case ChunkType::Prim: primFaces += GetPrimFaceBound(chunk); hasPrim = true; break;
+                default: break;
+            }
+            
+            // Decoders skip chunks whose records do not fit the data
+            ValidatedChunk records;
+            if (!hasLayout || !ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+                continue;
+            }
+            if (chunk.GetType() == ChunkType::Dot2 || chunk.GetType() == ChunkType::cDot) {
+                sizes.integerVertexCount += records.GetRecordCount();
+            } else {
+                sizes.floatVertexCount += records.GetRecordCount();
+            }
+            if (chunk.GetType() == ChunkType::FDot && IsCompressedFDot(chunk)) {
+                sizes.batchSlots++;
             }
         }
         
-        std::cout << "Total chunks found: " << chunks.size() << std::endl;
-        return !chunks.empty();
+        // Line takes precedence over Prim; without either, vertices form a triangle list
+        if (chunks.Contains(ChunkType::Line)) {
+            sizes.faceCount = lineFaces;
+        } else if (hasPrim) {
+            sizes.faceCount = primFaces;
+        } else {
+            sizes.faceCount = sizes.GetVertexCount() / 3;
+        }
+        return sizes;
     }
     
-    int ParseAllVertexChunks(const std::vector<uint8_t>& data, const std::map<std::string, ChunkInfo>& chunks, std::vector<VertexData>& vertices) {
-        std::cout << "\nParsing vertex chunks..." << std::endl;
+    /**
+     * Sized the way ConvertFrom3GM pre-sizes its buffers: vertices, faces
+     * and the face set, plus the integer positions and weld tables when
+     * welding. Arena blocks and arrays grow by doubling, so while growing
+     * they hold up to three times their contents.
+     */
+    static size_t EstimateMemory(const ShapeSizes& sizes, const ChunkTable& chunks, bool weld, size_t* largestChunk) {
+        if (largestChunk) {
+            *largestChunk = 0;
+            for (const auto& chunk : chunks.GetEntries()) {
+                *largestChunk = std::max(*largestChunk, chunk.size);
+            }
+        }
         
-        int totalVertices = 0;
+        size_t faceSlots = 16;
+        while (faceSlots / 2 < sizes.faceCount) {
+            faceSlots *= 2;
+        }
+        size_t bytes = (sizes.GetVertexCount() + sizes.batchSlots) * sizeof(VertexData) +
+                       sizes.faceCount * sizeof(Triangle) + faceSlots * 3 * sizeof(uint32_t);
+        if (weld) {
+            bytes += sizes.integerVertexCount * WELD_BYTES_PER_VERTEX;
+        }
+        return bytes * 3 + ParseArena::DEFAULT_BLOCK_SIZE;
+    }
+    
+    /**
+     * Most faces a Line chunk can generate
+     * A primitive of n parameters takes n + 1 words and yields at most
+     * 2 (n + 1) / 5 faces, two per quad being the densest case.
+     */
+    static size_t GetLineFaceBound(const ChunkTableEntry& lineChunk) {
+        size_t dataSize = lineChunk.GetDataSize();
+        size_t wordCount = dataSize >= 2 ? (dataSize - 1) / 2 : 0;
+        return wordCount * 2 / 5;
+    }
+    
+    /**
+     * Most faces a Prim chunk can generate
+     * Each end-of-primitive word that yields faces (at most two) needs the
+     * four index words before it, so such words are at least five apart.
+     */
+    static size_t GetPrimFaceBound(const ChunkTableEntry& primChunk) {
+        return primChunk.GetDataSize() / 4 / 5 * 2;
+    }
+    
+    /**
+     * Grow capacity geometrically to at least count elements
+     * Keeps chunk-by-chunk reserves (streaming) amortised.
+     */
+    template <typename Array>
+    static void ReserveAtLeast(Array& array, size_t count) {
+        if (count > array.capacity()) {
+            array.reserve(std::max(count, array.capacity() * 2));
+        }
+    }
+    
+    bool FindAllChunks(ByteSpan data, ChunkTable& chunks) {
+        logOut << "\nSearching for chunks..." << std::endl;
+        
+        // Check for standard "3DGM" magic number, but don't require it
+        if (data.size() >= 4 && memcmp(data.data(), "3DGM", 4) == 0) {
+            logOut << "✓ Valid 3DGM magic number found" << std::endl;
+        } else {
+            logOut << "ℹ No 3DGM header found - checking for level file format" << std::endl;
+        }
+        
+        // Single pass driven by the chunk size fields
+        chunks.Build(data);
         
-        if (chunks.find("Dot2") != chunks.end()) {
-            totalVertices += ParseDot2Chunk(data, chunks.at("Dot2"), vertices);
+        for (const auto& chunk : chunks.GetEntries()) {
+            logOut << "Found chunk: '" << chunk.GetTag() << "' at position " << chunk.position 
+                      << ", size: " << chunk.size << " bytes"
+                      << (chunk.recovered ? " (recovered)" : "") << std::endl;
         }
         
-        if (chunks.find("FDot") != chunks.end()) {
-            totalVertices += ParseFDotChunk(data, chunks.at("FDot"), vertices);
+        if (chunks.GetRecoveredCount() > 0) {
+            logOut << "⚠ " << chunks.GetRecoveredCount() 
+                      << " chunk(s) with damaged size field, boundaries recovered by tag scan" << std::endl;
         }
-
-        if (chunks.find("Dots") != chunks.end()) {
-            totalVertices += ParseDotsChunk(data, chunks.at("Dots"), vertices);
+        
+        logOut << "Total chunks found: " << chunks.GetChunkCount() << std::endl;
+        return !chunks.IsEmpty();
+    }
+    
+    /**
+     * @param cDotLayouts Layouts MeasureShape probed, one per cDot chunk in file order
+     */
+    int ParseAllVertexChunks(ByteSpan data, const ChunkTable& chunks, const CDotLayoutArray& cDotLayouts,
+                             VertexArray& vertices) {
+        logOut << "\nParsing vertex chunks..." << std::endl;
+        
+        int totalVertices = 0;
+        
+        // Compressed FDot chunks keep their place in the array but decode together, in one batch
+        VertexBatch batch;
+        std::vector<const ChunkTableEntry*> batchChunks;
+        size_t cDotIndex = 0;
+        
+        // Vertex chunks are appended in file order so multi-chunk shapes keep their indexing
+        for (const auto& chunk : chunks.GetEntries()) {
+            int chunkVertices = 0;
+            switch (chunk.GetType()) {
+                case ChunkType::Dot2:
+                    chunkVertices = ParseDot2Chunk(data, chunk, vertices);
+                    break;
+                case ChunkType::FDot:
+                    if (IsCompressedFDot(chunk)) {
+                        logOut << "Parsing FDot chunk at position " << chunk.position << std::endl;
+                        LeaveIntegerDomain(vertices);
+                        if (QueueCompressedFDot(data, chunk, vertices, batch)) {
+                            batchChunks.push_back(&chunk);
+                            continue;
+                        }
+                        break;
+                    }
+                    chunkVertices = ParseFDotChunk(data, chunk, vertices);
+                    break;
+                case ChunkType::Dots:
+                    chunkVertices = ParseDotsChunk(data, chunk, vertices);
+                    break;
+                case ChunkType::cDot:
+                    chunkVertices = ParseCDotChunk(data, chunk, vertices, &cDotLayouts[cDotIndex++]);
+                    break;
+                default:
+                    continue;
+            }
+            logOut << "Chunk '" << chunk.GetTag() << "' at position " << chunk.position 
+                      << ": " << chunkVertices << " vertices" << std::endl;
+            totalVertices += chunkVertices;
         }
         
-        if (chunks.find("cDot") != chunks.end()) {
-            totalVertices += ParseCDotChunk(data, chunks.at("cDot"), vertices);
+        RunVertexBatch(vertices, batch);
+        for (size_t j = 0; j < batchChunks.size(); j++) {
+            logOut << "Chunk '" << batchChunks[j]->GetTag() << "' at position " << batchChunks[j]->position 
+                      << ": " << batch.kept[j] << " vertices" << std::endl;
+            totalVertices += static_cast<int>(batch.kept[j]);
         }
         
-        std::cout << "Total vertices parsed: " << totalVertices << std::endl;
+        logOut << "Total vertices parsed: " << totalVertices << std::endl;
 
         return totalVertices;
     }
     
-    int ParseDot2Chunk(const std::vector<uint8_t>& data, const ChunkInfo& chunk, std::vector<VertexData>& vertices) {
-        std::cout << "Parsing Dot2 chunk at position " << chunk.position << std::endl;
+    int ParseDot2Chunk(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices) {
+        logOut << "Parsing Dot2 chunk at position " << chunk.position << std::endl;
 
         size_t pos = chunk.position + 4;
 
         if (pos + 4 > data.size()) {
-            std::cout << "ERROR: Not enough data for Dot2 size header" << std::endl;
+            logOut << "ERROR: Not enough data for Dot2 size header" << std::endl;
             return 0;
         }
 
-        uint32_t dataSize = (data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3];
+        uint32_t dataSize = ByteSwap::ReadBigEndian32(data.data() + pos);
         pos += 4;
 
-        std::cout << "Dot2 data size: " << dataSize << " bytes" << std::endl;
+        logOut << "Dot2 data size: " << dataSize << " bytes" << std::endl;
 
-        // Korrekte Berechnung wie im Original:
-        // vertexCount = ((chunk.size / 4) - 1) / 3
-        size_t chunkSize = chunk.size;
-        uint32_t vertexCount = 0;
-        if (chunkSize >= 4) {
-            vertexCount = static_cast<uint32_t>(((chunkSize / 4) - 1) / 3);
-        }
-        std::cout << "Calculated vertex count (Dot2-Original): " << vertexCount << std::endl;
+        ChunkRecordLayout layout;
+        GetDot2Layout(data, chunk, layout);
+        uint32_t vertexCount = static_cast<uint32_t>(layout.recordCount);
+        logOut << "Calculated vertex count (Dot2-Original): " << vertexCount << std::endl;
 
-        if (pos + (vertexCount * 12) > data.size()) {
-            std::cout << "ERROR: Not enough data for packed vertices" << std::endl;
+        ValidatedChunk records;
+        if (!ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+            logOut << "ERROR: Not enough data for packed vertices" << std::endl;
             return 0;
         }
 
-        // Dot2 verwendet convertPackedToFloatVertices (nicht _3Component)
-        // Die eigentliche Konvertierung ist hier nur symbolisch, da die Originalfunktion nicht vorliegt.
-        // Wir nehmen die 3 DWORDs pro Vertex und interpretieren sie als float (wie bisher).
-        for (uint32_t i = 0; i < vertexCount; i++) {
-            VertexData vertex = {};
-
-            size_t vertexPos = pos + (i * 12);
-
-            uint32_t packedX = (data[vertexPos + 0] << 24) | (data[vertexPos + 1] << 16) | (data[vertexPos + 2] << 8) | data[vertexPos + 3];
-            uint32_t packedY = (data[vertexPos + 4] << 24) | (data[vertexPos + 5] << 16) | (data[vertexPos + 6] << 8) | data[vertexPos + 7];
-            uint32_t packedZ = (data[vertexPos + 8] << 24) | (data[vertexPos + 9] << 16) | (data[vertexPos + 10] << 8) | data[vertexPos + 11];
+        if (integerDomain) {
+            IntegerGeometry::DecodeDot2(records.GetRecords(), records.GetRecordCount(), integerPositions);
+        } else {
+            DecodeDot2Vertices(records, vertices);
+        }
+        return vertexCount;
+    }
+    
+    /**
+     * Record layout of a Dot2 chunk: big-endian int32 x/y/z after the size field
+     * @return false if the chunk is too short for its size field
+     */
+    static bool GetDot2Layout(ByteSpan data, const ChunkTableEntry& chunk, ChunkRecordLayout& layout) {
+        size_t pos = chunk.position + 4;
+        if (pos + 4 > data.size()) {
+            return false;
+        }
 
-            // Convert packed integers to floats with proper scaling
-            int32_t signedX = static_cast<int32_t>(packedX);
-            int32_t signedY = static_cast<int32_t>(packedY);
-            int32_t signedZ = static_cast<int32_t>(packedZ);
-            
-            vertex.x = static_cast<float>(signedX) / 10.0f;
-            vertex.y = static_cast<float>(signedY) / 10.0f;
-            vertex.z = static_cast<float>(signedZ) / 10.0f;
+        // Korrekte Berechnung wie im Original:
+        // vertexCount = ((chunk.size / 4) - 1) / 3
+        uint32_t vertexCount = 0;
+        if (chunk.size >= 4) {
+            vertexCount = static_cast<uint32_t>(((chunk.size / 4) - 1) / 3);
+        }
+        layout = ChunkRecordLayout(pos + 4, 12, vertexCount);
+        return true;
+    }
+    
+    /**
+     * Decode validated Dot2 records: big-endian int32 x/y/z in tenths
+     * Integer coordinates always convert to finite floats, so no per-vertex
+     * NaN/infinity checks are needed; bounds come from the same pass.
+     */
+    void DecodeDot2Vertices(const ValidatedChunk& records, VertexArray& vertices) {
+        size_t count = records.GetRecordCount();
+        size_t first = vertices.size();
+        vertices.resize(first + count);
+        VertexData* out = vertices.data() + first;
 
-            bool isValid = true;
-            if (std::isnan(vertex.x) || std::isnan(vertex.y) || std::isnan(vertex.z)) {
-                isValid = false;
-                std::cout << "WARNING: Vertex " << i << " has NaN coordinates" << std::endl;
+        // Positions go through the SIMD kernel straight into the vertex array
+        PackedVertexKernel::DecodeStats stats;
+        DecodeInBlocks<VertexDecoding::Dot2>(records.GetRecords(), out, count, &stats, [&](size_t block, size_t blockCount) {
+            for (size_t i = block; i < block + blockCount; i++) {
+                CompleteVertex(out[i], true, 0.001f);
             }
-            if (std::isinf(vertex.x) || std::isinf(vertex.y) || std::isinf(vertex.z)) {
-                isValid = false;
-                std::cout << "WARNING: Vertex " << i << " has infinite coordinates" << std::endl;
-            }
-            if (!isValid) {
-                vertex.x = 0.0f;
-                vertex.y = 0.0f;
-                vertex.z = 0.0f;
-                std::cout << "INFO: Invalid vertex " << i << " replaced with (0,0,0)" << std::endl;
-            }
-
+        });
+        MergeBounds(stats);
+    }
+    
+    /**
+     * Fill in texture coordinates, normal and color from the position
+     * @param projectUV Planar UV from x/y, otherwise (0,0)
+     * @param normalEpsilon Positions closer to the origin get an up normal
+     */
+    static void CompleteVertex(VertexData& vertex, bool projectUV, float normalEpsilon) {
+        if (projectUV) {
             vertex.u = (vertex.x + 25.0f) / 50.0f;
             vertex.v = (vertex.y + 25.0f) / 50.0f;
+        } else {
+            vertex.u = 0.0f;
+            vertex.v = 0.0f;
+        }
 
-            float norm = sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z);
-            if (norm > 0.001f) {
-                vertex.nx = vertex.x / norm;
-                vertex.ny = vertex.y / norm;
-                vertex.nz = vertex.z / norm;
-            } else {
-                vertex.nx = 0.0f;
-                vertex.ny = 1.0f;
-                vertex.nz = 0.0f;
-            }
-
-            vertex.color = 0xFFFFFFFF;
-            vertices.push_back(vertex);
+        float norm = std::sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z);
+        if (norm > normalEpsilon) {
+            vertex.nx = vertex.x / norm;
+            vertex.ny = vertex.y / norm;
+            vertex.nz = vertex.z / norm;
+        } else {
+            vertex.nx = 0.0f;
+            vertex.ny = 1.0f;
+            vertex.nz = 0.0f;
         }
 
-        return vertexCount;
+        vertex.color = 0xFFFFFFFF;
     }
     
-    int ParseFDotChunk(const std::vector<uint8_t>& data, const ChunkInfo& chunk, std::vector<VertexData>& vertices) {
-        std::cout << "Parsing FDot chunk at position " << chunk.position << std::endl;
+    int ParseFDotChunk(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices) {
+        logOut << "Parsing FDot chunk at position " << chunk.position << std::endl;
+        LeaveIntegerDomain(vertices);
+        size_t first = vertices.size();
+        
+        if (IsCompressedFDot(chunk)) {
+            return ParseCompressedFDotChunk(data, chunk, vertices);
+        }
         
         size_t pos = chunk.position + 4; // Skip "FDot" header
         
         if (pos + 4 > data.size()) {
-            std::cout << "ERROR: Not enough data for FDot size header" << std::endl;
+            logOut << "ERROR: Not enough data for FDot size header" << std::endl;
             return 0;
         }
         
         // Read data size (big-endian)
-        uint32_t dataSize = (data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3];
+        uint32_t dataSize = ByteSwap::ReadBigEndian32(data.data() + pos);
         pos += 4;
         
-        std::cout << "FDot data size: " << dataSize << " bytes" << std::endl;
+        logOut << "FDot data size: " << dataSize << " bytes" << std::endl;
         
-        // FDot contains 32-bit float vertices (3 floats per vertex = 12 bytes per vertex)
-        if (dataSize < 4) {
-            std::cout << "ERROR: FDot data too small" << std::endl;
+        ChunkRecordLayout layout;
+        if (!GetFDotLayout(data, chunk, layout)) {
+            logOut << "ERROR: FDot data too small" << std::endl;
             return 0;
         }
+        logOut << "Calculated vertex count: " << layout.recordCount << std::endl;
         
-        // Calculate vertex count (subtract 4 for size header, divide by 12 for xyz floats)
-        uint32_t vertexCount = (dataSize - 4) / 12;
-        std::cout << "Calculated vertex count: " << vertexCount << std::endl;
-        
-        if (pos + (vertexCount * 12) > data.size()) {
-            std::cout << "ERROR: Not enough data for FDot vertices" << std::endl;
+        ValidatedChunk records;
+        if (!ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+            logOut << "ERROR: Not enough data for FDot vertices" << std::endl;
             return 0;
         }
         
-        // Parse vertices as 32-bit floats
-        for (uint32_t i = 0; i < vertexCount; i++) {
-            if (pos + 12 > data.size()) break;
+        // Decode the big-endian float triples block by block, validating and compacting each block
+        size_t count = records.GetRecordCount();
+        vertices.resize(first + count);
+        VertexData* out = vertices.data() + first;
+        
+        PackedVertexKernel::DecodeStats stats;
+        stats.Reset(count);
+        size_t kept = 0;
+        DecodeInBlocks<VertexDecoding::FloatDots>(records.GetRecords(), out, count, nullptr, [&](size_t block, size_t blockCount) {
+            for (size_t i = block; i < block + blockCount; i++) {
+                VertexData vertex = out[i];
             
-            // Read coordinates as big-endian 32-bit floats
-            uint32_t xBits = (data[pos]     << 24) | (data[pos + 1] << 16) | (data[pos + 2]  << 8) | data[pos + 3];
-            uint32_t yBits = (data[pos + 4] << 24) | (data[pos + 5] << 16) | (data[pos + 6]  << 8) | data[pos + 7];
-            uint32_t zBits = (data[pos + 8] << 24) | (data[pos + 9] << 16) | (data[pos + 10] << 8) | data[pos + 11];
+                // Validate coordinates
+                bool isValid = true;
+                if (std::isnan(vertex.x) || std::isnan(vertex.y) || std::isnan(vertex.z)) {
+                    logOut << "WARNING: Invalid coordinates (NaN) at vertex " << i << std::endl;
+                    isValid = false;
+                }
             
-            VertexData vertex = {};
-            vertex.x = *reinterpret_cast<float*>(&xBits);
-            vertex.y = *reinterpret_cast<float*>(&yBits);  
-            vertex.z = *reinterpret_cast<float*>(&zBits);
+                if (std::abs(vertex.x) > 1000000.0f || std::abs(vertex.y) > 1000000.0f || std::abs(vertex.z) > 1000000.0f) {
+                    logOut << "WARNING: Extreme coordinates at vertex " << i << ": (" 
+                              << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
+                    isValid = false;
+                }
             
-            // Validate coordinates
-            bool isValid = true;
-            if (std::isnan(vertex.x) || std::isnan(vertex.y) || std::isnan(vertex.z)) {
-                std::cout << "WARNING: Invalid coordinates (NaN) at vertex " << i << std::endl;
-                isValid = false;
+                if (isValid) {
+                    stats.AddVertex(i, &vertex.x);
+                    CompleteVertex(vertex, false, 0.0001f);
+                    out[kept++] = vertex;
+                
+                    logOut << "Added FDot vertex " << (first + kept) << ": (" 
+                              << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
+                }
+            }
+        });
+        vertices.resize(first + kept);
+        MergeBounds(stats);
+        
+        logOut << "Successfully parsed " << (vertices.size() - first) << " FDot vertices" << std::endl;
+        return static_cast<int>(vertices.size() - first);
+    }
+    
+    /**
+     * Compressed payloads are 24 + 6n bytes; float payloads are 4 + 12n and never match
+     */
+    static bool IsCompressedFDot(const ChunkTableEntry& chunk) {
+        size_t payloadSize = chunk.GetDataSize();
+        return payloadSize >= PackedVertexKernel::COMPRESSION_PARAMS_SIZE &&
+               (payloadSize - PackedVertexKernel::COMPRESSION_PARAMS_SIZE) % PackedVertexKernel::COMPRESSED_VERTEX_SIZE == 0;
+    }
+    
+    /**
+     * Record layout of an FDot chunk, compressed or float
+     * Float records are big-endian x/y/z after a big-endian byte size that
+     * counts itself (4 + 12n); compressed records follow the parameter block.
+     * @return false if the chunk is too short for its size field or the size is below 4
+     */
+    static bool GetFDotLayout(ByteSpan data, const ChunkTableEntry& chunk, ChunkRecordLayout& layout) {
+        if (IsCompressedFDot(chunk)) {
+            size_t vertexCount = (chunk.GetDataSize() - PackedVertexKernel::COMPRESSION_PARAMS_SIZE) / 
+                                 PackedVertexKernel::COMPRESSED_VERTEX_SIZE;
+            layout = ChunkRecordLayout(chunk.GetDataOffset() + PackedVertexKernel::COMPRESSION_PARAMS_SIZE,
+                                       PackedVertexKernel::COMPRESSED_VERTEX_SIZE, vertexCount);
+            return true;
+        }
+        
+        size_t pos = chunk.position + 4;
+        if (pos + 4 > data.size()) {
+            return false;
+        }
+        uint32_t dataSize = ByteSwap::ReadBigEndian32(data.data() + pos);
+        if (dataSize < 4) {
+            return false;
+        }
+        layout = ChunkRecordLayout(pos + 4, 12, (dataSize - 4) / 12);
+        return true;
+    }
+    
+    /**
+     * Decode a compressed FDot chunk (DecrunchDots layout)
+     * A 24-byte parameter block (per-axis scale, then offset) is followed by
+     * little-endian int16 x/y/z triples. A scale large enough to overflow
+     * makes the kernel flag the vertex invalid, and it is dropped.
+     * The payload is little-endian whatever ChunkTable detected for the size
+     * fields: DecrunchDots reads the block in place as native x86 floats and
+     * int16s, the same as cDot records, while float FDot and Dot2 payloads
+     * stay big-endian. A file's size-field order says nothing about either.
+     * Streamed chunks decode as a batch of one; ParseAllVertexChunks batches
+     * every compressed chunk of a shape.
+     */
+    int ParseCompressedFDotChunk(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices) {
+        VertexBatch batch;
+        if (!QueueCompressedFDot(data, chunk, vertices, batch)) {
+            return 0;
+        }
+        RunVertexBatch(vertices, batch);
+        return static_cast<int>(batch.kept[0]);
+    }
+    
+    /**
+     * Compressed FDot chunks of a shape, decoded by one VertexProcessor batch
+     * Each job owns its vertex range plus one spare vertex for the terminator
+     * the batch writes, until RunVertexBatch compacts the array.
+     */
+    struct VertexBatch {
+        std::vector<VertexProcessor::VertexJob> jobs;
+        std::vector<size_t> firsts;     // First vertex of each job's range
+        std::vector<size_t> kept;       // Vertices each job kept, filled by RunVertexBatch
+    };
+    
+    /**
+     * Validate a compressed FDot chunk and reserve its vertex range in the batch
+     * @return false if the chunk has no vertices to decode
+     */
+    bool QueueCompressedFDot(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices, VertexBatch& batch) {
+        size_t paramsOffset = chunk.GetDataOffset();
+        ChunkRecordLayout layout;
+        GetFDotLayout(data, chunk, layout);
+        size_t vertexCount = layout.recordCount;
+        logOut << "Compressed FDot: " << vertexCount << " vertices" << std::endl;
+        
+        ValidatedChunk records;
+        if (!ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+            logOut << "ERROR: Not enough data for FDot vertices" << std::endl;
+            return false;
+        }
+        
+        // Records start after the parameter block, so it is inside the data too
+        PackedVertexKernel::CompressionParams params;
+        if (!PackedVertexKernel::ReadCompressionParams(data.data() + paramsOffset, params)) {
+            logOut << "ERROR: FDot compression parameters are not finite" << std::endl;
+            return false;
+        }
+        
+        if (vertexCount == 0) {
+            return false;
+        }
+        
+        // Output pointers are set by RunVertexBatch, once the array no longer grows
+        VertexProcessor::VertexJob job;
+        job.algorithm = VertexProcessor::Algorithm::DecrunchDots;
+        job.input = data.subspan(paramsOffset, VertexProcessor::CalculateInputSize(job.algorithm, vertexCount));
+        job.outputSize = (vertexCount + 1) * VERTEX_STRIDE;
+        job.vertexCount = vertexCount;
+        job.outputStride = VERTEX_STRIDE;
+        job.gatherStats = true;
+        batch.jobs.push_back(job);
+        batch.firsts.push_back(vertices.size());
+        vertices.resize(vertices.size() + vertexCount + 1);
+        return true;
+    }
+    
+    /**
+     * Decode the queued jobs in L2-sized tiles on decodePool, then compact
+     * the array in file order, dropping terminator slots, non-finite
+     * vertices and the ranges of failed jobs
+     */
+    void RunVertexBatch(VertexArray& vertices, VertexBatch& batch) {
+        batch.kept.assign(batch.jobs.size(), 0);
+        if (batch.jobs.empty()) {
+            return;
+        }
+        
+        for (size_t j = 0; j < batch.jobs.size(); j++) {
+            batch.jobs[j].output = &vertices[batch.firsts[j]].x;
+        }
+        VertexProcessor::ProcessBatch(batch.jobs, decodePool);
+        
+        size_t source = 0;
+        size_t kept = 0;
+        for (size_t j = 0; j < batch.jobs.size(); j++) {
+            const VertexProcessor::VertexJob& job = batch.jobs[j];
+            size_t first = batch.firsts[j];
+            
+            // Vertices of other chunks between the previous job and this one
+            if (kept != source) {
+                std::copy(vertices.begin() + source, vertices.begin() + first, vertices.begin() + kept);
             }
+            kept += first - source;
+            source = first + job.vertexCount + 1;
             
-            if (std::abs(vertex.x) > 1000000.0f || std::abs(vertex.y) > 1000000.0f || std::abs(vertex.z) > 1000000.0f) {
-                std::cout << "WARNING: Extreme coordinates at vertex " << i << ": (" 
-                          << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
-                isValid = false;
+            if (!job.succeeded) {
+                logOut << "ERROR: FDot vertices could not be decoded" << std::endl;
+                continue;
             }
             
-            if (isValid) {
-                // Set default values for other attributes
-                vertex.u = 0.0f;
-                vertex.v = 0.0f;
-                
-                // Calculate normal (default pointing up)
-                float norm = std::sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z);
-                if (norm > 0.0001f) {
-                    vertex.nx = vertex.x / norm;
-                    vertex.ny = vertex.y / norm;
-                    vertex.nz = vertex.z / norm;
-                } else {
-                    vertex.nx = 0.0f;
-                    vertex.ny = 1.0f;
-                    vertex.nz = 0.0f;
+            const PackedVertexKernel::DecodeStats& stats = job.stats;
+            MergeBounds(stats);
+            
+            size_t jobFirst = kept;
+            for (size_t i = 0; i < job.vertexCount; i++) {
+                if (stats.invalidCount > 0 && stats.IsInvalid(i)) {
+                    continue;
                 }
-                
-                vertex.color = 0xFFFFFFFF;
-                vertices.push_back(vertex);
-                
-                std::cout << "Added FDot vertex " << vertices.size() << ": (" 
-                          << vertex.x << ", " << vertex.y << ", " << vertex.z << ")" << std::endl;
+                vertices[kept] = vertices[first + i];
+                CompleteVertex(vertices[kept], false, 0.0001f);
+                kept++;
             }
-            
-            pos += 12;
+            batch.kept[j] = kept - jobFirst;
+            if (batch.kept[j] < job.vertexCount) {
+                logOut << "WARNING: Dropped " << (job.vertexCount - batch.kept[j]) << " non-finite FDot vertices" << std::endl;
+            }
+            logOut << "Successfully parsed " << batch.kept[j] << " FDot vertices" << std::endl;
+        }
+        
+        if (kept != source) {
+            std::copy(vertices.begin() + source, vertices.end(), vertices.begin() + kept);
+        }
+        vertices.resize(kept + (vertices.size() - source));
+    }
+    
+    int ParseDotsChunk(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices) {
+        logOut << "Parsing Dots chunk at position " << chunk.position << std::endl;
+        LeaveIntegerDomain(vertices);
+        
+        ChunkRecordLayout layout;
+        if (!GetDotsLayout(data, chunk, layout)) {
+            logOut << "ERROR: Not enough data for Dots size header" << std::endl;
+            return 0;
         }
+        logOut << "Using 32-bit float format: " << layout.recordCount << " vertices" << std::endl;
         
-        std::cout << "Successfully parsed " << vertices.size() << " FDot vertices" << std::endl;
-        return static_cast<int>(vertices.size());
+        // Too little data for even one vertex leaves nothing to decode
+        size_t first = vertices.size();
+        ValidatedChunk records;
+        if (ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+            DecodeFloatVertices(records, vertices);
+        }
+
+        return static_cast<int>(vertices.size() - first);
     }
     
-    int ParseDotsChunk(const std::vector<uint8_t>& data, const ChunkInfo& chunk, std::vector<VertexData>& vertices) {
-        std::cout << "Parsing Dots chunk at position " << chunk.position << std::endl;
-        
+    /**
+     * Record layout of a Dots chunk: big-endian float x/y/z after the size field
+     * The records are bounded by the chunk's table entry, the same span the
+     * streaming reader delivers, so a following chunk is never read as vertices.
+     * @return false if the chunk is too short for its size field
+     */
+    static bool GetDotsLayout(ByteSpan data, const ChunkTableEntry& chunk, ChunkRecordLayout& layout) {
         size_t pos = chunk.position + 4; // Skip "Dots" header
-        
         if (pos + 4 > data.size()) {
-            std::cout << "ERROR: Not enough data for Dots size header" << std::endl;
-            return 0;
+            return false;
         }
         
-        // Calculate data size
-        size_t nextChunkPos = data.size();
-        size_t dotsDataSize = nextChunkPos - pos - 4;
-        
-        pos += 4; // Skip size header
-        size_t remainingData = dotsDataSize - 4;
-        
-        // Parse as 32-bit floats (3 per vertex = 12 bytes per vertex)
-        uint32_t vertexCount = remainingData / 12;
-        std::cout << "Using 32-bit float format: " << vertexCount << " vertices" << std::endl;
-        
-        for (uint32_t i = 0; i < vertexCount; i++) {
-            if (pos + 12 > data.size()) break;
-            
-            VertexData vertex = {};
-            
-            // Read 3 x 32-bit floats (try big-endian first, like Python parser)
-            uint32_t xData = (data[pos]     << 24) | (data[pos + 1] << 16) | (data[pos + 2]  << 8) | data[pos + 3];
-            uint32_t yData = (data[pos + 4] << 24) | (data[pos + 5] << 16) | (data[pos + 6]  << 8) | data[pos + 7];
-            uint32_t zData = (data[pos + 8] << 24) | (data[pos + 9] << 16) | (data[pos + 10] << 8) | data[pos + 11];
-            pos += 12;
-            
-            vertex.x = *reinterpret_cast<float*>(&xData);
-            vertex.y = *reinterpret_cast<float*>(&yData);
-            vertex.z = *reinterpret_cast<float*>(&zData);
-            
-            // Validate coordinates
-            if (abs(vertex.x) < 10000 && abs(vertex.y) < 10000 && abs(vertex.z) < 10000) {
-                // Generate texture coordinates and normals
-                vertex.u = (vertex.x + 25.0f) / 50.0f;
-                vertex.v = (vertex.y + 25.0f) / 50.0f;
-                
-                float norm = sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z);
-                if (norm > 0.001f) {
-                    vertex.nx = vertex.x / norm;
-                    vertex.ny = vertex.y / norm;
-                    vertex.nz = vertex.z / norm;
-                } else {
-                    vertex.nx = 0.0f;
-                    vertex.ny = 1.0f;
-                    vertex.nz = 0.0f;
+        // Parse as 32-bit floats (3 per vertex = 12 bytes per vertex); the payload is 4 + 12n like float FDot
+        size_t dotsDataSize = chunk.GetDataSize();
+        size_t vertexCount = dotsDataSize >= 4 ? (dotsDataSize - 4) / 12 : 0;
+        layout = ChunkRecordLayout(chunk.GetDataOffset(), 12, vertexCount);
+        return true;
+    }
+    
+    /**
+     * Decode validated Dots records: big-endian float x/y/z
+     * Vertices with a coordinate of 10000 or more are dropped; survivors are
+     * compacted in place so the loop never reallocates, and their bounds are
+     * gathered in the same loop.
+     */
+    void DecodeFloatVertices(const ValidatedChunk& records, VertexArray& vertices) {
+        size_t count = records.GetRecordCount();
+        size_t first = vertices.size();
+        vertices.resize(first + count);
+        VertexData* out = vertices.data() + first;
+
+        // Survivors move down to kept <= i, never into a block that is still to be decoded
+        PackedVertexKernel::DecodeStats stats;
+        stats.Reset(count);
+        size_t kept = 0;
+        DecodeInBlocks<VertexDecoding::FloatDots>(records.GetRecords(), out, count, nullptr, [&](size_t block, size_t blockCount) {
+            for (size_t i = block; i < block + blockCount; i++) {
+                VertexData& vertex = out[kept];
+                if (kept != i) {
+                    vertex.x = out[i].x;
+                    vertex.y = out[i].y;
+                    vertex.z = out[i].z;
+                }
+
+                if (std::abs(vertex.x) < 10000 && std::abs(vertex.y) < 10000 && std::abs(vertex.z) < 10000) {
+                    stats.AddVertex(kept, &vertex.x);
+                    CompleteVertex(vertex, true, 0.001f);
+                    kept++;
                 }
-                
-                vertex.color = 0xFFFFFFFF;
-                vertices.push_back(vertex);
             }
-        }
+        });
 
-        return vertices.size();
+        vertices.resize(first + kept);
+        MergeBounds(stats);
+    }
+    
+    static CDotFormat ProbeCDotFormat(ByteSpan data, const ChunkTableEntry& chunk) {
+        const uint8_t* header = data.data() + chunk.position + 4;
+        uint32_t headerBE = ByteSwap::ReadBigEndian32(header);
+        uint32_t headerLE = ByteSwap::ReadLittleEndian32(header);
+        
+        size_t payloadSize = chunk.GetDataSize();
+        size_t maxCount = payloadSize / 6;
+        
+        CDotFormat format;
+        if (headerBE == payloadSize || headerLE == payloadSize) {
+            format.source = CDotFormat::CountSource::PayloadSize;
+            format.vertexCount = maxCount;
+        } else if (headerBE > 0 && headerBE <= maxCount) {
+            format.source = CDotFormat::CountSource::BigEndianCount;
+            format.vertexCount = headerBE;
+        } else if (headerLE > 0 && headerLE <= maxCount) {
+            format.source = CDotFormat::CountSource::LittleEndianCount;
+            format.vertexCount = headerLE;
+        } else {
+            format.source = CDotFormat::CountSource::PayloadSize;
+            format.vertexCount = maxCount;
+        }
+        return format;
     }
     
-    int ParseCDotChunk(const std::vector<uint8_t>& data, const ChunkInfo& chunk, std::vector<VertexData>& vertices) {
+    /**
+     * Record layout of a cDot chunk: little-endian int16 x/y/z after the header word
+     * @return false if the chunk is too short for its header word
+     */
+    static bool GetCDotLayout(ByteSpan data, const ChunkTableEntry& chunk, CDotLayout& layout) {
         size_t pos = chunk.position + 4; // Skip "cDot" header
-        
-        if (pos + 8 > data.size()) {
-            std::cout << "ERROR: cDot data too small" << std::endl;
+        layout.valid = pos + 8 <= data.size();
+        if (!layout.valid) {
+            return false;
+        }
+        layout.format = ProbeCDotFormat(data, chunk);
+        layout.records = ChunkRecordLayout(chunk.GetDataOffset(), 6, layout.format.vertexCount);
+        return true;
+    }
+    
+    /**
+     * @param measured Layout MeasureShape already probed, nullptr to probe here (streaming)
+     */
+    int ParseCDotChunk(ByteSpan data, const ChunkTableEntry& chunk, VertexArray& vertices,
+                       const CDotLayout* measured = nullptr) {
+        CDotLayout probed;
+        if (!measured) {
+            GetCDotLayout(data, chunk, probed);
+        }
+        const CDotLayout& cDot = measured ? *measured : probed;
+        if (!cDot.valid) {
+            logOut << "ERROR: cDot data too small" << std::endl;
             return 0;
         }
         
-        // Calculate data size
-        size_t nextChunkPos = data.size();
-        size_t cdotDataSize = nextChunkPos - pos;
-        uint32_t countLE = data[pos]         | (data[pos + 1] << 8)  | (data[pos + 2] << 16) | (data[pos + 3] << 24);
-        uint32_t countBE = (data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8)  | data[pos + 3];
+        const ChunkRecordLayout& layout = cDot.records;
+        const CDotFormat& format = cDot.format;
+        logOut << "cDot chunk at position " << chunk.position << ": " << format.vertexCount 
+                  << " vertices (from " << format.GetSourceName() << ")" << std::endl;
         
-        uint32_t vertexCount;
-
-        if (countBE < 100000 && countBE > 0) {
-            vertexCount = countBE;
-        } else if (countLE < 100000 && countLE > 0) {
-            vertexCount = countLE;
-        } else {
-            size_t remainingData = cdotDataSize - 4;
-            vertexCount = remainingData / 6;
+        // Count is bounded by the payload, so one validation covers every vertex
+        ValidatedChunk records;
+        if (!ChunkValidator::ValidateRecords(chunk.header, data, layout, records)) {
+            logOut << "ERROR: cDot vertices extend past end of data" << std::endl;
+            return 0;
         }
         
-        pos += 4;
+        if (integerDomain) {
+            IntegerGeometry::DecodeCDot(records.GetRecords(), records.GetRecordCount(), integerPositions);
+            return static_cast<int>(records.GetRecordCount());
+        }
         
-        for (uint32_t i = 0; i < vertexCount; i++) {
-            if (pos + 6 > chunk.position + 4 + cdotDataSize) break;
-            
-            VertexData vertex = {};
-            
-            int16_t xComp = static_cast<int16_t>(data[pos]     | (data[pos + 1] << 8));
-            int16_t yComp = static_cast<int16_t>(data[pos + 2] | (data[pos + 3] << 8));
-            int16_t zComp = static_cast<int16_t>(data[pos + 4] | (data[pos + 5] << 8));
-            pos += 6;
-            
-            vertex.x = (xComp != -1) ? static_cast<float>(xComp) / 100.0f : 0.0f;
-            vertex.y = (yComp != -1) ? static_cast<float>(yComp) / 100.0f : 0.0f;
-            vertex.z = (zComp != -1) ? static_cast<float>(zComp) / 100.0f : 0.0f;
-            vertex.u = (vertex.x + 25.0f) / 50.0f;
-            vertex.v = (vertex.y + 25.0f) / 50.0f;
-            
-            float norm = sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z);
-
-            if (norm > 0.001f) {
-                vertex.nx = vertex.x / norm;
-                vertex.ny = vertex.y / norm;
-                vertex.nz = vertex.z / norm;
-            } else {
-                vertex.nx = 0.0f;
-                vertex.ny = 1.0f;
-                vertex.nz = 0.0f;
+        size_t count = records.GetRecordCount();
+        size_t first = vertices.size();
+        vertices.resize(first + count);
+        VertexData* out = vertices.data() + first;
+        
+        PackedVertexKernel::DecodeStats stats;
+        DecodeInBlocks<VertexDecoding::CDot>(records.GetRecords(), out, count, &stats, [&](size_t block, size_t blockCount) {
+            for (size_t i = block; i < block + blockCount; i++) {
+                CompleteVertex(out[i], true, 0.001f);
             }
-            
-            vertex.color = 0xFFFFFFFF;
-            vertices.push_back(vertex);
-        }
+        });
+        MergeBounds(stats);
 
-        return vertices.size();
+        return static_cast<int>(count);
     }
     
     // Original Surface System from working Converter_Surface_Test.cpp - RESTORED
-    void ParseLineChunkWithSurfaceSystem(const std::vector<uint8_t>& data, const std::map<std::string, ChunkInfo>& chunks, 
-                                       std::vector<Triangle>& faces, const std::vector<VertexData>& vertices) {
-        auto lineIt = chunks.find("Line");
-        if (lineIt == chunks.end()) return;
-        
-        const ChunkInfo& lineChunk = lineIt->second;
-        size_t pos = lineChunk.position + 8;
-        size_t endPos = pos + lineChunk.size - 8;
-        
-        std::cout << "Parsing Line chunk with original surface system" << std::endl;
+    void ParseLineChunkWithSurfaceSystem(ByteSpan data, const ChunkTable& chunks, 
+                                       TriangleArray& faces, size_t vertexCount) {
+        for (const ChunkTableEntry* lineChunk : chunks.FindAll(ChunkType::Line)) {
+            ParseLineChunk(data, *lineChunk, faces, vertexCount);
+        }
+    }
+    
+    void ParseLineChunk(ByteSpan data, const ChunkTableEntry& lineChunk, 
+                        TriangleArray& faces, size_t vertexCount) {
+        logOut << "Parsing Line chunk with original surface system" << std::endl;
+        
+        // The surface system never reads the final 16-bit word of the payload
+        size_t dataSize = lineChunk.GetDataSize();
+        size_t wordCount = dataSize >= 2 ? (dataSize - 1) / 2 : 0;
+        
+        ValidatedChunk words;
+        if (!ChunkValidator::ValidateRecords(lineChunk.header, data, 
+                                             ChunkRecordLayout(lineChunk.GetDataOffset(), 2, wordCount), words)) {
+            logOut << "ERROR: Line chunk extends past end of data" << std::endl;
+            return;
+        }
         
+        std::pmr::vector<uint16_t> surfaceParams(&arena);
+        surfaceParams.reserve(0xFF);    // A primitive's parameter count is one byte
+        size_t word = 0;
         int debugCount = 0;
-        while (pos < endPos - 2 && debugCount < 5) { // Limit debug output
-            uint16_t chunkType = (data[pos] << 8) | data[pos + 1];
-            pos += 2;
+        while (word < wordCount) {
+            uint16_t chunkType = ByteSwap::ReadBigEndian16(words.GetRecord(word));
+            word++;
             
             if (chunkType == 0x6000) break;
             
             uint8_t chunkSize = chunkType & 0xFF;
             
-            std::vector<uint16_t> surfaceParams;
-            for (int i = 0; i < chunkSize && pos < endPos - 2; i++) {
-                uint16_t param = (data[pos] << 8) | data[pos + 1];
-                pos += 2;
+            // Bound the parameter run once per primitive instead of per parameter
+            size_t paramCount = std::min(static_cast<size_t>(chunkSize), wordCount - word);
+            const uint8_t* params = words.GetRecord(word);
+            
+            surfaceParams.clear();
+            for (size_t i = 0; i < paramCount; i++) {
+                uint16_t param = ByteSwap::ReadBigEndian16(params + i * 2);
+                word++;
                 if (param == 0x7000) break;
                 surfaceParams.push_back(param);
             }
             
             // Debug output to understand the parameters
             if (debugCount < 3) {
-                std::cout << "ChunkType: 0x" << std::hex << chunkType << std::dec 
+                logOut << "ChunkType: 0x" << std::hex << chunkType << std::dec 
                          << ", Size: " << static_cast<int>(chunkSize) 
                          << ", Params: ";
                 for (size_t i = 0; i < surfaceParams.size() && i < 6; ++i) {
-                    std::cout << surfaceParams[i] << " ";
+                    logOut << surfaceParams[i] << " ";
                 }
-                std::cout << std::endl;
-            }
-            
-            // NEW: Process as primitive geometry data instead of surface parameters
-            ProcessPrimitiveGeometry(surfaceParams, chunkType, faces, vertices.size());
-            debugCount++;
-        }
-        
-        // Continue without debug output
-        while (pos < endPos - 2) {
-            uint16_t chunkType = (data[pos] << 8) | data[pos + 1];
-            pos += 2;
-            
-            if (chunkType == 0x6000) break;
-            
-            uint8_t chunkSize = chunkType & 0xFF;
-            
-            std::vector<uint16_t> surfaceParams;
-            for (int i = 0; i < chunkSize && pos < endPos - 2; i++) {
-                uint16_t param = (data[pos] << 8) | data[pos + 1];
-                pos += 2;
-                if (param == 0x7000) break;
-                surfaceParams.push_back(param);
+                logOut << std::endl;
+                debugCount++;
             }
             
             // NEW: Process as primitive geometry data instead of surface parameters
-            ProcessPrimitiveGeometry(surfaceParams, chunkType, faces, vertices.size());
+            ProcessPrimitiveGeometry(surfaceParams, chunkType, faces, vertexCount);
         }
         
-        std::cout << "Generated " << faces.size() << " faces from Line chunk (corrected primitive system)" << std::endl;
+        logOut << "Generated " << faces.size() << " faces from Line chunk (corrected primitive system)" << std::endl;
     }
     
-    void ProcessPrimitiveGeometry(const std::vector<uint16_t>& geometryData, uint16_t primitiveType, 
-                                 std::vector<Triangle>& faces, size_t vertexCount) {
+    void ProcessPrimitiveGeometry(const std::pmr::vector<uint16_t>& geometryData, uint16_t primitiveType, 
+                                 TriangleArray& faces, size_t vertexCount) {
         if (geometryData.empty() || vertexCount == 0) return;
         
-        std::cout << "Processing primitive type 0x" << std::hex << primitiveType << std::dec 
+        logOut << "Processing primitive type 0x" << std::hex << primitiveType << std::dec 
                  << " with " << geometryData.size() << " geometry elements" << std::endl;
         
         // Handle different primitive types based on RFC specification
@@ -685,17 +1492,17 @@ private:
                 
             default:
                 // Fallback: treat as indexed triangle/quad data
-                ProcessIndexedPrimitive(geometryData, faces, vertexCount);
+                ProcessIndexedPrimitive(geometryData, 0, faces, vertexCount);
                 break;
         }
     }
     
-    void ProcessQuadPrimitive(const std::vector<uint16_t>& indices, std::vector<Triangle>& faces, size_t vertexCount) {
-        std::cout << "  Processing as Quad primitive with indices: ";
+    void ProcessQuadPrimitive(const std::pmr::vector<uint16_t>& indices, TriangleArray& faces, size_t vertexCount) {
+        logOut << "  Processing as Quad primitive with indices: ";
         for (size_t i = 0; i < std::min((size_t)6, indices.size()); i++) {
-            std::cout << indices[i] << " ";
+            logOut << indices[i] << " ";
         }
-        std::cout << std::endl;
+        logOut << std::endl;
         
         if (indices.size() >= 4) {
             // Take first 4 elements as vertex indices for a quad
@@ -706,10 +1513,10 @@ private:
             
             // Create quad as two triangles with consistent winding
             if (v0 != v1 && v1 != v2 && v2 != v3 && v0 != v3) {
-                faces.push_back(Triangle(v0, v2, v1)); // First triangle
-                faces.push_back(Triangle(v0, v3, v2)); // Second triangle
+                AddUniqueFace(faces, v0, v2, v1); // First triangle
+                AddUniqueFace(faces, v0, v3, v2); // Second triangle
                 
-                std::cout << "    Created quad: (" << v0 << "," << v1 << "," << v2 << "," << v3 << ") -> "
+                logOut << "    Created quad: (" << v0 << "," << v1 << "," << v2 << "," << v3 << ") -> "
                          << "Triangle(" << v0 << "," << v2 << "," << v1 << ") + "
                          << "Triangle(" << v0 << "," << v3 << "," << v2 << ")" << std::endl;
             }
@@ -717,36 +1524,39 @@ private:
         
         // Handle additional geometry data if present
         if (indices.size() > 4) {
-            ProcessIndexedPrimitive(std::vector<uint16_t>(indices.begin() + 4, indices.end()), faces, vertexCount);
+            ProcessIndexedPrimitive(indices, 4, faces, vertexCount);
         }
     }
     
-    void ProcessSimpleElement(const std::vector<uint16_t>& elements, std::vector<Triangle>& faces, size_t vertexCount) {
-        std::cout << "  Processing simple element with " << elements.size() << " parameters" << std::endl;
+    void ProcessSimpleElement(const std::pmr::vector<uint16_t>& elements, TriangleArray& faces, size_t vertexCount) {
+        logOut << "  Processing simple element with " << elements.size() << " parameters" << std::endl;
         
         // Simple elements might be material/texture parameters, not geometry
         // For now, just log them without creating faces
         for (size_t i = 0; i < elements.size(); i++) {
-            std::cout << "    Element[" << i << "] = " << elements[i] << std::endl;
+            logOut << "    Element[" << i << "] = " << elements[i] << std::endl;
         }
     }
     
-    void ProcessIndexedPrimitive(const std::vector<uint16_t>& indices, std::vector<Triangle>& faces, size_t vertexCount) {
-        std::cout << "  Processing indexed primitive with " << indices.size() << " indices" << std::endl;
+    /**
+     * @param first Index of the first element to read (a quad's tail follows its four corners)
+     */
+    void ProcessIndexedPrimitive(const std::pmr::vector<uint16_t>& indices, size_t first, TriangleArray& faces, size_t vertexCount) {
+        logOut << "  Processing indexed primitive with " << indices.size() - first << " indices" << std::endl;
         
         // Create triangles from index data
-        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (size_t i = first; i + 2 < indices.size(); i += 3) {
             uint16_t v0 = indices[i] % vertexCount;
             uint16_t v1 = indices[i + 1] % vertexCount;
             uint16_t v2 = indices[i + 2] % vertexCount;
             
             if (v0 != v1 && v1 != v2 && v0 != v2) {
-                faces.push_back(Triangle(v0, v2, v1)); // Consistent winding
+                AddUniqueFace(faces, v0, v2, v1); // Consistent winding
             }
         }
     }
     
-    void CreateBoxFaces(std::vector<Triangle>& faces, size_t vertexCount) {
+    void CreateBoxFaces(TriangleArray& faces, size_t vertexCount) {
         if (vertexCount != 16) return;
         
         // Create a proper closed box with correct winding order (counter-clockwise for outward normals)
@@ -783,7 +1593,7 @@ private:
         faces.push_back(Triangle(9, 10, 11));   // Back bottom edge
     }
     
-    void CreateConvexHullFaces(std::vector<Triangle>& faces, size_t vertexCount) {
+    void CreateConvexHullFaces(TriangleArray& faces, size_t vertexCount) {
         // Create a simple convex hull approximation
         size_t half = vertexCount / 2;
         
@@ -802,8 +1612,8 @@ private:
         faces.push_back(Triangle(static_cast<int>(half - 1), static_cast<int>(half), static_cast<int>(vertexCount - 1)));
     }
     
-    void CreateSurfacesFromParameters(const std::vector<uint16_t>& surfaceParams, uint16_t chunkType,
-                                    std::vector<Triangle>& faces, const std::vector<VertexData>& vertices) {
+    void CreateSurfacesFromParameters(const std::pmr::vector<uint16_t>& surfaceParams, uint16_t chunkType,
+                                    TriangleArray& faces, const VertexArray& vertices) {
         if (surfaceParams.size() < 3) return;
         
         for (size_t i = 0; i + 2 < surfaceParams.size(); i += 3) {
@@ -824,7 +1634,7 @@ private:
     }
     
     void CreateSurfaceFromParameters(uint16_t param1, uint16_t param2, uint16_t param3, uint16_t chunkType,
-                                   std::vector<Triangle>& faces, const std::vector<VertexData>& vertices) {
+                                   TriangleArray& faces, const VertexArray& vertices) {
         if (vertices.size() < 3) return;
         
         size_t localVertexCount = vertices.size();
@@ -838,7 +1648,7 @@ private:
         CreateFacesFromSmallParams(param1, param2, param3, localVertexCount, faces);
     }
     
-    void CreateFacesFromSmallParams(uint16_t p1, uint16_t p2, uint16_t p3, size_t localVertexCount, std::vector<Triangle>& faces) {
+    void CreateFacesFromSmallParams(uint16_t p1, uint16_t p2, uint16_t p3, size_t localVertexCount, TriangleArray& faces) {
         if (localVertexCount == 0) return;
         
         for (int i = 0; i < 6; i++) {
@@ -857,7 +1667,7 @@ private:
         }
     }
     
-    void CreateFacesFromLargeParams(uint16_t p1, uint16_t p2, uint16_t p3, size_t localVertexCount, std::vector<Triangle>& faces) {
+    void CreateFacesFromLargeParams(uint16_t p1, uint16_t p2, uint16_t p3, size_t localVertexCount, TriangleArray& faces) {
         if (localVertexCount == 0) return;
         
         uint16_t v1_base = p1 & 0xFF;
@@ -880,8 +1690,17 @@ private:
         }
     }
     
-    int ParsePrimChunk(const std::vector<uint8_t>& data, const std::map<std::string, ChunkInfo>& chunks, std::vector<Triangle>& faces, size_t vertexCount) {
-        if (chunks.find("Prim") == chunks.end()) {
+    /**
+     * Append a triangle unless the shape already has it (Prim and Line primitives)
+     */
+    void AddUniqueFace(TriangleArray& faces, int v0, int v1, int v2) {
+        if (faceSet.Insert(static_cast<uint32_t>(v0), static_cast<uint32_t>(v1), static_cast<uint32_t>(v2))) {
+            faces.push_back(Triangle(v0, v1, v2));
+        }
+    }
+    
+    int ParsePrimChunk(ByteSpan data, const ChunkTable& chunks, TriangleArray& faces, size_t vertexCount) {
+        if (!chunks.Contains(ChunkType::Prim)) {
             for (size_t i = 0; i + 2 < vertexCount; i += 3) {
                 faces.push_back(Triangle(static_cast<int>(i), static_cast<int>(i + 1), static_cast<int>(i + 2)));
             }
@@ -889,66 +1708,56 @@ private:
             return faces.size();
         }
         
-        const ChunkInfo& primChunk = chunks.at("Prim");
-        size_t pos = primChunk.position + 4;
-        
-        if (pos + 4 > data.size()) {
-            std::cout << "ERROR: Not enough data for Prim size header" << std::endl;
-            return 0;
+        for (const ChunkTableEntry* primChunk : chunks.FindAll(ChunkType::Prim)) {
+            ParsePrimEntry(data, *primChunk, faces, vertexCount);
         }
         
-        uint32_t primSize = (data[pos] << 24) | (data[pos + 1] << 16) | (data[pos + 2] << 8) | data[pos + 3];
-        pos += 4;
+        return faces.size();
+    }
+    
+    int ParsePrimEntry(ByteSpan data, const ChunkTableEntry& primChunk, TriangleArray& faces, size_t vertexCount) {
+        // Payload size comes from the table, so a damaged size field cannot run past the file
+        size_t pos = primChunk.GetDataOffset();
+        size_t primSize = primChunk.GetDataSize();
 
         // HEX ANALYSIS FINDINGS:
         // Pattern: 0x470E → [data] → END_OF_PRIMITIVE (-1) → [4 vertex indices before -1]
         const int32_t END_OF_PRIMITIVE = -1;      // 0xFFFFFFFF
         const int32_t PRIMITIVE_0x470E = 18190;   // 0x470E
-        std::set<std::string> uniqueFaces; // Avoid duplicates
         int primitiveCount = 0;
         
         for (size_t offset = 0; offset + 4 <= primSize; offset += 4) {
-            int32_t value = (data[pos + offset] << 24) | (data[pos + offset + 1] << 16) | (data[pos + offset + 2] << 8) | data[pos + offset + 3];
+            int32_t value = VertexDecoding::ReadComponent<PackedVertexKernel::ByteOrder::BigEndian, int32_t>(data.data() + pos + offset);
             
             if (value == END_OF_PRIMITIVE) {
                 if (offset >= 16) {
-                    std::vector<int32_t> vertices;
+                    // At most four indices, kept on the stack instead of a vector per primitive
+                    int32_t vertices[4];
+                    size_t found = 0;
                     
-                    std::cout << "  Looking backwards for vertex indices:" << std::endl;
+                    logOut << "  Looking backwards for vertex indices:" << std::endl;
                     for (int back = 16; back >= 4; back -= 4) {
                         size_t vertexOffset = offset - back;
-                        int32_t vertexIndex = (data[pos + vertexOffset] << 24) | 
-                                             (data[pos + vertexOffset + 1] << 16) | 
-                                             (data[pos + vertexOffset + 2] << 8) | 
-                                             data[pos + vertexOffset + 3];
+                        int32_t vertexIndex = VertexDecoding::ReadComponent<PackedVertexKernel::ByteOrder::BigEndian, int32_t>(
+                            data.data() + pos + vertexOffset);
                         
                         if(vertexIndex >= 0 && vertexIndex < static_cast<int32_t>(vertexCount)) {
-                            vertices.push_back(vertexIndex);
+                            vertices[found++] = vertexIndex;
                         }
                     }
                     
-                    if (vertices.size() == 4) {
+                    if (found == 4) {
                         int v0 = vertices[0], v1 = vertices[1], v2 = vertices[2], v3 = vertices[3];
                         
                         if (v0 == v3) {
-                            faces.push_back(Triangle(v0, v1, v2));
-                            std::cout << "    Triangle: " << v0 << " " << v1 << " " << v2 << std::endl;
+                            AddUniqueFace(faces, v0, v1, v2);
+                            logOut << "    Triangle: " << v0 << " " << v1 << " " << v2 << std::endl;
                         } else {
                             bool isValidQuad = (v0 != v1 && v0 != v2 && v0 != v3 && v1 != v2 && v1 != v3 && v2 != v3);
                             
                             if (isValidQuad) {
-                                std::string face1Str = std::to_string(v0) + "/" + std::to_string(v1) + "/" + std::to_string(v2);
-                                std::string face2Str = std::to_string(v0) + "/" + std::to_string(v2) + "/" + std::to_string(v3);
-                                
-                                if (uniqueFaces.find(face1Str) == uniqueFaces.end()) {
-                                    faces.push_back(Triangle(v0, v1, v2));
-                                    uniqueFaces.insert(face1Str);
-                                }
-                                
-                                if (uniqueFaces.find(face2Str) == uniqueFaces.end()) {
-                                    faces.push_back(Triangle(v0, v2, v3));
-                                    uniqueFaces.insert(face2Str);
-                                }
+                                AddUniqueFace(faces, v0, v1, v2);
+                                AddUniqueFace(faces, v0, v2, v3);
                             }
                         }
                         
@@ -962,6 +1771,405 @@ private:
     }
 };
 
+// Batch conversion
+struct BatchOptions {
+    std::string inputSpec;      // Directory, wildcard pattern or @listfile
+    std::string outputDir;      // Empty = current directory
+    unsigned threadCount = 0;   // 0 = one per hardware thread
+    bool verbose = false;
+    bool streaming = false;
+    size_t windowSize = StreamingChunkReader::DEFAULT_WINDOW_SIZE;
+    bool useIoUring = true;     // false = load files with worker threads
+    bool mapInput = false;      // Map each file on its worker instead of loading it ahead
+    MappedFile::Options inputOptions;
+    bool weld = false;          // Weld Dot2/cDot vertices with identical positions
+    bool ignoreWinding = false; // Faces with the same indices in any order are duplicates
+    size_t memoryLimit = 0;     // Bytes, 0 = unlimited
+};
+
+struct BatchJob {
+    std::string inputFile;
+    std::string outputFile;
+    uintmax_t fileSize = 0;
+};
+
+struct BatchResult {
+    bool success = false;
+    size_t vertexCount = 0;
+    size_t faceCount = 0;
+    double milliseconds = 0.0;
+    std::string error;
+};
+
+// Memory budget
+const size_t WINDOW_BUDGET_SHARE = 4;       // A streaming window takes at most 1/N of the budget
+
+/**
+ * Shrink the streaming window to its share of the budget
+ * The window bounds the largest decodable chunk: a larger chunk fails the
+ * conversion with a report instead of growing past the budget.
+ */
+size_t FitWindowToBudget(size_t windowSize, size_t memoryLimit) {
+    if (memoryLimit == 0) {
+        return windowSize;
+    }
+    return std::min(windowSize, memoryLimit / WINDOW_BUDGET_SHARE);
+}
+
+/**
+ * Reservation against the memory budget, returned when it goes out of scope
+ */
+class BudgetReservation {
+public:
+    BudgetReservation(MemoryBudget& budget, size_t bytes) : budget_(budget), bytes_(bytes) {
+        budget_.Acquire(bytes_);
+    }
+    ~BudgetReservation() { budget_.Release(bytes_); }
+    
+    BudgetReservation(const BudgetReservation&) = delete;
+    BudgetReservation& operator=(const BudgetReservation&) = delete;
+    
+private:
+    MemoryBudget& budget_;
+    size_t bytes_;
+};
+
+/**
+ * Expected peak of streaming one file, its contents excluded
+ * A stream builds no chunk table, so the file is mapped to build one here;
+ * pages are only faulted in where the table walk reads them. The window
+ * holds the largest chunk on top of the decoded shape.
+ */
+size_t EstimateStreamMemory(const BatchJob& job, const BatchOptions& options) {
+    MappedFile mapped;
+    if (!mapped.Open(job.inputFile)) {
+        return ParseArena::DEFAULT_BLOCK_SIZE;      // The conversion cannot open it either
+    }
+    size_t largestChunk = 0;
+    size_t estimate = Converter::EstimateMemory(mapped.GetSpan(), options.weld, &largestChunk);
+    return estimate + std::min(largestChunk, options.windowSize);
+}
+
+/**
+ * Measure, reserve, then convert: the chunk table is walked once, for both
+ */
+bool ConvertMeasured(Converter& converter, ByteSpan data, const std::string& shapeName, MemoryBudget& budget) {
+    if (!budget.IsLimited() || !converter.MeasureFrom3GM(data)) {
+        return converter.ConvertFrom3GM(data, shapeName);
+    }
+    BudgetReservation reservation(budget, converter.GetMemoryEstimate());
+    return converter.ConvertFrom3GM(data, shapeName);
+}
+
+/**
+ * Convert one batch file
+ * @param input File contents from the loader, nullptr to stream or map the file from disk
+ * @param context Parse buffers of the calling worker, reused from file to file
+ * @param budget Admits the conversion once its expected memory fits
+ */
+BatchResult ConvertBatchFile(const BatchJob& job, const BatchOptions& options, const LoadedFile* input,
+                             ParseContext* context, MemoryBudget& budget, std::ostream& log, std::ostream& errors) {
+    BatchResult result;
+    auto start = std::chrono::steady_clock::now();
+    
+    try {
+        std::string shapeName = std::filesystem::path(job.inputFile).stem().string();
+        
+        if (!input && options.streaming) {
+            FileDescriptorSource source;
+            if (!source.Open(job.inputFile)) {
+                errors << "Cannot read input file" << std::endl;
+            } else {
+                BudgetReservation reservation(budget, budget.IsLimited() ? EstimateStreamMemory(job, options) : 0);
+                Converter converter(job.outputFile, log, errors, context);
+                converter.SetWeldVertices(options.weld);
+                converter.SetIgnoreWinding(options.ignoreWinding);
+                result.success = converter.ConvertFromStream(source, shapeName, options.windowSize);
+                result.vertexCount = converter.GetVertexCount();
+                result.faceCount = converter.GetFaceCount();
+            }
+        } else if (!input) {
+            MappedFile mapped;
+            if (!mapped.Open(job.inputFile, options.inputOptions)) {
+                errors << "Cannot read input file" << std::endl;
+            } else {
+                Converter converter(job.outputFile, log, errors, context);
+                converter.SetWeldVertices(options.weld);
+                converter.SetIgnoreWinding(options.ignoreWinding);
+                result.success = ConvertMeasured(converter, mapped.GetSpan(), shapeName, budget);
+                result.vertexCount = converter.GetVertexCount();
+                result.faceCount = converter.GetFaceCount();
+            }
+        } else {
+            if (!input->success) {
+                errors << "Cannot read input file: " << input->error << std::endl;
+            } else {
+                Converter converter(job.outputFile, log, errors, context);
+                converter.SetWeldVertices(options.weld);
+                converter.SetIgnoreWinding(options.ignoreWinding);
+                result.success = ConvertMeasured(converter, input->GetSpan(), shapeName, budget);
+                result.vertexCount = converter.GetVertexCount();
+                result.faceCount = converter.GetFaceCount();
+            }
+        }
+    } catch (const std::exception& e) {
+        errors << "Exception: " << e.what() << std::endl;
+        result.success = false;
+    }
+    
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * Print tracked memory per subsystem, and whether the budget held
+ */
+void PrintMemoryUsage(size_t memoryLimit) {
+    std::cout << "\n🧮 Memory:" << std::endl;
+    MemoryTracker::Print(std::cout);
+    
+    size_t peak = MemoryTracker::GetTotal().peakBytes;
+    if (memoryLimit > 0 && peak > memoryLimit) {
+        std::cout << "  ⚠️ Peak of " << (peak + 1023) / 1024 << " KB exceeded the "
+                  << memoryLimit / 1024 << " KB budget" << std::endl;
+    }
+}
+
+/**
+ * Convert many files in one process
+ * Files are scheduled largest-first on a work-stealing pool so the big LODs
+ * start early and the small ones fill in the tail.
+ * @return Process exit code, 1 if any file failed
+ */
+int RunBatch(const BatchOptions& options) {
+    std::vector<BatchFile> files;
+    if (!BatchFileList::Collect(options.inputSpec, files)) {
+        std::cout << "❌ Cannot expand batch input: " << options.inputSpec << " (run with -d for details)" << std::endl;
+        return 1;
+    }
+    if (files.empty()) {
+        std::cout << "❌ No input files matched: " << options.inputSpec << std::endl;
+        return 1;
+    }
+    
+    if (!options.outputDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(options.outputDir, ec);
+        if (ec) {
+            std::cout << "❌ Cannot create output directory: " << options.outputDir << std::endl;
+            return 1;
+        }
+    }
+    
+    // Files arrive largest first, which is also the submission order below
+    std::vector<BatchJob> jobs;
+    std::map<std::string, std::string> outputOwners;
+    for (const auto& file : files) {
+        BatchJob job;
+        job.inputFile = file.path;
+        job.fileSize = file.size;
+        job.outputFile = (std::filesystem::path(options.outputDir) / std::filesystem::path(file.path).stem()).string();
+        
+        auto owner = outputOwners.emplace(job.outputFile, file.path);
+        if (!owner.second) {
+            std::cout << "❌ " << file.path << " and " << owner.first->second 
+                      << " would both write " << job.outputFile << ".obj" << std::endl;
+            return 1;
+        }
+        jobs.push_back(job);
+    }
+    
+    unsigned threadCount = options.threadCount > 0 ? options.threadCount : ThreadPool::GetDefaultThreadCount();
+    if (threadCount > jobs.size()) {
+        threadCount = static_cast<unsigned>(jobs.size());
+    }
+    
+    // Under a budget, fewer files are read ahead and each conversion
+    // waits until its expected memory fits
+    MemoryBudget budget(options.memoryLimit);
+    
+    // Streamed and mapped files are opened by the worker that converts them
+    bool loadAhead = !options.streaming && !options.mapInput;
+    
+    unsigned queueDepth = AsyncFileLoader::DEFAULT_QUEUE_DEPTH;
+    if (budget.IsLimited() && loadAhead) {
+        // Files arrive largest first; read ahead at most a quarter of the budget
+        size_t largest = std::max<size_t>(static_cast<size_t>(jobs.front().fileSize), 1);
+        size_t fitting = options.memoryLimit / 4 / largest;
+        queueDepth = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(queueDepth, fitting)));
+    }
+    
+    AsyncFileLoader loader(queueDepth);
+    if (!options.useIoUring) {
+        loader.SetBackend(AsyncFileLoader::Backend::ThreadPool);
+    }
+    
+    std::cout << "📦 Batch: " << jobs.size() << " file(s) on " << threadCount << " thread(s), "
+              << (options.streaming ? "streaming" : options.mapInput ? "mapped" : AsyncFileLoader::GetBackendName(loader.GetBackend())) 
+              << " input" << std::endl;
+    if (budget.IsLimited()) {
+        std::cout << "🧮 Memory budget: " << options.memoryLimit / 1024 << " KB";
+        if (loadAhead) {
+            std::cout << ", read-ahead " << queueDepth << " file(s)";
+        }
+        std::cout << std::endl;
+    }
+    
+    std::mutex outputMutex;
+    size_t completed = 0;
+    std::vector<BatchResult> results(jobs.size());
+    size_t stolen = 0;
+    auto batchStart = std::chrono::steady_clock::now();
+    
+    // One set of parse buffers per worker, grown to the largest file it has converted
+    std::vector<std::unique_ptr<ParseContext>> contexts(threadCount);
+    ParseContext::TrimPolicy trimPolicy;
+    if (budget.IsLimited()) {
+        // Idle workers must not pin more than their share of the budget
+        trimPolicy.maxRetainedBytes = std::min(trimPolicy.maxRetainedBytes, options.memoryLimit / threadCount / 2);
+    }
+    for (auto& context : contexts) {
+        context = std::make_unique<ParseContext>(trimPolicy);
+    }
+    
+    // What each worker's context kept after its last file; the budget leaves it out
+    std::vector<size_t> retainedBytes(threadCount, 0);
+    
+    auto runJob = [&](size_t i, const LoadedFile* input, ParseContext* context, size_t worker) {
+        // Per-file buffers keep the output of concurrent conversions apart
+        std::ostringstream log;
+        std::ostringstream errors;
+        std::ostream discard(nullptr);
+        
+        results[i] = ConvertBatchFile(jobs[i], options, input, context, budget,
+                                      options.verbose ? static_cast<std::ostream&>(log) : discard, errors);
+        
+        // Under a budget, trim now instead of at the worker's next file, which may never come
+        if (budget.IsLimited() && context && context->GetRetainedBytes() > trimPolicy.maxRetainedBytes) {
+            context->Trim();
+        }
+        if (context) {
+            size_t retained = context->GetRetainedBytes();
+            budget.UpdateRetained(retainedBytes[worker], retained);
+            retainedBytes[worker] = retained;
+        }
+        
+        std::string errorText = errors.str();
+        if (!errorText.empty()) {
+            results[i].error = errorText.substr(0, errorText.find('\n'));
+        }
+        
+        std::lock_guard<std::mutex> lock(outputMutex);
+        completed++;
+        if (options.verbose) {
+            std::cout << "\n--- " << jobs[i].inputFile << " ---" << log.str() << errorText;
+        }
+        std::cout << "[" << completed << "/" << jobs.size() << "] "
+                  << (results[i].success ? "✓ " : "❌ ") << jobs[i].inputFile << std::endl;
+    };
+    
+    {
+        // Reads run ahead of conversion; cap the loaded buffers waiting for a worker.
+        // Declared before the pool so they outlive the tasks that signal them.
+        const size_t maxQueued = static_cast<size_t>(threadCount) * 2;
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        size_t queued = 0;
+        
+        ThreadPool pool(threadCount);
+        std::vector<std::future<void>> pending;
+        pending.reserve(jobs.size());
+        
+        auto runOnWorker = [&](size_t i, const LoadedFile* input) {
+            size_t worker;
+            bool onWorker = pool.GetCurrentWorker(worker);
+            runJob(i, input, onWorker ? contexts[worker].get() : nullptr, onWorker ? worker : 0);
+        };
+        
+        if (!loadAhead) {
+            for (size_t i = 0; i < jobs.size(); i++) {
+                pending.push_back(pool.Submit([&, i]() { runOnWorker(i, nullptr); }));
+            }
+        } else {
+            std::vector<std::string> paths;
+            for (const auto& job : jobs) {
+                paths.push_back(job.inputFile);
+            }
+            
+            loader.LoadAll(paths, [&](LoadedFile& file) {
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCondition.wait(lock, [&]() { return queued < maxQueued; });
+                    queued++;
+                }
+                
+                auto input = std::make_shared<LoadedFile>(std::move(file));
+                size_t i = input->index;
+                pending.push_back(pool.Submit([&, i, input]() mutable {
+                    runOnWorker(i, input.get());
+                    input.reset();
+                    
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    queued--;
+                    queueCondition.notify_one();
+                }));
+            });
+        }
+        
+        for (auto& task : pending) {
+            task.get();
+        }
+        stolen = pool.GetStolenCount();
+    }
+    
+    double wallTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStart).count();
+    
+    std::cout << "\n📊 Batch summary:" << std::endl;
+    std::cout << "  " << std::left << std::setw(6) << "Status" 
+              << std::right << std::setw(12) << "Bytes" 
+              << std::setw(10) << "Vertices" 
+              << std::setw(10) << "Faces" 
+              << std::setw(10) << "ms" << "  File" << std::endl;
+    
+    size_t failed = 0;
+    double busyTime = 0.0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const BatchResult& result = results[i];
+        busyTime += result.milliseconds;
+        if (!result.success) failed++;
+        
+        std::cout << "  " << std::left << std::setw(6) << (result.success ? "ok" : "FAIL")
+                  << std::right << std::setw(12) << jobs[i].fileSize
+                  << std::setw(10) << result.vertexCount
+                  << std::setw(10) << result.faceCount
+                  << std::setw(10) << std::fixed << std::setprecision(1) << result.milliseconds
+                  << "  " << jobs[i].inputFile;
+        if (!result.success && !result.error.empty()) {
+            std::cout << " (" << result.error << ")";
+        }
+        std::cout << std::endl;
+    }
+    
+    std::cout << "\n  " << (jobs.size() - failed) << " converted, " << failed << " failed in "
+              << std::fixed << std::setprecision(1) << wallTime << " ms ("
+              << busyTime << " ms of conversion work, " << stolen << " task(s) stolen)" << std::endl;
+    if (loadAhead) {
+        std::cout << "  Loaded " << loader.GetBytesLoaded() << " bytes";
+        if (loader.GetSubmitCalls() > 0) {
+            std::cout << " in " << loader.GetSubmitCalls() << " io_uring submission(s)";
+        }
+        std::cout << std::endl;
+    }
+    if (budget.IsLimited()) {
+        std::cout << "  " << budget.GetThrottleCount() << " conversion(s) waited for memory" << std::endl;
+    }
+    if (options.verbose || budget.IsLimited()) {
+        PrintMemoryUsage(options.memoryLimit);
+    }
+    
+    return failed == 0 ? 0 : 1;
+}
+
 // Main function
 int main(int argc, char* argv[]) {
     std::cout << "🎮 3D Game Machine - 3GM to OBJ Converter v1.0" << std::endl;
@@ -974,6 +2182,16 @@ int main(int argc, char* argv[]) {
     bool showHelp = false;
     bool showVersion = false;
     std::string format = "obj";
+    MappedFile::Options inputOptions;
+    bool mapInput = false;
+    bool streaming = false;
+    size_t windowSize = StreamingChunkReader::DEFAULT_WINDOW_SIZE;
+    std::string batchSpec = "";
+    unsigned threadCount = 0;
+    bool useIoUring = true;
+    bool weld = false;
+    bool ignoreWinding = false;
+    size_t memoryLimit = 0;
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -994,7 +2212,63 @@ int main(int argc, char* argv[]) {
         else if ((arg == "-f" || arg == "--format") && i + 1 < argc) {
             format = argv[++i];
         }
-        else if (arg[0] != '-' && inputFile.empty()) {
+        else if (arg == "--populate") {
+            inputOptions.populate = true;
+        }
+        else if (arg == "--no-mmap") {
+            inputOptions.forceRead = true;
+        }
+        else if (arg == "--mmap") {
+            mapInput = true;
+        }
+        else if (arg == "--stream") {
+            streaming = true;
+        }
+        else if (arg == "--window" && i + 1 < argc) {
+            windowSize = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10)) * 1024;
+            if (windowSize == 0) {
+                std::cout << "❌ Invalid window size: " << argv[i] << std::endl;
+                showHelp = true;
+                break;
+            }
+        }
+        else if (arg == "--max-memory" && i + 1 < argc) {
+            // Whole megabytes only: a suffix such as "1G" must not silently mean 1 MB
+            const char* text = argv[++i];
+            char* end = nullptr;
+            unsigned long long megabytes = std::strtoull(text, &end, 10);
+            bool valid = text[0] >= '0' && text[0] <= '9' && *end == '\0' && 
+                         megabytes > 0 && megabytes <= SIZE_MAX / (1024 * 1024);
+            memoryLimit = valid ? static_cast<size_t>(megabytes) * 1024 * 1024 : 0;
+            if (memoryLimit == 0) {
+                std::cout << "❌ Invalid memory budget: " << argv[i] << std::endl;
+                showHelp = true;
+                break;
+            }
+        }
+        else if (arg == "--batch" && i + 1 < argc) {
+            batchSpec = argv[++i];
+        }
+        else if (arg == "--no-uring") {
+            useIoUring = false;
+        }
+        else if (arg == "--weld") {
+            weld = true;
+        }
+        else if (arg == "--ignore-winding") {
+            ignoreWinding = true;
+        }
+        else if (arg == "-j" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long count = std::strtoul(argv[++i], &end, 10);
+            if (count == 0 || count > 1024 || *end != '\0') {
+                std::cout << "❌ Invalid thread count: " << argv[i] << std::endl;
+                showHelp = true;
+                break;
+            }
+            threadCount = static_cast<unsigned>(count);
+        }
+        else if ((arg[0] != '-' || arg == "-") && inputFile.empty()) {
             inputFile = arg;
         }
         else {
@@ -1010,8 +2284,9 @@ int main(int argc, char* argv[]) {
         return 0;
     }
     
-    if (showHelp || inputFile.empty()) {
+    if (showHelp || (inputFile.empty() && batchSpec.empty())) {
         std::cout << "Usage: Converter.exe [optionen] <file.3GM>" << std::endl;
+        std::cout << "       Converter.exe [optionen] --batch <dir|pattern|@list>" << std::endl;
         std::cout << std::endl;
         std::cout << "Options:" << std::endl;
         std::cout << "  -h, --help      Show this help message" << std::endl;
@@ -1019,23 +2294,96 @@ int main(int argc, char* argv[]) {
         std::cout << "  -o, --output    Specify output file (default: input basename)" << std::endl;
         std::cout << "  -d, --debug     Enable verbose logging" << std::endl;
         std::cout << "  -f, --format    Output format: obj, json (default: obj)" << std::endl;
+        std::cout << "  --populate      Prefault the whole input mapping before parsing" << std::endl;
+        std::cout << "  --no-mmap       Read input into memory instead of mapping it" << std::endl;
+        std::cout << "  --mmap          Batch: map each file on its worker instead of loading it ahead" << std::endl;
+        std::cout << "                  (implied by --populate)" << std::endl;
+        std::cout << "  --stream        Parse chunk by chunk with bounded memory (input '-' = stdin)" << std::endl;
+        std::cout << "  --window <KB>   Streaming window size, largest decodable chunk (default: 4096)" << std::endl;
+        std::cout << "  --batch <spec>  Convert a directory, a pattern like 'shapes/*LOD*.3GM' or the" << std::endl;
+        std::cout << "                  files listed in @list.txt; -o names the output directory" << std::endl;
+        std::cout << "  -j N            Batch worker threads (default: one per hardware thread)" << std::endl;
+        std::cout << "  --no-uring      Batch: load files with worker threads instead of io_uring" << std::endl;
+        std::cout << "  --weld          Merge Dot2/cDot vertices with identical positions" << std::endl;
+        std::cout << "  --ignore-winding  Drop repeated faces whatever their winding" << std::endl;
+        std::cout << "  --max-memory <MB>  Memory budget for --batch (reads ahead less, runs fewer files at once)" << std::endl;
+        std::cout << "                  and --stream (smaller window, larger chunks are reported)" << std::endl;
         std::cout << std::endl;
         std::cout << "Examples:" << std::endl;
         std::cout << "  Converter.exe ship.3GM" << std::endl;
         std::cout << "  Converter.exe -o custom.obj ship.3GM" << std::endl;
         std::cout << "  Converter.exe -d -f obj ship.3GM" << std::endl;
+        std::cout << "  cat level.3GM | Converter.exe --stream -o level -" << std::endl;
+        std::cout << "  Converter.exe --batch data/shapes -j 8 -o out" << std::endl;
         return showHelp ? 0 : 1;
     }
     
+    // Library errors are only reported in debug mode
+    ErrorHandler::SetDebugMode(verbose);
+    
+    // Under a budget the streaming window shrinks instead of the process running out of memory
+    if (streaming && memoryLimit > 0) {
+        size_t fitted = FitWindowToBudget(windowSize, memoryLimit);
+        if (fitted < windowSize) {
+            std::cout << "🧮 Streaming window reduced to " << fitted / 1024 << " KB by the memory budget" << std::endl;
+            windowSize = fitted;
+        }
+    }
+    
+    if (!batchSpec.empty()) {
+        if (!inputFile.empty()) {
+            std::cout << "❌ --batch cannot be combined with an input file: " << inputFile << std::endl;
+            return 1;
+        }
+        
+        // --populate applies to a mapping, so it selects mapped batch input
+        mapInput = mapInput || inputOptions.populate;
+        if (mapInput && inputOptions.forceRead) {
+            std::cout << "❌ --no-mmap cannot be combined with --mmap or --populate" << std::endl;
+            return 1;
+        }
+        if (mapInput && streaming) {
+            std::cout << "❌ --stream reads files chunk by chunk and cannot be combined with --mmap or --populate" << std::endl;
+            return 1;
+        }
+        
+        BatchOptions batchOptions;
+        batchOptions.inputSpec = batchSpec;
+        batchOptions.outputDir = outputFile;
+        batchOptions.threadCount = threadCount;
+        batchOptions.verbose = verbose;
+        batchOptions.streaming = streaming;
+        batchOptions.windowSize = windowSize;
+        batchOptions.useIoUring = useIoUring;
+        batchOptions.mapInput = mapInput;
+        batchOptions.inputOptions = inputOptions;
+        batchOptions.weld = weld;
+        batchOptions.ignoreWinding = ignoreWinding;
+        batchOptions.memoryLimit = memoryLimit;
+        return RunBatch(batchOptions);
+    }
+    
+    // One buffered file has nothing the budget could throttle or shrink
+    if (memoryLimit > 0 && !streaming) {
+        std::cout << "❌ --max-memory needs --batch or --stream" << std::endl;
+        return 1;
+    }
+    
+    bool fromStdin = (inputFile == "-");
+    if (fromStdin && !streaming) {
+        std::cout << "❌ Reading from stdin requires --stream" << std::endl;
+        return 1;
+    }
+    
     // Validate input file
-    if (!std::filesystem::exists(inputFile)) {
+    if (!fromStdin && !std::filesystem::exists(inputFile)) {
         std::cout << "❌ Input file not found: " << inputFile << std::endl;
         return 1;
     }
     
     if (outputFile.empty()) {
         std::filesystem::path inputPath(inputFile);
-        outputFile = inputPath.stem().string();
+        outputFile = fromStdin ? "stdin" : inputPath.stem().string();
     }
     
     if (verbose) {
@@ -1048,37 +2396,64 @@ int main(int argc, char* argv[]) {
     }
     
     try {
-        std::ifstream file(inputFile, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            std::cerr << "❌ Cannot open input file: " << inputFile << std::endl;
-            return 1;
+        if (streaming) {
+            FileDescriptorSource source;
+            if (!source.Open(inputFile)) {
+                std::cerr << "❌ Cannot read input file: " << inputFile << std::endl;
+                return 1;
+            }
+            
+            ThreadPool decodePool(ThreadPool::GetDefaultThreadCount());
+            Converter converter(outputFile);
+            converter.SetWeldVertices(weld);
+            converter.SetIgnoreWinding(ignoreWinding);
+            converter.SetDecodePool(&decodePool);
+            std::string shapeName = fromStdin ? outputFile : std::filesystem::path(inputFile).stem().string();
+            
+            if (!converter.ConvertFromStream(source, shapeName, windowSize)) {
+                std::cerr << "❌ Conversion failed" << std::endl;
+                return 1;
+            }
+            
+            std::cout << "✅ Conversion completed successfully!" << std::endl;
+            std::cout << "📄 Output files:" << std::endl;
+            std::cout << "  - " << outputFile << ".obj" << std::endl;
+            std::cout << "  - " << outputFile << ".mtl" << std::endl;
+            if (verbose || memoryLimit > 0) {
+                PrintMemoryUsage(memoryLimit);
+            }
+            return 0;
         }
         
-        std::streamsize size = file.tellg();
-        file.seekg(0, std::ios::beg);
-        
-        std::vector<uint8_t> data(size);
-        if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
-            std::cerr << "❌ Cannot read file data" << std::endl;
+        MappedFile input;
+        if (!input.Open(inputFile, inputOptions)) {
+            std::cerr << "❌ Cannot read input file: " << inputFile << std::endl;
             return 1;
         }
         
         if (verbose) {
-            std::cout << "✓ Loaded " << size << " bytes from file" << std::endl;
+            std::cout << "✓ " << (input.IsMapped() ? "Mapped " : "Loaded ") << input.Size() << " bytes from file" << std::endl;
         }
         
+        ThreadPool decodePool(ThreadPool::GetDefaultThreadCount());
         Converter converter(outputFile);
+        converter.SetWeldVertices(weld);
+        converter.SetIgnoreWinding(ignoreWinding);
+        converter.SetDecodePool(&decodePool);
         
         std::filesystem::path inputPath(inputFile);
         std::string shapeName = inputPath.stem().string();
         
-        bool success = converter.ConvertFrom3GM(data, shapeName);
+        bool success = converter.ConvertFrom3GM(input.GetSpan(), shapeName);
         
         if (success) {
             std::cout << "✅ Conversion completed successfully!" << std::endl;
             std::cout << "📄 Output files:" << std::endl;
             std::cout << "  - " << outputFile << ".obj" << std::endl;
             std::cout << "  - " << outputFile << ".mtl" << std::endl;
+            if (verbose) {
+                PrintMemoryUsage(0);
+            }
         } else {
             std::cerr << "❌ Conversion failed" << std::endl;
             return 1;
@@ -4,6 +4,8 @@
 #include "ChunkProcessor.h"
 #include "HeaderDetector.h"
 #include "ChunkReader.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
 #include <string>
 #include <memory>
 #include <map>
@@ -17,8 +19,9 @@ private:
     // Chunk processors registry
     std::map<ChunkType, std::unique_ptr<ChunkProcessor>> chunkProcessors_;
     
-    // File data
-    std::vector<uint8_t> fileData_;
+    // File data (memory-mapped, or read into memory when mapping is unavailable)
+    MappedFile inputFile_;
+    MappedFile::Options inputOptions_;
     std::string filename_;
     
     // Parsing state
@@ -26,6 +29,13 @@ private:
     std::unique_ptr<ChunkReader> chunkReader_;
     ShapeData parsedShape_;
     
+    // Defer vertex/primitive/surface/animation decoding until first access
+    bool lazyDecoding_;
+    
+    // Parallel chunk processing (created on first parallel parse)
+    unsigned threadCount_;
+    std::unique_ptr<ThreadPool> threadPool_;
+    
     // Debug and statistics
     bool debugMode_;
     size_t processedChunkCount_;
@@ -60,6 +70,35 @@ public:
      */
     bool ParseBuffer(const uint8_t* data, size_t size, const std::string& debugName = "");
     
+    /**
+     * Configure how ParseFile maps its input (populate, sequential hint, fallback)
+     */
+    void SetInputOptions(const MappedFile::Options& options) { inputOptions_ = options; }
+    
+    /**
+     * Enable lazy decoding: chunk processors for vertex, primitive, surface
+     * and animation chunks run on first access to that ShapeData stream
+     * instead of during parsing, each into its own slice merged as eager
+     * parsing merges it, so both modes give the same shape. The parsed
+     * buffer (and the registered processors) must then outlive the shape's
+     * use; ParseFile keeps its mapping open until Reset.
+     */
+    void SetLazyDecoding(bool enabled) { lazyDecoding_ = enabled; }
+    bool IsLazyDecoding() const { return lazyDecoding_; }
+    
+    /**
+     * Set worker count for parallel chunk processing
+     * @param threadCount 0 = one per hardware thread, 1 = process serially
+     */
+    void SetThreadCount(unsigned threadCount);
+    unsigned GetThreadCount() const { return threadCount_; }
+    
+    /**
+     * Minimum payload of vertex/primitive/surface/animation chunks before
+     * parsing goes parallel; below it thread hand-off costs more than it saves
+     */
+    static const size_t PARALLEL_MIN_BYTES = 64 * 1024;
+    
     /**
      * Get parsed shape data
      */
@@ -110,7 +149,7 @@ public:
     
 private:
     /**
-     * Load file from disk into memory
+     * Map file from disk (read() fallback when mapping is unavailable)
      */
     bool LoadFileData(const std::string& filename);
     
@@ -124,8 +163,28 @@ private:
      */
     bool ProcessAllChunks();
     
+    /**
+     * Process chunks into one ShapeData slice per chunk, then merge
+     * Stages follow the data dependencies: vertices → primitives → surfaces
+     * → animation. With useThreadPool the chunks within a stage run
+     * concurrently; slices are merged in file order once all stages are done.
+     */
+    bool ProcessAllChunksInSlices(const std::vector<ChunkHeader>& chunks, bool useThreadPool);
+    
+    /**
+     * Defer every vertex/primitive/surface/animation chunk to its stream
+     * Each deferred decode processes its chunk into a slice and merges it
+     * like ProcessAllChunksInSlices, so lazy and eager results match.
+     */
+    bool DeferAllChunksInSlices(const std::vector<ChunkHeader>& chunks);
+    
+    /**
+     * Check if the chunk list has enough independent work to go parallel
+     */
+    bool ShouldProcessInParallel(const std::vector<ChunkHeader>& chunks) const;
+    
     /**
      * Process individual chunk with appropriate processor
      */
-    bool ProcessChunk(const ChunkHeader& header, const uint8_t* data);
+    bool ProcessChunk(const ChunkHeader& header, ByteSpan data);
 };
\ No newline at end of file
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "AnimationData.h"
+#include "MemoryTracker.h"
 #include <cstdint>
 #include <vector>
 #include <memory>
 
+class ShapeData;
+
 /**
  * RFC VALIDATED: Animation System Controller
  * Based on gm_ApplyShapeKeyFrames.cpp and related animation functions
@@ -73,6 +76,30 @@ public:
      */
     void UpdateAnimations(float deltaTime);
     
+    /**
+     * Give a batch the shape holding its keyframe positions
+     * Interpolated keyframes blend the shapes of their two batches into the
+     * blend target (BlendShapePositions); without shapes on both batches
+     * and a target, the interpolation is only counted.
+     * @param shape Must outlive its use by ApplyShapeKeyFrames, nullptr to remove
+     */
+    void SetBatchShape(uint32_t batchIndex, const ShapeData* shape);
+    const ShapeData* GetBatchShape(uint32_t batchIndex) const;
+    
+    /**
+     * Set the shape interpolated positions are written to
+     */
+    void SetBlendTarget(ShapeData* shape) { blendTarget_ = shape; }
+    
+    /**
+     * Blend the positions of two keyframe shapes into a third
+     * Reads only the x/y/z attributes, contiguously when the shapes use the
+     * SoA layout. All three shapes must have the same vertex count.
+     * @param factor 0 gives from, 1 gives to
+     * @return false if the vertex counts differ or positions are quantised
+     */
+    static bool BlendShapePositions(const ShapeData& from, const ShapeData& to, float factor, ShapeData& out);
+    
     /**
      * Check if animation system is ready
      */
@@ -85,7 +112,7 @@ public:
         uint32_t activeBatches;
         uint32_t totalKeyframes;
         float currentTime;
-        size_t memoryUsed;
+        size_t memoryUsed;                  // This system's tables; all systems: MemoryTracker::GetUsage
         uint32_t interpolationsPerFrame;
     };
     
@@ -171,12 +198,17 @@ private:
     bool ValidateBatch(const AnimationBatch& batch) const;
     
 private:
+    template <typename T>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, MemorySubsystem::AnimationSystem>>;
+    
     // RFC VALIDATED: System state matching original global variables
     AnimationSystemGlobals globals_;           // Animation system globals
-    std::vector<AnimationBatch> batches_;      // Animation batches
-    std::vector<KeyframeData> keyframes_;      // All keyframe data
-    std::vector<SoPFChunkData> sopfChunks_;    // soPF chunk data
-    std::vector<FPosChunkData> fposChunks_;    // FPos chunk data
+    TrackedVector<AnimationBatch> batches_;    // Animation batches
+    TrackedVector<KeyframeData> keyframes_;    // All keyframe data
+    TrackedVector<SoPFChunkData> sopfChunks_;  // soPF chunk data
+    TrackedVector<FPosChunkData> fposChunks_;  // FPos chunk data
+    std::vector<const ShapeData*> batchShapes_; // Keyframe shape per batch, nullptr = none
+    ShapeData* blendTarget_;                   // Receives interpolated positions
     
     // System configuration
     uint32_t maxBatches_;                      // Maximum batch count
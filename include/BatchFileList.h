@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct BatchFile {
+    std::string path;
+    uintmax_t size;     // 0 if the size could not be read
+
+    BatchFile() : size(0) {}
+    BatchFile(const std::string& filePath, uintmax_t fileSize) : path(filePath), size(fileSize) {}
+};
+
+/**
+ * Input expansion for batch conversion
+ * Turns a batch spec into a list of files ordered for scheduling. The spec
+ * is one of:
+ *   @list.txt         one file per line, blank lines and '#' comments ignored
+ *   directory         every .3GM file directly inside it
+ *   dir/name*.3GM     '*' and '?' wildcards in the file name part
+ *   file.3GM          a single file
+ */
+class BatchFileList {
+public:
+    /**
+     * Expand a batch spec
+     * @param spec Input spec, see class comment
+     * @param files Receives the files, largest first
+     * @return false if the list file or directory could not be read
+     */
+    static bool Collect(const std::string& spec, std::vector<BatchFile>& files);
+
+    /**
+     * Order files largest first (stable, so equal sizes keep their order)
+     * Big files started last would leave the tail of a batch to one core.
+     */
+    static void SortLargestFirst(std::vector<BatchFile>& files);
+
+    /**
+     * Match a file name against '*' / '?' wildcards
+     */
+    static bool MatchWildcard(const char* pattern, const char* name);
+
+    /**
+     * Check for a .3GM extension (case-insensitive)
+     */
+    static bool Is3GMFile(const std::filesystem::path& path);
+
+private:
+    static bool CollectFromList(const std::string& listFile, std::vector<BatchFile>& files);
+    static bool CollectFromDirectory(const std::filesystem::path& directory, const char* pattern,
+                                     std::vector<BatchFile>& files);
+    static BatchFile MakeEntry(const std::string& path);
+};
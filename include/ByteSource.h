@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ByteSpan.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * Pull-based byte source for streaming input
+ * Readers ask for the next bytes instead of receiving the whole file,
+ * so files, pipes and memory buffers can be consumed the same way.
+ */
+class ByteSource {
+public:
+    virtual ~ByteSource() {}
+
+    /**
+     * Read up to count bytes into buffer
+     * @return Number of bytes read, 0 at end of input or on error
+     */
+    virtual size_t Read(uint8_t* buffer, size_t count) = 0;
+
+    /**
+     * Check if the last Read stopped because of an error rather than end of input
+     */
+    virtual bool HasError() const { return false; }
+};
+
+/**
+ * Byte source reading from a file descriptor (file, pipe, stdin)
+ */
+class FileDescriptorSource : public ByteSource {
+public:
+    FileDescriptorSource();
+
+    /**
+     * Wrap an existing descriptor
+     * @param fd Open descriptor
+     * @param ownsDescriptor Close descriptor on destruction
+     */
+    explicit FileDescriptorSource(int fd, bool ownsDescriptor = false);
+
+    ~FileDescriptorSource();
+
+    FileDescriptorSource(const FileDescriptorSource&) = delete;
+    FileDescriptorSource& operator=(const FileDescriptorSource&) = delete;
+
+    /**
+     * Open file for sequential reading, "-" selects standard input
+     * @return true if the file was opened
+     */
+    bool Open(const std::string& filename);
+
+    void Close();
+
+    bool IsOpen() const { return fd_ >= 0; }
+
+    size_t Read(uint8_t* buffer, size_t count) override;
+
+    bool HasError() const override { return error_; }
+
+private:
+    int fd_;
+    bool ownsDescriptor_;
+    bool error_;
+};
+
+/**
+ * Byte source over an in-memory buffer (borrowed, not copied)
+ */
+class MemorySource : public ByteSource {
+public:
+    MemorySource(const uint8_t* data, size_t size);
+    explicit MemorySource(ByteSpan data);
+
+    size_t Read(uint8_t* buffer, size_t count) override;
+
+    size_t GetRemaining() const { return data_.size() - offset_; }
+
+private:
+    ByteSpan data_;
+    size_t offset_;
+};
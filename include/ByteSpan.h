@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Read-only view onto a contiguous byte range
+ * Lets parsers consume mapped or borrowed input without copying it.
+ * The viewed memory must outlive the span.
+ */
+struct ByteSpan {
+    const uint8_t* ptr;     // First byte of the view
+    size_t length;          // Number of bytes in the view
+
+    ByteSpan() : ptr(nullptr), length(0) {}
+
+    ByteSpan(const uint8_t* data, size_t size) : ptr(data), length(size) {}
+
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    const uint8_t& operator[](size_t index) const { return ptr[index]; }
+
+    const uint8_t* begin() const { return ptr; }
+    const uint8_t* end() const { return ptr + length; }
+
+    /**
+     * Get a sub-view, clamped to the bounds of this span
+     * @param offset First byte of the sub-view
+     * @param count Number of bytes (clamped to what remains)
+     */
+    ByteSpan subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const {
+        if (offset >= length) {
+            return ByteSpan(ptr ? ptr + length : nullptr, 0);
+        }
+        size_t remaining = length - offset;
+        return ByteSpan(ptr + offset, count < remaining ? count : remaining);
+    }
+
+    /**
+     * Copy the viewed bytes into an owned buffer
+     * For consumers that must keep data beyond the lifetime of the input.
+     */
+    std::vector<uint8_t> ToVector() const {
+        return std::vector<uint8_t>(begin(), end());
+    }
+};
@@ -53,6 +53,24 @@ namespace ByteSwap {
                (static_cast<uint16_t>(data[1]) << 8);
     }
     
+    /**
+     * Read 32-bit big-endian value from byte array
+     * 3GM chunk size fields and vertex payloads are stored big-endian
+     */
+    inline uint32_t ReadBigEndian32(const uint8_t* data) {
+        return (static_cast<uint32_t>(data[0]) << 24) |
+               (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) |
+               static_cast<uint32_t>(data[3]);
+    }
+    
+    /**
+     * Read 16-bit big-endian value from byte array
+     */
+    inline uint16_t ReadBigEndian16(const uint8_t* data) {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+    
     /**
      * Write 32-bit value as little-endian to byte array
      */
@@ -63,6 +81,14 @@ namespace ByteSwap {
         data[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
     }
     
+    /**
+     * Write 16-bit value as little-endian to byte array
+     */
+    inline void WriteLittleEndian16(uint8_t* data, uint16_t value) {
+        data[0] = static_cast<uint8_t>(value & 0xFF);
+        data[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    }
+    
     /**
      * Verify byte-swap algorithm correctness (for testing)
      * Returns true if all validation tests pass
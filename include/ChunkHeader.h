@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include "ChunkTypes.h"
 
 /**
@@ -11,11 +12,12 @@ struct ChunkHeader {
     uint32_t rawID;      // 4-byte chunk identifier (little-endian ASCII)
     uint32_t size;       // Data size in bytes (little-endian)
     ChunkType type;      // Parsed chunk type enum
+    size_t offset;       // File offset of the chunk ID (set by ChunkReader)
     
-    ChunkHeader() : rawID(0), size(0), type(ChunkType::Unknown) {}
+    ChunkHeader() : rawID(0), size(0), type(ChunkType::Unknown), offset(0) {}
     
-    ChunkHeader(uint32_t id, uint32_t dataSize) 
-        : rawID(id), size(dataSize), type(GetChunkTypeFromRawID(id)) {}
+    ChunkHeader(uint32_t id, uint32_t dataSize, size_t fileOffset = 0) 
+        : rawID(id), size(dataSize), type(GetChunkTypeFromRawID(id)), offset(fileOffset) {}
     
     /**
      * Check if this is a valid, non-empty chunk
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include "ByteSpan.h"
 #include "ChunkTypes.h"
 
 // Forward declarations
@@ -19,12 +20,13 @@ public:
     /**
      * Process a chunk of data
      * @param header Parsed chunk header with ID and size
-     * @param data Raw chunk data (header.size bytes)
+     * @param data Chunk payload, a view into the parsed file (header.size bytes);
+     *             processors that keep data after returning copy it with ToVector()
      * @param shape Target shape to populate with data
      * @return true if processing succeeded, false on error
      */
     virtual bool ProcessChunk(const ChunkHeader& header, 
-                            const uint8_t* data, 
+                            ByteSpan data, 
                             ShapeData& shape) = 0;
     
     /**
@@ -42,9 +44,18 @@ public:
     /**
      * Validate chunk data before processing
      * @param header Chunk header
-     * @param data Raw chunk data
+     * @param data Chunk payload
      * @return true if data is valid for this chunk type
      */
     virtual bool ValidateChunkData(const ChunkHeader& header, 
-                                 const uint8_t* data) const = 0;
+                                 ByteSpan data) const = 0;
+    
+    /**
+     * Check if ProcessChunk may run for several chunks at once
+     * Parallel parsing gives every chunk its own ShapeData slice; processors
+     * that keep state between calls or write globals must return false and
+     * are then fed their chunks one after another on a single worker.
+     * @return true if ProcessChunk is reentrant
+     */
+    virtual bool SupportsConcurrentChunks() const { return true; }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ByteSpan.h"
 #include "ChunkHeader.h"
 #include <vector>
 #include <cstdint>
@@ -12,6 +13,7 @@ class ChunkReader {
 private:
     const uint8_t* fileData_;
     size_t fileSize_;
+    size_t startOffset_;
     size_t currentOffset_;
     std::vector<ChunkHeader> discoveredChunks_;
     
@@ -32,11 +34,13 @@ public:
     bool ReadNextChunkHeader(ChunkHeader& header);
     
     /**
-     * Get chunk data pointer for given header
-     * @param header Chunk header from ReadNextChunkHeader
-     * @return Pointer to chunk data (after 8-byte header)
+     * Get chunk payload for given header without copying it
+     * Uses the header's own offset, so it is valid for any discovered chunk
+     * @param header Chunk header from ReadNextChunkHeader or GetDiscoveredChunks
+     * @return View of the header.size bytes after the 8-byte chunk header,
+     *         null if the chunk does not fit in the file
      */
-    const uint8_t* GetChunkData(const ChunkHeader& header) const;
+    ByteSpan GetChunkData(const ChunkHeader& header) const;
     
     /**
      * Skip to next chunk after current one
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "ByteSpan.h"
+#include "ChunkHeader.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * One entry in the chunk table of contents
+ */
+struct ChunkTableEntry {
+    ChunkHeader header;     // Tag, payload size and parsed type
+    size_t position;        // Offset of the 4-byte tag in the file
+    size_t size;            // Total span: tag + size field + payload
+    bool recovered;         // Boundaries found by tag resync, not by the size walk
+
+    ChunkTableEntry() : position(0), size(0), recovered(false) {}
+
+    ChunkType GetType() const { return header.type; }
+
+    /**
+     * Offset of the first payload byte (after tag and size field)
+     */
+    size_t GetDataOffset() const { return position + 8; }
+
+    /**
+     * Payload size in bytes, 0 for a bare "End " marker
+     */
+    size_t GetDataSize() const { return size > 8 ? size - 8 : 0; }
+
+    /**
+     * Get the payload as a view into the file data
+     */
+    ByteSpan GetData(ByteSpan file) const { return file.subspan(GetDataOffset(), GetDataSize()); }
+
+    /**
+     * Get the raw 4-character tag (e.g. "Pos ")
+     */
+    std::string GetTag() const;
+};
+
+typedef std::vector<ChunkTableEntry, TrackedAllocator<ChunkTableEntry, MemorySubsystem::ChunkTable>> ChunkEntryArray;
+
+/**
+ * Chunk table of contents
+ * Built in a single pass by following each chunk's size field, so a
+ * well-formed file costs O(chunks) instead of a byte-by-byte tag scan.
+ * Only when a size field points somewhere implausible does the builder
+ * fall back to scanning for the next known tag.
+ */
+class ChunkTable {
+public:
+    enum class SizeByteOrder {
+        BigEndian,      // Size fields stored big-endian (shipped game data)
+        LittleEndian    // Size fields stored little-endian
+    };
+
+    ChunkTable();
+
+    /**
+     * Build table for a complete 3GM file
+     * @param data File contents, must outlive any spans taken from the table
+     * @return true if at least one chunk was found
+     */
+    bool Build(ByteSpan data);
+
+    /**
+     * Forget all entries, keeping their storage for the next Build
+     */
+    void Clear();
+
+    /**
+     * Get bytes reserved for entries
+     */
+    size_t GetReservedBytes() const { return entries_.capacity() * sizeof(ChunkTableEntry); }
+
+    const ChunkEntryArray& GetEntries() const { return entries_; }
+    size_t GetChunkCount() const { return entries_.size(); }
+    bool IsEmpty() const { return entries_.empty(); }
+
+    /**
+     * Find first chunk of given type
+     * @return Entry or nullptr if not present
+     */
+    const ChunkTableEntry* Find(ChunkType type) const;
+
+    /**
+     * Find all chunks of given type in file order
+     */
+    std::vector<const ChunkTableEntry*> FindAll(ChunkType type) const;
+
+    bool Contains(ChunkType type) const { return Find(type) != nullptr; }
+
+    /**
+     * Byte order detected for the size fields
+     * Payloads do not follow it: every chunk type has a fixed payload order
+     * (Dot2 and float FDot big-endian, cDot and compressed FDot little-endian).
+     */
+    SizeByteOrder GetSizeByteOrder() const { return sizeOrder_; }
+
+    /**
+     * Number of chunks whose boundaries had to be recovered by tag resync
+     */
+    size_t GetRecoveredCount() const { return recoveredCount_; }
+
+    /**
+     * Check if a raw little-endian tag value is a known chunk identifier
+     */
+    static bool IsKnownTag(uint32_t rawID);
+
+private:
+    /**
+     * Read size field at offset using the detected byte order
+     */
+    uint32_t ReadSize(const uint8_t* sizeField) const;
+
+    /**
+     * Check if a chunk boundary lands on a known tag or the end of file
+     */
+    bool IsBoundary(size_t offset) const;
+
+    /**
+     * Pick size byte order from the first chunk: whichever order lands
+     * on the next known tag (or EOF) wins, big-endian preferred
+     */
+    void DetectSizeByteOrder(size_t firstChunk);
+
+    /**
+     * Scan for the next plausible chunk start at or after offset
+     * @return Offset of next chunk, or data size if none found
+     */
+    size_t Resync(size_t offset) const;
+
+    ByteSpan data_;
+    ChunkEntryArray entries_;
+    SizeByteOrder sizeOrder_;
+    size_t recoveredCount_;
+};
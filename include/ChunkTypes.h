@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 
 /**
  * 3GM Chunk Types - All values in little-endian format
@@ -10,6 +11,8 @@ enum class ChunkType : uint32_t {
     // Vertex Data Chunks
     Dot2 = 0x32746f44,  // "Dot2" - Vertex coordinates (original format)
     FDot = 0x746f4446,  // "FDot" - Compressed vertex data 
+    Dots = 0x73746f44,  // "Dots" - Float vertex coordinates
+    cDot = 0x746f4463,  // "cDot" - Compact int16 vertex coordinates
     
     // Primitive Data Chunks  
     Prim = 0x6d697250,  // "Prim" - Simple primitives
@@ -21,14 +24,35 @@ enum class ChunkType : uint32_t {
     
     // Metadata Chunks
     TxNm = 0x6d4e7854,  // "TxNm" - Texture names
+    Grp2 = 0x32707247,  // "Grp2" - Group data
+    Atr2 = 0x32727441,  // "Atr2" - Attribute data
+    SmGr = 0x72476d53,  // "SmGr" - Smoothing groups
+    Pos  = 0x20736f50,  // "Pos " - Shape position (note trailing space)
+    fPos = 0x736f5066,  // "fPos" - Float shape position
     
     // Control Chunks
+    Header = 0x4d474433, // "3DGM" - File header magic, laid out as a chunk
     End  = 0x20646e45,  // "End " - File terminator (note trailing space)
     
     // Unknown/Unsupported
     Unknown = 0x00000000
 };
 
+/**
+ * All recognised chunk types, for code that has to enumerate the tags
+ * (tag scanners). Keep in sync with GetChunkTypeFromRawID.
+ */
+constexpr ChunkType KnownChunkTypes[] = {
+    ChunkType::Dot2, ChunkType::FDot, ChunkType::Dots, ChunkType::cDot,
+    ChunkType::Prim, ChunkType::Line,
+    ChunkType::soPF, ChunkType::FPos,
+    ChunkType::TxNm, ChunkType::Grp2, ChunkType::Atr2, ChunkType::SmGr,
+    ChunkType::Pos,  ChunkType::fPos,
+    ChunkType::Header, ChunkType::End
+};
+
+constexpr size_t KnownChunkTypeCount = sizeof(KnownChunkTypes) / sizeof(KnownChunkTypes[0]);
+
 /**
  * Convert raw 4-byte chunk ID to ChunkType enum
  * Handles little-endian byte order conversion
@@ -37,11 +61,19 @@ inline ChunkType GetChunkTypeFromRawID(uint32_t rawID) {
     switch (rawID) {
         case 0x32746f44: return ChunkType::Dot2;
         case 0x746f4446: return ChunkType::FDot; 
+        case 0x73746f44: return ChunkType::Dots;
+        case 0x746f4463: return ChunkType::cDot;
         case 0x6d697250: return ChunkType::Prim;
         case 0x656e694c: return ChunkType::Line;
         case 0x46506f73: return ChunkType::soPF;
         case 0x736f5046: return ChunkType::FPos;
         case 0x6d4e7854: return ChunkType::TxNm;
+        case 0x32707247: return ChunkType::Grp2;
+        case 0x32727441: return ChunkType::Atr2;
+        case 0x72476d53: return ChunkType::SmGr;
+        case 0x20736f50: return ChunkType::Pos;
+        case 0x736f5066: return ChunkType::fPos;
+        case 0x4d474433: return ChunkType::Header;
         case 0x20646e45: return ChunkType::End;
         default:         return ChunkType::Unknown;
     }
@@ -54,11 +86,19 @@ inline const char* ChunkTypeToString(ChunkType type) {
     switch (type) {
         case ChunkType::Dot2: return "Dot2";
         case ChunkType::FDot: return "FDot";
+        case ChunkType::Dots: return "Dots";
+        case ChunkType::cDot: return "cDot";
         case ChunkType::Prim: return "Prim";
         case ChunkType::Line: return "Line";
         case ChunkType::soPF: return "soPF";
         case ChunkType::FPos: return "FPos";
         case ChunkType::TxNm: return "TxNm";
+        case ChunkType::Grp2: return "Grp2";
+        case ChunkType::Atr2: return "Atr2";
+        case ChunkType::SmGr: return "SmGr";
+        case ChunkType::Pos:  return "Pos";
+        case ChunkType::fPos: return "fPos";
+        case ChunkType::Header: return "3DGM";
         case ChunkType::End:  return "End";
         case ChunkType::Unknown: return "Unknown";
         default: return "Invalid";
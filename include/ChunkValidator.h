@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ByteSpan.h"
+#include "ChunkHeader.h"
+#include <cstdint>
+#include <cstddef>
+
+class ChunkProcessor;
+
+/**
+ * Fixed-size record layout of a chunk
+ * Offsets are relative to the buffer the layout is validated against, which
+ * may be the chunk payload or the whole file.
+ */
+struct ChunkRecordLayout {
+    size_t offset;          // First byte of the first record
+    size_t recordSize;      // Bytes per record
+    size_t recordCount;     // Number of records the decoder will read
+
+    ChunkRecordLayout() : offset(0), recordSize(0), recordCount(0) {}
+
+    ChunkRecordLayout(size_t first, size_t size, size_t count)
+        : offset(first), recordSize(size), recordCount(count) {}
+};
+
+/**
+ * Chunk whose records are proven to lie inside their buffer
+ * Only ChunkValidator fills one in, so a decoder that takes a ValidatedChunk
+ * may read every record without bounds checks and its inner loop is free to
+ * be unrolled and vectorised. A default-constructed instance has no records.
+ */
+class ValidatedChunk {
+public:
+    ValidatedChunk() : records_(nullptr), recordSize_(0), recordCount_(0) {}
+
+    const ChunkHeader& GetHeader() const { return header_; }
+
+    const uint8_t* GetRecords() const { return records_; }
+    const uint8_t* GetRecord(size_t index) const { return records_ + index * recordSize_; }
+
+    size_t GetRecordSize() const { return recordSize_; }
+    size_t GetRecordCount() const { return recordCount_; }
+    size_t GetByteCount() const { return recordSize_ * recordCount_; }
+
+private:
+    friend class ChunkValidator;
+
+    ChunkHeader header_;
+    const uint8_t* records_;
+    size_t recordSize_;
+    size_t recordCount_;
+};
+
+/**
+ * One-pass structural validation for chunk decoders
+ * Proves up front that every record a decoder will touch is inside the
+ * buffer, instead of re-checking bounds per element. Input that fails
+ * validation (truncated or with damaged size fields) has to go through the
+ * decoder's checked path instead.
+ */
+class ChunkValidator {
+public:
+    /**
+     * Check that a record layout fits in a buffer
+     * @param header Header of the chunk the records belong to
+     * @param buffer Data the layout offsets refer to
+     * @param layout Records the decoder will read
+     * @param validated Receives the proven records on success
+     * @return false if any record would run past the end of the buffer
+     */
+    static bool ValidateRecords(const ChunkHeader& header, ByteSpan buffer,
+                                const ChunkRecordLayout& layout, ValidatedChunk& validated);
+
+    /**
+     * Run a processor's ValidateChunkData on the payload, then check the layout
+     * @param processor Processor that will decode the chunk
+     * @param payload Chunk payload, layout offsets are relative to it
+     * @return false if the processor rejects the payload or the layout does not fit
+     */
+    static bool ValidateChunk(const ChunkProcessor& processor, const ChunkHeader& header, ByteSpan payload,
+                              const ChunkRecordLayout& layout, ValidatedChunk& validated);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * Runtime CPU feature detection for SIMD kernel dispatch
+ * Kernels are compiled for their instruction set with SHAPELOADER_TARGET
+ * and only called after the matching Has*() check succeeded, so the
+ * library itself still builds for the baseline architecture.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SHAPELOADER_X86 1
+#endif
+
+#if defined(SHAPELOADER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHAPELOADER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SHAPELOADER_TARGET(isa)
+#endif
+
+class CpuFeatures {
+public:
+    static bool HasSSE2();
+    static bool HasSSSE3();
+    static bool HasAVX2();
+    static bool HasF16C();      // Half-float conversion (vcvtph2ps)
+
+    /**
+     * Get short description of usable features for diagnostics
+     */
+    static const char* GetDescription();
+};
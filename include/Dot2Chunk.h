@@ -11,7 +11,7 @@
 class Dot2ChunkProcessor : public ChunkProcessor {
 public:
     bool ProcessChunk(const ChunkHeader& header, 
-                     const uint8_t* data, 
+                     ByteSpan data, 
                      ShapeData& shape) override;
     
     ChunkType GetChunkType() const override { 
@@ -23,7 +23,7 @@ public:
     }
     
     bool ValidateChunkData(const ChunkHeader& header, 
-                          const uint8_t* data) const override;
+                          ByteSpan data) const override;
 
 private:
     /**
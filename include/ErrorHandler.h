@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -25,8 +26,9 @@ namespace ErrorHandler {
     
     /**
      * Global error state (matches original last_processed_event)
+     * Atomic because batch conversion parses several files at once
      */
-    extern bool g_lastProcessedEvent;
+    extern std::atomic<bool> g_lastProcessedEvent;
     
     /**
      * Process system event
@@ -10,7 +10,7 @@
 class FDotChunkProcessor : public ChunkProcessor {
 public:
     bool ProcessChunk(const ChunkHeader& header, 
-                     const uint8_t* data, 
+                     ByteSpan data, 
                      ShapeData& shape) override;
     
     ChunkType GetChunkType() const override { 
@@ -22,7 +22,7 @@ public:
     }
     
     bool ValidateChunkData(const ChunkHeader& header, 
-                          const uint8_t* data) const override;
+                          ByteSpan data) const override;
 
 private:
     /**
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Set of triangles already emitted for a shape
+ * A triangle is keyed by its three indices (96 bits), canonicalised so the
+ * same face is found whichever corner it starts from. Keys live inline in
+ * an open-addressing table (linear probing, load at most 1/2), so a lookup
+ * allocates nothing and touches one or two cache lines.
+ */
+class FaceDeduplicator {
+public:
+    /**
+     * How two triangles are compared
+     */
+    enum class Winding {
+        Preserve,   // (a, b, c) equals its rotations, not (a, c, b)
+        Ignore      // Any order of the same three indices is one face
+    };
+
+    explicit FaceDeduplicator(std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                              Winding winding = Winding::Preserve);
+
+    /**
+     * Make room for faceCount faces without rehashing
+     */
+    void Reserve(size_t faceCount);
+
+    /**
+     * Add a triangle
+     * A triangle with an index of 0xFFFFFFFF (the empty slot marker) cannot
+     * be keyed: it is not stored and always reported new.
+     * @return true if the triangle is new, false if it was already added
+     */
+    bool Insert(uint32_t a, uint32_t b, uint32_t c);
+
+    /**
+     * Remove all triangles, keeping the table
+     */
+    void Clear();
+
+    /**
+     * Remove all triangles and give the table back to the memory resource
+     * Needed before the resource is reset (ParseArena::Reset).
+     */
+    void Release();
+
+    void SetWinding(Winding winding);
+    Winding GetWinding() const { return winding_; }
+
+    size_t GetCount() const { return count_; }
+    size_t GetCapacity() const { return slots_.size() / 2; }
+
+private:
+    struct Key {
+        uint32_t v[3];
+    };
+
+    static const uint32_t EMPTY = 0xFFFFFFFF;   // Not a valid vertex index
+
+    Key MakeKey(uint32_t a, uint32_t b, uint32_t c) const;
+    static size_t Hash(const Key& key);
+    void Rehash(size_t slotCount);
+
+    std::pmr::vector<Key> slots_;   // Size is zero or a power of two
+    size_t count_;
+    Winding winding_;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Hash mixing shared by the open-addressing and unordered tables
+ * Keys fold their fields in with Combine, then Finalize (the splitmix64
+ * finaliser) spreads nearby keys over the whole table.
+ */
+namespace HashMix {
+
+    inline uint64_t Combine(uint64_t h, uint64_t value) {
+        return h * 0x9E3779B97F4A7C15ull + value;
+    }
+
+    inline size_t Finalize(uint64_t h) {
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+        return static_cast<size_t>(h);
+    }
+
+}
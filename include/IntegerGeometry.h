@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Vertex position in fixed point, exact for every integer vertex chunk
+ * Units are hundredths: cDot values are stored as is, Dot2 tenths are
+ * multiplied by 10. 64-bit components hold any Dot2 value without overflow.
+ */
+struct IntegerVertex {
+    int64_t x, y, z;
+
+    bool operator==(const IntegerVertex& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+    bool operator!=(const IntegerVertex& other) const { return !(*this == other); }
+};
+
+/**
+ * Hash over the exact coordinates (no tolerance, no float rounding)
+ */
+struct IntegerVertexHash {
+    size_t operator()(const IntegerVertex& vertex) const;
+};
+
+typedef std::pmr::vector<IntegerVertex> IntegerVertexArray;
+
+/**
+ * Integer-domain geometry for Dot2 and cDot shapes
+ * Positions stay in fixed point through welding, bounds and index
+ * remapping; they become floats only when a caller asks for them. Equal
+ * positions are equal integers, so welding is exact and needs a plain
+ * hash set instead of a tolerance search.
+ */
+class IntegerGeometry {
+public:
+    static const int64_t UNITS_PER_COORDINATE = 100;   // Hundredths
+
+    /**
+     * Append decoded records to positions
+     * @param records Dot2: big-endian int32 x/y/z in tenths (12 bytes per vertex)
+     *                cDot: little-endian int16 x/y/z in hundredths, -1 = unused axis (6 bytes per vertex)
+     */
+    static void DecodeDot2(const uint8_t* records, size_t vertexCount, IntegerVertexArray& positions);
+    static void DecodeCDot(const uint8_t* records, size_t vertexCount, IntegerVertexArray& positions);
+
+    /**
+     * Merge vertices with identical positions
+     * Unique positions keep the order of their first occurrence; the
+     * lookup table is allocated from unique's memory resource.
+     * @param positions Positions to weld
+     * @param unique Receives one entry per distinct position
+     * @param remap Receives the index into unique for every input position
+     * @return Number of distinct positions
+     */
+    static size_t Weld(const IntegerVertexArray& positions, IntegerVertexArray& unique,
+                       std::pmr::vector<uint32_t>& remap);
+
+    /**
+     * Get bounds as min x/y/z then max x/y/z
+     * @return false if there are no positions
+     */
+    static bool GetBounds(const IntegerVertexArray& positions, int64_t minMax[6]);
+
+    /**
+     * Convert one fixed-point coordinate to float
+     * Whole tenths divide like the Dot2 decoder and the rest like the cDot
+     * decoder, so welded output carries the same floats as unwelded output.
+     */
+    static float ToFloat(int64_t value) {
+        if (value % 10 == 0) {
+            return static_cast<float>(value / 10) / 10.0f;
+        }
+        return static_cast<float>(value) / 100.0f;
+    }
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ByteSpan.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Zero-copy file input source
+ * Maps the file into memory so parsers read the page cache directly.
+ * Falls back to a single read() into an owned buffer when mapping
+ * is unavailable (pipes, special files, unsupported platforms).
+ */
+class MappedFile {
+public:
+    struct Options {
+        bool populate;        // Prefault all pages up front (MAP_POPULATE)
+        bool sequential;      // Hint sequential access (madvise MADV_SEQUENTIAL)
+        bool allowFallback;   // Read into memory if mapping fails
+        bool forceRead;       // Skip mapping and always read into memory
+
+        Options() : populate(false), sequential(true), allowFallback(true), forceRead(false) {}
+    };
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Open file and make its contents available
+     * @param filename Path to file
+     * @param options Mapping options
+     * @return true if the file contents are accessible; failures are posted to ErrorHandler
+     */
+    bool Open(const std::string& filename, const Options& options = Options());
+
+    /**
+     * Unmap the file and release any fallback buffer
+     */
+    void Close();
+
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+    ByteSpan GetSpan() const { return ByteSpan(data_, size_); }
+
+    bool IsOpen() const { return data_ != nullptr; }
+
+    /**
+     * Check if contents are memory-mapped (false when read() fallback was used)
+     */
+    bool IsMapped() const { return mapped_; }
+
+private:
+    /**
+     * Map the file, platform specific
+     * @param openFailed Set if the file could not be opened at all (reported here)
+     * @return false if the file cannot be mapped
+     */
+    bool MapFile(const std::string& filename, const Options& options, bool& openFailed);
+
+    /**
+     * read() fallback: copy file contents into fallbackBuffer_
+     */
+    bool ReadFile(const std::string& filename);
+
+    void MoveFrom(MappedFile& other);
+
+    const uint8_t* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector<uint8_t> fallbackBuffer_;
+
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mappingHandle_;
+#endif
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Size-class free-list allocator
+ * Blocks up to MAX_BLOCK_SIZE are carved from 64 KB pages in power-of-two
+ * size classes. A freed block goes onto the free list of its class and the
+ * next allocation of that class pops it again, so steady-state use never
+ * touches the heap. Larger blocks go to the heap directly.
+ * Every block carries a 16-byte header with its size class and owning
+ * allocator, so Deallocate needs no size and blocks stay 16-byte aligned.
+ * Allocate from one thread only. Blocks may be freed from any thread: a
+ * block of another allocator is pushed onto that owner's lock-free remote
+ * list, which the owner drains when a free list runs dry.
+ */
+class FreeListAllocator {
+public:
+    static const size_t HEADER_SIZE = 16;
+    static const size_t MIN_BLOCK_SIZE = 16;
+    static const size_t MAX_BLOCK_SIZE = 4096;
+    static const size_t CLASS_COUNT = 9;            // 16, 32, ... 4096 bytes
+    static const size_t PAGE_SIZE = 64 * 1024;
+    static const size_t ALIGNMENT = 16;             // Of every returned block
+
+    FreeListAllocator();
+
+    /**
+     * Release all pages, blocks still in use become invalid
+     */
+    ~FreeListAllocator();
+
+    FreeListAllocator(const FreeListAllocator&) = delete;
+    FreeListAllocator& operator=(const FreeListAllocator&) = delete;
+
+    /**
+     * @return Block of at least size bytes, nullptr if out of memory
+     */
+    void* Allocate(size_t size);
+
+    /**
+     * Free a block (nullptr is ignored)
+     * Call on the allocator of the calling thread. A block of this
+     * allocator joins its free list; a block of another allocator is handed
+     * back to that allocator instead.
+     */
+    void Deallocate(void* block);
+
+    /**
+     * Give up an allocator created with new whose thread is exiting
+     * It deletes itself now if none of its blocks is in use, otherwise when
+     * the last one is freed. The allocator must not be used afterwards.
+     */
+    void Retire();
+
+    /**
+     * Get bytes reserved in pages (blocks of the size classes, used or free)
+     */
+    size_t GetPageBytes() const { return pages_.size() * PAGE_SIZE; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static size_t GetSizeClass(size_t size);
+    static size_t GetClassSize(size_t sizeClass) { return MIN_BLOCK_SIZE << sizeClass; }
+
+    /**
+     * Cut a new block of a size class from the newest page, adding a page if needed
+     */
+    uint8_t* CarveBlock(size_t sizeClass);
+
+    /**
+     * Take a block freed on another thread (thread-safe)
+     */
+    void DeallocateRemote(void* block);
+
+    /**
+     * Move blocks freed on other threads onto the free lists
+     */
+    void DrainRemote();
+
+    FreeBlock* freeLists_[CLASS_COUNT];
+    std::vector<void*> pages_;
+    uint8_t* pageCursor_;           // Unused tail of the newest page
+    size_t pageRemaining_;
+    size_t liveBlocks_;             // Handed out minus freed on the owning thread
+    std::atomic<FreeBlock*> remoteFree_;
+    // Minus the blocks freed on other threads; Retire adds liveBlocks_, so
+    // from then on it is the number of blocks still in use
+    std::atomic<ptrdiff_t> retiredBalance_;
+};
+
+/**
+ * Bump arena for the temporaries of one parse
+ * Allocation is an aligned pointer bump in the current block and
+ * deallocation does nothing; Reset() rewinds to the first block in O(1)
+ * and keeps every block, so the next parse on the same arena allocates
+ * nothing from the heap until it outgrows the previous one. Blocks grow
+ * geometrically and are freed by Release() or the destructor. Blocks
+ * count against MemorySubsystem::ParseArena.
+ * Not thread-safe: one arena per parse.
+ */
+class ParseArena : public std::pmr::memory_resource {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ParseArena(size_t initialBlockSize = DEFAULT_BLOCK_SIZE);
+    ~ParseArena() override;
+
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    /**
+     * Forget every allocation, keeping the blocks for reuse
+     */
+    void Reset();
+
+    /**
+     * Forget every allocation and free the blocks
+     */
+    void Release();
+
+    /**
+     * Get bytes handed out since the last Reset, alignment padding included
+     */
+    size_t GetBytesUsed() const { return bytesUsed_; }
+
+    /**
+     * Get bytes held in blocks
+     */
+    size_t GetBytesReserved() const { return bytesReserved_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        uint8_t* data;
+        size_t size;
+    };
+
+    static const size_t BLOCK_ALIGNMENT = 64;
+
+    bool AdvanceBlock(size_t bytes, size_t alignment);
+
+    std::vector<Block> blocks_;
+    size_t current_;                // Index of the block being bumped
+    size_t offset_;                 // Used bytes of the current block
+    size_t initialBlockSize_;
+    size_t bytesUsed_;
+    size_t bytesReserved_;
+};
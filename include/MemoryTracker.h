@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+/**
+ * Owner of tracked memory
+ */
+enum class MemorySubsystem {
+    ParseArena,         // Arena blocks: fixed-size per-shape arrays
+    ConverterHeap,      // Converter temporaries that grow per chunk: streamed vertices and faces, weld and face sets
+    ChunkTable,         // Chunk index of the file being parsed
+    StreamWindow,       // Chunk bytes buffered by StreamingChunkReader
+    FileBuffers,        // Whole-file contents from AsyncFileLoader
+    ShapeData,          // Decoded shapes: vertex buffers, streams, quantised positions
+    SurfaceGenerator,
+    AnimationSystem,
+    LineProcessor,
+    Count
+};
+
+/**
+ * Bytes of one subsystem, or of all of them
+ */
+struct MemoryUsage {
+    size_t currentBytes;
+    size_t peakBytes;
+};
+
+/**
+ * Process-wide byte counters per subsystem
+ * Tracked allocators report every allocation and deallocation here, so
+ * the counters are the bytes actually requested from the heap, not a
+ * sizeof estimate. Thread-safe; the peaks are high-water marks since
+ * start-up or the last ResetPeaks().
+ */
+class MemoryTracker {
+public:
+    static const size_t SUBSYSTEM_COUNT = static_cast<size_t>(MemorySubsystem::Count);
+
+    static void OnAllocate(MemorySubsystem subsystem, size_t bytes);
+    static void OnDeallocate(MemorySubsystem subsystem, size_t bytes);
+
+    static MemoryUsage GetUsage(MemorySubsystem subsystem);
+
+    /**
+     * Get bytes of all subsystems together (the peak is of the sum, not a sum of peaks)
+     */
+    static MemoryUsage GetTotal();
+
+    /**
+     * Restart every peak at the current value
+     */
+    static void ResetPeaks();
+
+    static const char* GetName(MemorySubsystem subsystem);
+
+    /**
+     * Write one line per subsystem that has allocated anything, then the total
+     */
+    static void Print(std::ostream& out);
+
+    /**
+     * Heap resource that counts its bytes against a subsystem
+     * @return Resource living for the whole program
+     */
+    static std::pmr::memory_resource* GetResource(MemorySubsystem subsystem);
+};
+
+/**
+ * Standard allocator counting its bytes against a subsystem
+ * Stateless, so containers keep their size and stay swappable.
+ */
+template <typename T, MemorySubsystem Subsystem>
+struct TrackedAllocator {
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind { typedef TrackedAllocator<U, Subsystem> other; };
+
+    TrackedAllocator() {}
+
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Subsystem>&) {}
+
+    T* allocate(size_t count) {
+        T* memory = static_cast<T*>(::operator new(count * sizeof(T)));
+        MemoryTracker::OnAllocate(Subsystem, count * sizeof(T));
+        return memory;
+    }
+
+    void deallocate(T* memory, size_t count) {
+        MemoryTracker::OnDeallocate(Subsystem, count * sizeof(T));
+        ::operator delete(memory);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Subsystem>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const TrackedAllocator<U, Subsystem>&) const { return false; }
+};
+
+/**
+ * std::pmr resource counting the bytes it passes upstream against a subsystem
+ */
+class TrackedResource : public std::pmr::memory_resource {
+public:
+    explicit TrackedResource(MemorySubsystem subsystem,
+                             std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : subsystem_(subsystem), upstream_(upstream) {}
+
+    MemorySubsystem GetSubsystem() const { return subsystem_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* block, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    MemorySubsystem subsystem_;
+    std::pmr::memory_resource* upstream_;
+};
+
+/**
+ * Admission control against a hard memory limit
+ * Work declares what it expects to need before it starts. It is admitted
+ * while the tracked bytes plus the bytes declared by running work leave
+ * room for it; otherwise the caller waits for running work to release.
+ * Work is always admitted when nothing else holds a reservation, so one
+ * job larger than the limit still runs, alone. Buffers workers keep from
+ * job to job are left out, since each worker's next job reuses them.
+ */
+class MemoryBudget {
+public:
+    /**
+     * @param limitBytes Hard limit, 0 = unlimited (Acquire never waits)
+     */
+    explicit MemoryBudget(size_t limitBytes = 0);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * Block until bytes fit the limit, then reserve them
+     */
+    void Acquire(size_t bytes);
+
+    /**
+     * Return a reservation made by Acquire
+     */
+    void Release(size_t bytes);
+
+    /**
+     * Change the bytes a worker keeps for its next job (its ParseContext)
+     * They stay tracked, but Fits leaves them out: counting them as well
+     * would hold warm workers to one job at a time.
+     * @param previous What this worker reported last time, 0 at first
+     */
+    void UpdateRetained(size_t previous, size_t bytes);
+
+    size_t GetLimit() const { return limit_; }
+    bool IsLimited() const { return limit_ > 0; }
+
+    /**
+     * Number of Acquire calls that had to wait
+     */
+    size_t GetThrottleCount() const;
+
+private:
+    bool Fits(size_t bytes) const;
+
+    size_t limit_;
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    size_t reserved_;
+    size_t retained_;
+    size_t holders_;
+    size_t throttled_;
+};
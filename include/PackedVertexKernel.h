@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Packed and compressed vertex coordinate conversion
+ * Dot2 stores each coordinate as a signed 32-bit integer in tenths. The
+ * SIMD kernels byte-swap with pshufb, convert with cvtdq2ps and divide by
+ * 10 (a true divide, not a multiply by 0.1). Compressed FDot vertices are
+ * int16 triples expanded with a per-axis scale and offset, cDot vertices
+ * int16 triples in hundredths; both run eight vertices per step. Float
+ * payloads (uncompressed FDot, Dots) only need the pshufb byte swap. The
+ * dequantise helpers expand positions ShapeData keeps as fp16 with a
+ * per-shape scale and offset; int32 positions kept as Dot2 tenths go
+ * through the Dot2 conversion. Every SIMD kernel gives results
+ * bit-identical to the scalar loop. The kernel
+ * is picked once at runtime from the CPU features, the same way
+ * TagScanner picks its kernel.
+ */
+class PackedVertexKernel {
+public:
+    enum class Kernel {
+        Scalar,     // Portable loop
+        SSSE3,      // 128-bit vectors
+        AVX2        // 256-bit vectors
+    };
+
+    enum class ByteOrder {
+        BigEndian,      // Shipped Dot2 chunks
+        LittleEndian    // Data already swapped to host order
+    };
+
+    /**
+     * FDot compression parameter block (DecrunchDots)
+     * Stored as six little-endian floats: scale x/y/z, then offset x/y/z.
+     * Always little-endian, independent of the file's size-field order.
+     */
+    struct CompressionParams {
+        float scale[3];
+        float offset[3];
+    };
+
+    static const size_t COMPRESSION_PARAMS_SIZE = 24;
+    static const size_t COMPRESSED_VERTEX_SIZE = 6;
+    static const size_t INT32_VERTEX_SIZE = 12;
+    static const size_t HALF_VERTEX_SIZE = 6;
+
+    /**
+     * Bounds and validity gathered while decoding
+     * Collected block by block while each decoded block is still in cache,
+     * so asking for them costs no second pass over the vertices. Bounds
+     * cover valid vertices only; a vertex is invalid if any coordinate is
+     * NaN or infinite.
+     */
+    struct DecodeStats {
+        float min[3];
+        float max[3];
+        size_t validCount;
+        size_t invalidCount;
+        std::vector<uint64_t> invalidMask;     // Bit i of word i / 64 set for invalid vertex i
+
+        DecodeStats() { Reset(0); }
+
+        /**
+         * Clear bounds and size the mask for vertexCount vertices
+         */
+        void Reset(size_t vertexCount);
+
+        /**
+         * Add one vertex decoded outside the kernels
+         */
+        void AddVertex(size_t index, const float* position);
+
+        /**
+         * Fold in the stats of a sub-range decoded on its own
+         * @param part Stats of the sub-range, indices relative to its first vertex
+         * @param firstVertex Index of the sub-range's first vertex in this range
+         */
+        void Merge(const DecodeStats& part, size_t firstVertex);
+
+        bool IsInvalid(size_t index) const {
+            return index / 64 < invalidMask.size() && (invalidMask[index / 64] >> (index % 64)) & 1;
+        }
+
+        bool HasBounds() const { return validCount > 0; }
+
+        /**
+         * Get bounds as min x/y/z then max x/y/z (ShapeData::SetBoundingBox layout)
+         */
+        void GetBoundingBox(float minMax[6]) const;
+    };
+
+    /**
+     * Convert packed x/y/z triples to float vertices
+     * Only the first three floats of every output vertex are written.
+     * @param input vertexCount * 12 bytes of packed coordinates
+     * @param order Byte order of the packed integers
+     * @param output First output vertex
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @param vertexCount Number of vertices
+     * @param stats Optional, reset and filled in the same pass
+     */
+    static void ConvertVertices(const uint8_t* input, ByteOrder order,
+                                float* output, size_t outputStride, size_t vertexCount,
+                                DecodeStats* stats = nullptr);
+
+    /**
+     * Convert IEEE float x/y/z triples (uncompressed FDot, Dots) to float vertices
+     * Only the bytes are reordered, so the output is bit-identical to the
+     * input and non-finite coordinates pass through (stats flag them).
+     * @param input vertexCount * 12 bytes of float coordinates
+     * @param order Byte order of the stored floats
+     * @param output First output vertex
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @param vertexCount Number of vertices
+     * @param stats Optional, reset and filled in the same pass
+     */
+    static void ConvertFloatVertices(const uint8_t* input, ByteOrder order,
+                                     float* output, size_t outputStride, size_t vertexCount,
+                                     DecodeStats* stats = nullptr);
+
+    /**
+     * Read the 24-byte FDot parameter block
+     * @return false if a scale or offset is not finite
+     */
+    static bool ReadCompressionParams(const uint8_t* block, CompressionParams& params);
+
+    /**
+     * Expand compressed int16 x/y/z triples to float vertices
+     * position = offset + value * scale, per axis. Only the first three
+     * floats of every output vertex are written.
+     * @param params Parameters from ReadCompressionParams
+     * @param input vertexCount * 6 bytes of little-endian int16 triples
+     * @param output First output vertex
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @param vertexCount Number of vertices
+     * @param stats Optional, reset and filled in the same pass
+     */
+    static void DecompressVertices(const CompressionParams& params, const uint8_t* input,
+                                   float* output, size_t outputStride, size_t vertexCount,
+                                   DecodeStats* stats = nullptr);
+
+    /**
+     * Convert cDot int16 x/y/z triples (hundredths) to float vertices
+     * A component of -1 marks an unused axis and becomes 0. Only the first
+     * three floats of every output vertex are written.
+     * @param input vertexCount * 6 bytes of little-endian int16 triples
+     * @param output First output vertex
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @param vertexCount Number of vertices
+     * @param stats Optional, reset and filled in the same pass
+     */
+    static void ConvertShortVertices(const uint8_t* input, float* output, size_t outputStride, size_t vertexCount,
+                                     DecodeStats* stats = nullptr);
+
+    /**
+     * Expand half-float x/y/z triples to float vertices
+     * position = offset + value * scale. The AVX2 kernel converts with F16C
+     * when the CPU has it. Only the first three floats of every output
+     * vertex are written.
+     * @param input vertexCount * 6 bytes of little-endian IEEE fp16 triples
+     */
+    static void DequantizeHalfVertices(const CompressionParams& params, const uint8_t* input,
+                                       float* output, size_t outputStride, size_t vertexCount);
+
+    /**
+     * Convert between IEEE half and single precision
+     * FloatToHalf rounds to nearest even; values beyond the half range
+     * become infinity.
+     */
+    static float HalfToFloat(uint16_t half);
+    static uint16_t FloatToHalf(float value);
+
+    /**
+     * Get kernel selected by runtime CPU dispatch (or SetKernel override)
+     */
+    static Kernel GetKernel();
+
+    /**
+     * Override kernel selection, clamped to what the CPU supports
+     * Intended for benchmarking and for validating kernels against each other.
+     */
+    static void SetKernel(Kernel kernel);
+
+    static const char* GetKernelName(Kernel kernel);
+
+private:
+    /**
+     * Convert count contiguous coordinates (not vertices) into output
+     */
+    static void ConvertScalar(const uint8_t* input, ByteOrder order, float* output, size_t count);
+    static void ConvertSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count);
+    static void ConvertAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count);
+    static void ConvertFloatScalar(const uint8_t* input, ByteOrder order, float* output, size_t count);
+    static void ConvertFloatSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count);
+    static void ConvertFloatAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count);
+
+    /**
+     * Expand count contiguous vertices into tightly packed x/y/z output
+     */
+    static void DecompressScalar(const CompressionParams& params, const uint8_t* input, float* output, size_t count);
+    static void DecompressSSSE3(const CompressionParams& params, const uint8_t* input, float* output, size_t count);
+    static void DecompressAVX2(const CompressionParams& params, const uint8_t* input, float* output, size_t count);
+
+    /**
+     * Convert count contiguous cDot vertices into tightly packed x/y/z output
+     */
+    static void ConvertShortScalar(const uint8_t* input, float* output, size_t count);
+    static void ConvertShortSSSE3(const uint8_t* input, float* output, size_t count);
+    static void ConvertShortAVX2(const uint8_t* input, float* output, size_t count);
+
+    /**
+     * Expand count contiguous half-float vertices into tightly packed x/y/z output
+     */
+    static void DequantizeHalfScalar(const CompressionParams& params, const uint8_t* input, float* output, size_t count);
+    static void DequantizeHalfF16C(const CompressionParams& params, const uint8_t* input, float* output, size_t count);
+
+    /**
+     * Fold count tightly packed decoded vertices into stats
+     * @param firstVertex Index of the block's first vertex for the invalid mask
+     */
+    static void Accumulate(const float* block, size_t count, size_t firstVertex, DecodeStats& stats);
+    static void AccumulateScalar(const float* block, size_t count, size_t firstVertex, DecodeStats& stats);
+    static void AccumulateSSSE3(const float* block, size_t count, size_t firstVertex, DecodeStats& stats);
+    static void AccumulateAVX2(const float* block, size_t count, size_t firstVertex, DecodeStats& stats);
+};
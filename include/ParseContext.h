@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ChunkTable.h"
+#include "MemoryPool.h"
+#include "StreamingChunkReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SurfaceGenerator;
+
+/**
+ * Buffers of one parse, kept from file to file
+ * The arena, chunk table and streaming window keep the capacity of the
+ * largest file seen so far, and the surface generator is initialized
+ * once, so converting file after file allocates nothing once the buffers
+ * have grown to the working set. Begin() applies the trim policy to what
+ * the previous parse left behind, then rewinds.
+ * Not thread-safe: one context per worker thread.
+ */
+class ParseContext {
+public:
+    /**
+     * When retained buffers are freed instead of reused
+     */
+    struct TrimPolicy {
+        size_t maxRetainedBytes;    // Free everything once more than this is retained (0 = after every parse)
+        size_t decayInterval;       // Every N parses, free buffers more than twice the peak of those parses (0 = never)
+
+        TrimPolicy() : maxRetainedBytes(64 * 1024 * 1024), decayInterval(64) {}
+    };
+
+    explicit ParseContext(const TrimPolicy& policy = TrimPolicy());
+    ~ParseContext();
+
+    ParseContext(const ParseContext&) = delete;
+    ParseContext& operator=(const ParseContext&) = delete;
+
+    /**
+     * Start a parse: apply the trim policy, then rewind the arena and clear the table
+     * Everything allocated from the arena by the previous parse becomes invalid.
+     */
+    void Begin();
+
+    /**
+     * Free all retained buffers now
+     */
+    void Trim();
+
+    ParseArena& GetArena() { return arena_; }
+    std::pmr::memory_resource* GetResource() { return &arena_; }
+    ChunkTable& GetChunkTable() { return chunkTable_; }
+
+    /**
+     * Window for StreamingChunkReader::SetWindowBuffer
+     */
+    StreamWindowBuffer& GetStreamWindow() { return streamWindow_; }
+
+    /**
+     * Get the surface generator, initialized on first use or when the limits change
+     * Begin() resets it for the next parse instead of initializing it again.
+     */
+    SurfaceGenerator& GetSurfaceGenerator(int32_t maxTextures, int32_t maxSurfaces);
+
+    void SetTrimPolicy(const TrimPolicy& policy) { policy_ = policy; }
+    const TrimPolicy& GetTrimPolicy() const { return policy_; }
+
+    /**
+     * Get bytes held across parses (arena blocks, chunk table, stream window, surface tables)
+     */
+    size_t GetRetainedBytes() const;
+
+    size_t GetParseCount() const { return parseCount_; }
+    size_t GetTrimCount() const { return trimCount_; }
+
+private:
+    /**
+     * Get bytes the last parse actually used
+     */
+    size_t GetUsedBytes() const;
+
+    TrimPolicy policy_;
+    ParseArena arena_;
+    ChunkTable chunkTable_;
+    StreamWindowBuffer streamWindow_;
+    std::unique_ptr<SurfaceGenerator> surfaceGenerator_;    // Only once a parse has asked for it
+
+    size_t parseCount_;
+    size_t trimCount_;
+    size_t intervalPeak_;           // Largest GetUsedBytes() of the current decay interval
+};
@@ -11,7 +11,7 @@
 class PrimChunkProcessor : public ChunkProcessor {
 public:
     bool ProcessChunk(const ChunkHeader& header, 
-                     const uint8_t* data, 
+                     ByteSpan data, 
                      ShapeData& shape) override;
     
     ChunkType GetChunkType() const override { 
@@ -23,7 +23,13 @@ public:
     }
     
     bool ValidateChunkData(const ChunkHeader& header, 
-                          const uint8_t* data) const override;
+                          ByteSpan data) const override;
+    
+    /**
+     * PrimitiveProcessor updates the global primitive flag register
+     * (dword_9668EC), so Prim chunks are processed one at a time
+     */
+    bool SupportsConcurrentChunks() const override { return false; }
 
 private:
     /**
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "PackedVertexKernel.h"
+#include "VertexStreams.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * How ShapeData keeps vertex positions in memory
+ */
+enum class PositionEncoding {
+    Float32,    // Plain floats in the vertex format (default)
+    Int16,      // 6 bytes per vertex, offset + value * scale per axis
+    Int32,      // 12 bytes per vertex, offset + value * scale per axis
+    Float16     // 6 bytes per vertex, offset + half * scale per axis
+};
+
+/**
+ * Source grid integer positions are kept on instead of the bounds
+ */
+enum class PositionGrid {
+    None,       // Scale and offset from the bounds
+    Tenths,     // Dot2: value / 10, offset 0
+    Hundredths  // cDot: value / 100, offset 0
+};
+
+/**
+ * Vertex positions stored quantised with a per-shape scale and offset
+ * When every coordinate is a whole number of tenths (Dot2) or hundredths
+ * (cDot) that fits the integer range, int16 and int32 keep those integers
+ * with offset 0 and decode them with the parser's own divide, so the
+ * positions come back bit-identical. Otherwise the offset is the centre
+ * of the bounds and the scale maps the largest half-extent onto the
+ * integer range, so the error per axis is at most half a step
+ * (scale / 2) plus the float rounding of offset + value * scale. fp16
+ * keeps positions relative to the centre with scale 1 and needs a
+ * half-extent below 65504; the error is half an fp16 ulp of the relative
+ * value. int32 saves no memory over floats and only pays off when the
+ * exact source values matter.
+ */
+class QuantizedPositions {
+public:
+    QuantizedPositions() : encoding_(PositionEncoding::Float32), grid_(PositionGrid::None), count_(0) { params_ = IdentityParams(); }
+
+    /**
+     * Quantise positions, replacing the contents
+     * @param x, y, z Position attributes of the same length
+     * @param encoding Int16, Int32 or Float16
+     * @return false if a coordinate is not finite or the encoding is Float32
+     */
+    bool Encode(ConstAttributeSpan x, ConstAttributeSpan y, ConstAttributeSpan z, PositionEncoding encoding);
+
+    /**
+     * Remove all positions and return to Float32
+     * @param keepCapacity Keep the storage for reuse (pooled shapes)
+     */
+    void Clear(bool keepCapacity = false);
+
+    PositionEncoding GetEncoding() const { return encoding_; }
+    PositionGrid GetGrid() const { return grid_; }
+    size_t GetCount() const { return count_; }
+    bool IsEmpty() const { return count_ == 0; }
+
+    /**
+     * Get scale and offset, position = offset + value * scale per axis
+     * On a source grid the scale is 0.1 or 0.01 and decoding divides by 10
+     * or 100 instead of multiplying.
+     */
+    const PackedVertexKernel::CompressionParams& GetParams() const { return params_; }
+
+    /**
+     * Get one dequantised position
+     */
+    void GetPosition(size_t index, float position[3]) const;
+
+    /**
+     * Bulk-dequantise a range of positions with the SIMD kernels
+     * @param output First output vertex, x/y/z written at its first three floats
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @return Number of vertices written (clamped to the stored count)
+     */
+    size_t Decode(size_t first, size_t count, float* output, size_t outputStride) const;
+
+    size_t GetVertexSize() const { return GetVertexSize(encoding_); }
+    static size_t GetVertexSize(PositionEncoding encoding);
+
+    size_t GetByteCount() const { return data_.size(); }
+
+private:
+    static PackedVertexKernel::CompressionParams IdentityParams();
+
+    /**
+     * Check that every coordinate is a whole number of grid steps that
+     * fits the encoding and decodes back bit for bit
+     */
+    static bool FitsGrid(const ConstAttributeSpan axes[3], PositionGrid grid, PositionEncoding encoding);
+
+    /**
+     * Dequantise one coordinate, the scalar form of the bulk kernels
+     */
+    float DecodeValue(const uint8_t* vertex, int axis) const;
+
+    PositionEncoding encoding_;
+    PositionGrid grid_;
+    PackedVertexKernel::CompressionParams params_;
+    std::vector<uint8_t, TrackedAllocator<uint8_t, MemorySubsystem::ShapeData>> data_;    // Little-endian x/y/z per vertex
+    size_t count_;
+};
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "ByteSpan.h"
+#include "ChunkHeader.h"
+#include "VertexStreams.h"
+#include "QuantizedPositions.h"
+#include "MemoryTracker.h"
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <cstdint>
+#include <atomic>
+#include <functional>
+#include <mutex>
 
 // Forward declarations
 struct VertexData;
@@ -30,18 +39,63 @@ struct PrimitiveData {
     uint16_t flags;
 };
 
+/**
+ * Attribute streams of a shape that can be decoded on demand
+ */
+enum class ShapeStream {
+    Positions = 0,      // Dot2, FDot, Dots, cDot
+    Primitives,         // Prim
+    Surfaces,           // Line
+    Animation,          // soPF, FPos
+    Count
+};
+
 /**
  * Main container for 3D shape data
  * Based on validated RFC analysis of original ShapeData structure
  */
 class ShapeData {
+public:
+    /**
+     * Decoder for one deferred chunk, run on first access to its stream
+     * @param header Chunk header
+     * @param data Undecoded chunk payload (view into the parsed file)
+     * @param shape Shape to decode into
+     * @return true if decoding succeeded
+     */
+    typedef std::function<bool(const ChunkHeader& header, ByteSpan data, ShapeData& shape)> DeferredDecoder;
+
 private:
-    // Vertex Data (RFC validated: 8 floats per vertex)
-    std::vector<float> vertexBuffer_;       // Raw vertex coordinates
+    struct DeferredChunk {
+        ChunkHeader header;
+        ByteSpan data;
+        DeferredDecoder decoder;
+    };
+    
+    /**
+     * Pending chunks of one attribute stream, decoded once on first access
+     */
+    struct LazyStream {
+        std::vector<DeferredChunk> pending;
+        std::atomic<bool> decoded;      // Fast path once decoding has run
+        std::mutex mutex;               // Serialises the one-time decode
+        bool succeeded;
+        
+        LazyStream() : decoded(true), succeeded(true) {}
+    };
+    
+
+    // Vertex Data (laid out by vertexFormat_, RFC default 8 floats per vertex)
+    std::pmr::vector<float> vertexBuffer_;  // Interleaved vertices, decode target in SoA mode
+    VertexFormat vertexFormat_;             // Attributes present and their offsets
+    VertexStreams vertexStreams_;           // Per-attribute streams (SoA layout only)
+    VertexLayout vertexLayout_;             // Layout the decoded vertices are kept in
+    QuantizedPositions quantizedPositions_; // Positions while quantised (then absent from the format)
+    PositionEncoding positionEncoding_;     // Encoding decoded positions are kept in
     size_t vertexCount_;                    // Number of vertices
     
     // Primitive Data  
-    std::vector<uint16_t> primitiveBuffer_; // Primitive indices
+    std::pmr::vector<uint16_t> primitiveBuffer_; // Primitive indices
     size_t primitiveCount_;                 // Number of primitives
     
     // Surface Data (for complex rendering)
@@ -50,44 +104,175 @@ private:
     // Animation Data (soPF chunks)
     std::unique_ptr<AnimationData> animationData_;
     
+    // Deferred chunk views per attribute stream (mutable: decoded from const accessors)
+    mutable LazyStream streams_[static_cast<size_t>(ShapeStream::Count)];
+    
     // Shape metadata
-    uint32_t shapeFlags_;                   // Processing flags (bit 3 = Line-processed, bit 7 = animated)
+    std::atomic<uint32_t> shapeFlags_;      // Processing flags (bit 3 = Line-processed, bit 7 = animated)
     int16_t textureId_;                     // Primary texture ID
     float boundingBox_[6];                  // Min/Max XYZ coordinates
+    bool hasBoundingBox_;                   // Set by vertex decoders, false for an empty shape
     
     // Memory management
     bool isInitialized_;
     
+    bool QuantizePositions();
+    void RestorePositions();
+    void Clear(bool keepCapacity);
+    
 public:
-    ShapeData();
+    /**
+     * @param resource Memory for the vertex and primitive buffers, e.g. the
+     *                 ParseArena of the parse that fills the shape; must
+     *                 outlive the shape. The default heap resource counts
+     *                 against MemorySubsystem::ShapeData.
+     */
+    explicit ShapeData(std::pmr::memory_resource* resource = MemoryTracker::GetResource(MemorySubsystem::ShapeData));
     ~ShapeData();
     
+    std::pmr::memory_resource* GetMemoryResource() const { return vertexBuffer_.get_allocator().resource(); }
+    
+    ShapeData(const ShapeData&) = delete;
+    ShapeData& operator=(const ShapeData&) = delete;
+    
+    // Lazy Decoding
+    // Accessors of a stream decode its deferred chunks on first use; the
+    // chunk data passed to DeferChunk must stay valid until then. Streams
+    // are ordered as ShapeStream lists them: a decoder writes its own stream
+    // and may read earlier ones (primitives may read positions), never
+    // later ones. Every thread then locks streams in the same order.
+    
+    /**
+     * Keep a view onto an undecoded chunk instead of decoding it now
+     * Refused from a decoder of this shape unless stream is an earlier one.
+     * @param stream Attribute stream the chunk belongs to
+     * @param header Chunk header
+     * @param data Chunk payload, must outlive the deferred decode
+     * @param decoder Decoder run on first access to the stream
+     */
+    void DeferChunk(ShapeStream stream, const ChunkHeader& header, ByteSpan data, DeferredDecoder decoder);
+    
+    /**
+     * Decode pending chunks of a stream now (thread-safe, runs once)
+     * From a decoder of this shape: its own stream returns true at once (the
+     * decoder is filling it), an earlier stream is decoded first, and a
+     * later stream is refused and fails the decoder's stream.
+     * @return true if every chunk of the stream decoded successfully
+     */
+    bool DecodeStream(ShapeStream stream) const;
+    
+    /**
+     * Decode all pending streams
+     */
+    bool DecodeAll() const;
+    
+    bool IsStreamDecoded(ShapeStream stream) const;
+    
+    /**
+     * Get stream a chunk type decodes into
+     * @return Stream, or ShapeStream::Count for metadata chunks that are always decoded eagerly
+     */
+    static ShapeStream GetStreamForChunk(ChunkType type);
+    
     // Vertex Buffer Management
+    // Decoders always write the interleaved buffer, laid out by the vertex
+    // format. In SoA layout SetVertexCount then splits it into streams and
+    // releases it, so GetVertexBuffer is only meaningful in the interleaved
+    // layout.
+    
+    /**
+     * Allocate interleaved vertices in the current format
+     * One float past the last vertex is reserved for the RFC terminator.
+     */
     void AllocateVertexBuffer(size_t vertexCount);
-    float* GetVertexBuffer() { return vertexBuffer_.data(); }
-    const float* GetVertexBuffer() const { return vertexBuffer_.data(); }
-    void SetVertexCount(size_t count) { vertexCount_ = count; }
-    size_t GetVertexCount() const { return vertexCount_; }
+    float* GetVertexBuffer() { DecodeStream(ShapeStream::Positions); return vertexBuffer_.data(); }
+    const float* GetVertexBuffer() const { DecodeStream(ShapeStream::Positions); return vertexBuffer_.data(); }
+    void SetVertexCount(size_t count);
+    size_t GetVertexCount() const { DecodeStream(ShapeStream::Positions); return vertexCount_; }
+    
+    /**
+     * Choose the attributes vertices carry, converting any decoded vertices
+     * Chunk processors set this from what the chunk contains before
+     * allocating; attributes dropped by the new format are lost.
+     */
+    void SetVertexFormat(const VertexFormat& format);
+    const VertexFormat& GetVertexFormat() const { return vertexFormat_; }
+    
+    /**
+     * Choose how vertices are stored, converting any decoded vertices
+     * Set before decoding to avoid the conversion; the layout survives Reset.
+     */
+    void SetVertexLayout(VertexLayout layout);
+    VertexLayout GetVertexLayout() const { return vertexLayout_; }
+    
+    /**
+     * Get one attribute of every vertex, independent of the layout
+     * Contiguous in the SoA layout, strided in the interleaved layout;
+     * empty if the vertex format lacks the attribute.
+     */
+    AttributeSpan GetAttribute(VertexAttribute attribute);
+    ConstAttributeSpan GetAttribute(VertexAttribute attribute) const;
+    
+    // Position Encoding
+    // Quantised positions leave the vertex format (X/Y/Z have no attribute
+    // span) and are read through GetPosition/DecodePositions instead; the
+    // other attributes stay in the buffer or streams as floats.
+    
+    /**
+     * Choose how positions are kept, converting any decoded positions
+     * Set before decoding and the positions are quantised once the decode
+     * has finished (SetVertexCount), from the float buffer the decoder
+     * filled: the integer scales need the bounds of the whole shape, so the
+     * float peak during decoding is unchanged. The encoding survives Reset.
+     * Changing between quantised encodings re-quantises the dequantised
+     * positions.
+     * @return false if the positions cannot be encoded (non-finite, or out
+     *         of the fp16 range); they then stay float
+     */
+    bool SetPositionEncoding(PositionEncoding encoding);
+    PositionEncoding GetPositionEncoding() const { return positionEncoding_; }
+    bool IsPositionQuantized() const { DecodeStream(ShapeStream::Positions); return quantizedPositions_.GetEncoding() != PositionEncoding::Float32; }
+    const QuantizedPositions& GetQuantizedPositions() const { DecodeStream(ShapeStream::Positions); return quantizedPositions_; }
+    
+    /**
+     * Get one position, dequantised on the fly if needed
+     */
+    void GetPosition(size_t index, float position[3]) const;
+    
+    /**
+     * Copy a range of positions as floats, whatever the encoding and layout
+     * @param output First output vertex, x/y/z written at its first three floats
+     * @param outputStride Distance between output vertices in floats (>= 3)
+     * @return Number of vertices written (clamped to the vertex count)
+     */
+    size_t DecodePositions(size_t first, size_t count, float* output, size_t outputStride) const;
+    
+    /**
+     * Get bytes held by decoded vertices (buffer, streams and quantised positions)
+     */
+    size_t GetVertexByteCount() const;
     
     // Primitive Buffer Management  
     void AllocatePrimitiveBuffer(size_t primitiveCount);
-    uint16_t* GetPrimitiveBuffer() { return primitiveBuffer_.data(); }
-    const uint16_t* GetPrimitiveBuffer() const { return primitiveBuffer_.data(); }
+    uint16_t* GetPrimitiveBuffer() { DecodeStream(ShapeStream::Primitives); return primitiveBuffer_.data(); }
+    const uint16_t* GetPrimitiveBuffer() const { DecodeStream(ShapeStream::Primitives); return primitiveBuffer_.data(); }
     void SetPrimitiveCount(size_t count) { primitiveCount_ = count; }
-    size_t GetPrimitiveCount() const { return primitiveCount_; }
+    size_t GetPrimitiveCount() const { DecodeStream(ShapeStream::Primitives); return primitiveCount_; }
     
     // Surface Management
     void AddSurface(std::unique_ptr<SurfaceData> surface);
-    size_t GetSurfaceCount() const { return surfaces_.size(); }
+    size_t GetSurfaceCount() const { DecodeStream(ShapeStream::Surfaces); return surfaces_.size(); }
     const SurfaceData* GetSurface(size_t index) const;
     
     // Animation System
     void SetAnimationData(std::unique_ptr<AnimationData> animData);
-    const AnimationData* GetAnimationData() const { return animationData_.get(); }
-    bool HasAnimation() const { return animationData_ != nullptr; }
+    const AnimationData* GetAnimationData() const { DecodeStream(ShapeStream::Animation); return animationData_.get(); }
+    bool HasAnimation() const { DecodeStream(ShapeStream::Animation); return animationData_ != nullptr; }
     
     // Shape Properties
+    // Flags set by decoders (Prim/Line processed, animated) appear once their stream is decoded
     void SetShapeFlags(uint32_t flags) { shapeFlags_ = flags; }
+    void AddShapeFlags(uint32_t flags) { shapeFlags_.fetch_or(flags); }
     uint32_t GetShapeFlags() const { return shapeFlags_; }
     bool IsLineProcessed() const { return (shapeFlags_ & 0x08) != 0; }  // RFC validated bit 3
     bool IsAnimated() const { return (shapeFlags_ & 0x80) != 0; }       // RFC validated bit 7
@@ -95,13 +280,37 @@ public:
     void SetTextureId(int16_t id) { textureId_ = id; }
     int16_t GetTextureId() const { return textureId_; }
     
+    /**
+     * Set bounds of the decoded vertices
+     * Vertex processors fill this from the decode pass itself; merged
+     * slices grow it to cover every vertex chunk.
+     * @param minMax Min x/y/z followed by max x/y/z
+     */
     void SetBoundingBox(const float minMax[6]);
-    const float* GetBoundingBox() const { return boundingBox_; }
+    const float* GetBoundingBox() const { DecodeStream(ShapeStream::Positions); return boundingBox_; }
+    bool HasBoundingBox() const { DecodeStream(ShapeStream::Positions); return hasBoundingBox_; }
+    
+    /**
+     * Append the output of one chunk processed into its own slice
+     * Vertices, primitives and surfaces are appended; primitive indices
+     * are rebased onto the vertices of the vertex chunk they refer to.
+     * @param slice Shape filled by a single chunk processor (consumed)
+     * @param vertexBase First vertex of the slice's vertex chunk in this shape
+     * @return false if a rebased index does not fit the 16-bit primitive buffer
+     */
+    bool MergeSlice(ShapeData& slice, size_t vertexBase);
     
     // Validation
     bool IsValid() const;
     void Reset();
     
+    /**
+     * Return to the state of a new shape but keep buffer capacity
+     * Unlike Reset, layout and position encoding go back to their defaults.
+     * Used by ShapeDataPool so a recycled shape refills without allocating.
+     */
+    void Recycle();
+    
     // Debug output
     void PrintDebugInfo() const;
     
@@ -110,7 +319,7 @@ public:
     uint32_t primitiveCount = 0;
     uint32_t surfaceCount = 0;
     uint32_t animationFrameCount = 0;
-    uint32_t vertexStride = 8;  // RFC validated: 8 floats per vertex
+    uint32_t vertexStride = 8;  // Floats per vertex, kept in step with SetVertexFormat (Legacy: 8)
     bool hasAnimation = false;
     
     // Raw data pointers for OBJ export
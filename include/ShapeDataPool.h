@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ShapeData.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/**
+ * Pool of recycled ShapeData objects
+ * For callers that load and discard shapes in a loop: a released shape is
+ * recycled (ShapeData::Recycle keeps its buffer capacity) and handed out
+ * again by the next Acquire, so once the pool is warm a load allocates
+ * nothing for the shape itself. Thread-safe; the pool must outlive every
+ * handle it hands out.
+ */
+class ShapeDataPool {
+public:
+    /**
+     * Deleter of a pooled shape: returns it to its pool
+     */
+    struct Releaser {
+        ShapeDataPool* pool = nullptr;
+
+        void operator()(ShapeData* shape) const;
+    };
+
+    typedef std::unique_ptr<ShapeData, Releaser> Handle;
+
+    /**
+     * @param maxPooled Idle shapes kept, further released shapes are destroyed
+     * @param resource Memory resource of the pooled shapes' buffers
+     */
+    explicit ShapeDataPool(size_t maxPooled = 16,
+                           std::pmr::memory_resource* resource = MemoryTracker::GetResource(MemorySubsystem::ShapeData));
+
+    ShapeDataPool(const ShapeDataPool&) = delete;
+    ShapeDataPool& operator=(const ShapeDataPool&) = delete;
+
+    /**
+     * Get an empty shape, recycled if one is idle
+     * @return Handle that returns the shape to the pool when reset or destroyed
+     */
+    Handle Acquire();
+
+    /**
+     * Destroy idle shapes until at most keep are left
+     */
+    void Trim(size_t keep = 0);
+
+    size_t GetIdleCount() const;
+
+    /**
+     * Number of Acquire calls served by an idle shape instead of a new one
+     */
+    size_t GetReuseCount() const;
+
+private:
+    void Release(ShapeData* shape);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ShapeData>> idle_;
+    size_t maxPooled_;
+    std::pmr::memory_resource* resource_;
+    size_t reuseCount_;
+};
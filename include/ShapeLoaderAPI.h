@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 
 // Legacy API compatibility header
@@ -20,7 +21,9 @@ namespace Conversion {
 }
 
 namespace Memory {
-    // Memory management placeholder functions
+    // Size-class free-list allocator (MemoryPool.h), one cache per thread;
+    // blocks are 16-byte aligned and may be freed from any thread, and a
+    // thread's cache is released once it has exited and its blocks are freed
     void* AllocateFromFreeList(size_t size);
     void DeallocateToFreeList(void* ptr);
 }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ByteSource.h"
+#include "ChunkHeader.h"
+#include "ChunkTable.h"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * Bytes of the chunk being streamed, counted as MemorySubsystem::StreamWindow
+ */
+typedef std::vector<uint8_t, TrackedAllocator<uint8_t, MemorySubsystem::StreamWindow>> StreamWindowBuffer;
+
+/**
+ * Bounded-memory chunk reader over a pull-based byte source
+ * Reads one chunk header, then that chunk's payload, into a fixed-size
+ * window and hands it to the handler registered for its type before the
+ * next chunk is read. Chunks without a handler are skipped without being
+ * buffered, so memory use is bounded by the largest handled chunk.
+ */
+class StreamingChunkReader {
+public:
+    /**
+     * Called for each completed chunk
+     * @param header Parsed chunk header
+     * @param chunk Chunk bytes starting at the tag (tag + size field + payload),
+     *              only valid until the handler returns
+     * @param streamOffset Offset of the tag in the input stream
+     * @return false to stop reading
+     */
+    typedef std::function<bool(const ChunkHeader& header, ByteSpan chunk, size_t streamOffset)> ChunkHandler;
+
+    static const size_t DEFAULT_WINDOW_SIZE = 4 * 1024 * 1024;
+
+    explicit StreamingChunkReader(size_t windowSize = DEFAULT_WINDOW_SIZE);
+
+    StreamingChunkReader(const StreamingChunkReader&) = delete;
+    StreamingChunkReader& operator=(const StreamingChunkReader&) = delete;
+
+    /**
+     * Buffer chunks in an external window (e.g. a ParseContext's), so its
+     * capacity outlives the reader; nullptr returns to the reader's own
+     */
+    void SetWindowBuffer(StreamWindowBuffer* buffer) { window_ = buffer ? buffer : &ownWindow_; }
+
+    /**
+     * Register handler for a chunk type (replaces previous handler)
+     */
+    void SetHandler(ChunkType type, ChunkHandler handler);
+
+    /**
+     * Force byte order of chunk size fields instead of detecting it on the first chunk
+     */
+    void SetSizeByteOrder(ChunkTable::SizeByteOrder order);
+
+    /**
+     * Read chunks until "End ", end of input or an error
+     * @param source Input stream
+     * @return true if the stream was consumed without errors
+     */
+    bool Run(ByteSource& source);
+
+    size_t GetWindowSize() const { return windowSize_; }
+    size_t GetBytesRead() const { return bytesRead_; }
+    size_t GetChunksDelivered() const { return chunksDelivered_; }
+    size_t GetChunksSkipped() const { return chunksSkipped_; }
+
+    /**
+     * Largest number of bytes held in the window at once
+     */
+    size_t GetPeakBuffered() const { return peakBuffered_; }
+
+    /**
+     * Size of the handled chunk that did not fit the window and stopped Run, 0 if none
+     */
+    size_t GetOversizeChunkBytes() const { return oversizeChunkBytes_; }
+
+private:
+    /**
+     * Read exactly count bytes
+     * @return false on premature end of input
+     */
+    bool ReadExact(ByteSource& source, uint8_t* buffer, size_t count);
+
+    /**
+     * Discard count bytes without buffering them
+     */
+    bool Skip(ByteSource& source, size_t count);
+
+    /**
+     * Choose size byte order from the first chunk header
+     * Big-endian unless only the little-endian reading fits the window
+     */
+    void DetectSizeByteOrder(const uint8_t* sizeField);
+
+    uint32_t ReadSize(const uint8_t* sizeField) const;
+
+    size_t windowSize_;
+    StreamWindowBuffer ownWindow_;
+    StreamWindowBuffer* window_;              // ownWindow_ or the buffer given to SetWindowBuffer
+    std::map<ChunkType, ChunkHandler> handlers_;
+
+    ChunkTable::SizeByteOrder sizeOrder_;
+    bool sizeOrderForced_;
+    bool sizeOrderKnown_;
+
+    size_t bytesRead_;
+    size_t chunksDelivered_;
+    size_t chunksSkipped_;
+    size_t peakBuffered_;
+    size_t oversizeChunkBytes_;
+};
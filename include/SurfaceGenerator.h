@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SurfaceData.h"
+#include "MemoryTracker.h"
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -11,10 +12,13 @@
  */
 class SurfaceGenerator {
 private:
+    template <typename T>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, MemorySubsystem::SurfaceGenerator>>;
+    
     // RFC VALIDATED: Hash table system globals
-    std::vector<int32_t> textureHashTable_;       // dword_96C1E8: texture_id → first_hash_entry  
-    std::vector<SurfaceHashEntry> hashCollisionData_; // dword_96C1F0: collision chain (16 bytes/entry)
-    std::vector<SurfaceTableEntry> surfaceTable_;     // Surface info storage (8 bytes/entry)
+    TrackedVector<int32_t> textureHashTable_;       // dword_96C1E8: texture_id → first_hash_entry  
+    TrackedVector<SurfaceHashEntry> hashCollisionData_; // dword_96C1F0: collision chain (16 bytes/entry)
+    TrackedVector<SurfaceTableEntry> surfaceTable_;     // Surface info storage (8 bytes/entry)
     
     // System limits and state
     int32_t maxTextures_;                          // Maximum texture ID bound
@@ -42,6 +46,18 @@ public:
      */
     void Cleanup();
     
+    /**
+     * Forget every surface but keep the tables, for the next parse
+     * Only the entries the last parse handed out are cleared, so this is
+     * far cheaper than Cleanup() and Initialize().
+     */
+    void Reset();
+    
+    /**
+     * Get bytes held by the hash and surface tables
+     */
+    size_t GetTableBytes() const;
+    
     /**
      * RFC VALIDATED: GetSurfaceHash function implementation
      * From GetSurfaceHash.cpp lines 20-36
@@ -97,7 +113,7 @@ public:
         uint16_t allocatedHashEntries; 
         int32_t maxTextures;
         int32_t maxSurfaces;
-        size_t memoryUsed;
+        size_t memoryUsed;          // This generator's tables (GetTableBytes); all generators: MemoryTracker::GetUsage
     };
     
     Statistics GetStatistics() const;
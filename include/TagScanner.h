@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Chunk tag scanner for resynchronising on headerless or damaged files
+ * Searches for all known 4-byte chunk tags in a single pass. The SIMD
+ * kernels filter candidate offsets 16/32 bytes at a time; every candidate
+ * is confirmed with a full tag compare before it is reported. Callers
+ * still have to check the candidate's size field, payload bytes can
+ * spell a tag by accident.
+ */
+class TagScanner {
+public:
+    enum class Kernel {
+        Scalar,     // Portable byte loop
+        SSE2,       // 16 offsets per step, first/second byte filter
+        AVX2        // 32 offsets per step, nibble filter on all four bytes
+    };
+
+    /**
+     * Find next offset at which a known chunk tag starts
+     * @param data Buffer to scan
+     * @param size Buffer size
+     * @param offset First offset to test
+     * @return Offset of the tag, or size if no tag was found
+     */
+    static size_t FindNextTag(const uint8_t* data, size_t size, size_t offset);
+
+    /**
+     * Get kernel selected by runtime CPU dispatch (or SetKernel override)
+     */
+    static Kernel GetKernel();
+
+    /**
+     * Override kernel selection, clamped to what the CPU and the tag set support
+     * Intended for benchmarking and for validating kernels against each other.
+     */
+    static void SetKernel(Kernel kernel);
+
+    static const char* GetKernelName(Kernel kernel);
+
+private:
+    static size_t FindNextTagScalar(const uint8_t* data, size_t size, size_t offset);
+    static size_t FindNextTagSSE2(const uint8_t* data, size_t size, size_t offset);
+    static size_t FindNextTagAVX2(const uint8_t* data, size_t size, size_t offset);
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed-size work-stealing thread pool
+ * Every worker owns a task queue. Tasks submitted from outside the pool are
+ * dealt round-robin across the queues, tasks submitted by a worker go to its
+ * own queue. A worker whose queue runs dry steals from the others instead of
+ * sleeping, so one long task cannot strand work queued behind it.
+ * Queues are taken from the front by both owner and thief: tasks start in
+ * submission order, and callers that submit largest-first (batch conversion)
+ * keep that order even when work moves between workers.
+ * Submit returns a future so callers can wait for a group of tasks (one
+ * processing stage) before starting the next.
+ */
+class ThreadPool {
+public:
+    /**
+     * Start worker threads
+     * @param threadCount Number of workers, 0 = one per hardware thread
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * Finish queued tasks and join all workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task
+     * @param task Callable without arguments
+     * @return Future for the task's result (exceptions are forwarded)
+     */
+    template<typename Func>
+    std::future<typename std::invoke_result<Func>::type> Submit(Func task) {
+        typedef typename std::invoke_result<Func>::type Result;
+
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packaged->get_future();
+
+        Enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers_.size()); }
+
+    /**
+     * Get index of the calling worker, for per-worker state such as parse buffers
+     * @param index Receives 0 .. GetThreadCount() - 1
+     * @return false if the caller is not one of this pool's workers
+     */
+    bool GetCurrentWorker(size_t& index) const;
+
+    /**
+     * Number of tasks a worker took from another worker's queue
+     */
+    size_t GetStolenCount() const { return stolen_.load(std::memory_order_relaxed); }
+
+    /**
+     * Get number of hardware threads (at least 1)
+     */
+    static unsigned GetDefaultThreadCount();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop(size_t index);
+
+    /**
+     * Take the oldest task from a queue
+     * @return false if the queue was empty
+     */
+    bool TryPop(size_t queueIndex, std::function<void()>& task);
+
+    /**
+     * Take a task from any queue other than the worker's own
+     */
+    bool TrySteal(size_t thiefIndex, std::function<void()>& task);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::atomic<size_t> nextQueue_;
+    std::atomic<size_t> stolen_;
+
+    // pending_ is only incremented under sleepMutex_, so a worker cannot miss
+    // the wakeup for a task queued while it was going idle
+    std::atomic<size_t> pending_;
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    bool stopping_;
+};
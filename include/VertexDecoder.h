@@ -0,0 +1,142 @@
+#pragma once
+
+#include "PackedVertexKernel.h"
+#include "ByteSwap.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Compile-time specialised vertex record decoders
+ * A chunk's vertex records are described by byte order, component type,
+ * component count and scale, all template arguments, so byte swap and
+ * scale are selected with if constexpr instead of per element. Record
+ * layouts with a SIMD kernel in PackedVertexKernel are routed to it;
+ * anything else gets a branch-free scalar loop. Dot2, FDot, Dots and cDot
+ * are instantiations below.
+ */
+namespace VertexDecoding {
+    
+    typedef PackedVertexKernel::ByteOrder ByteOrder;
+    
+    /**
+     * Scale policies: value as stored, value / Divisor, and value / Divisor
+     * with a marker value that stands for an unused axis (decoded as 0)
+     */
+    struct NoScale {
+        static const int DIVISOR = 1;
+        static const bool HAS_MARKER = false;
+        static const int MARKER = 0;
+    };
+    
+    template <int Divisor>
+    struct DivideBy {
+        static const int DIVISOR = Divisor;
+        static const bool HAS_MARKER = false;
+        static const int MARKER = 0;
+    };
+    
+    template <int Divisor, int Marker>
+    struct DivideByUnlessMarker {
+        static const int DIVISOR = Divisor;
+        static const bool HAS_MARKER = true;
+        static const int MARKER = Marker;
+    };
+    
+    /**
+     * Read one component in the given byte order
+     */
+    template <ByteOrder Order, typename Component>
+    inline Component ReadComponent(const uint8_t* data) {
+        static_assert(sizeof(Component) == 2 || sizeof(Component) == 4, "Components are 16 or 32 bits");
+        
+        Component value;
+        if constexpr (sizeof(Component) == 4) {
+            uint32_t bits = Order == ByteOrder::BigEndian ? ByteSwap::ReadBigEndian32(data)
+                                                          : ByteSwap::ReadLittleEndian32(data);
+            std::memcpy(&value, &bits, sizeof(value));
+        } else {
+            uint16_t bits = Order == ByteOrder::BigEndian ? ByteSwap::ReadBigEndian16(data)
+                                                          : ByteSwap::ReadLittleEndian16(data);
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+        return value;
+    }
+    
+    /**
+     * Apply a scale policy to one component
+     * Divides (not multiplies by the reciprocal) to match the SIMD kernels bit for bit.
+     */
+    template <typename Scale, typename Component>
+    inline float ApplyScale(Component value) {
+        if constexpr (Scale::HAS_MARKER) {
+            if (value == static_cast<Component>(Scale::MARKER)) {
+                return 0.0f;
+            }
+        }
+        if constexpr (Scale::DIVISOR == 1) {
+            return static_cast<float>(value);
+        } else {
+            return static_cast<float>(value) / static_cast<float>(Scale::DIVISOR);
+        }
+    }
+    
+    /**
+     * Decoder for records of Components values of type Component
+     */
+    template <ByteOrder Order, typename Component, size_t Components, typename Scale>
+    struct Decode {
+        static_assert(Components >= 1 && Components <= 4, "Records hold one to four components");
+        
+        static const size_t RECORD_SIZE = sizeof(Component) * Components;
+        
+        // Layouts with a SIMD kernel
+        static const bool IS_PACKED_INT32 = std::is_same<Component, int32_t>::value && Components == 3 &&
+                                            Scale::DIVISOR == 10 && !Scale::HAS_MARKER;
+        static const bool IS_FLOAT = std::is_same<Component, float>::value && Components == 3 &&
+                                     Scale::DIVISOR == 1 && !Scale::HAS_MARKER;
+        static const bool IS_SHORT_HUNDREDTHS = std::is_same<Component, int16_t>::value && Components == 3 &&
+                                                Order == ByteOrder::LittleEndian && Scale::DIVISOR == 100 &&
+                                                Scale::HAS_MARKER && Scale::MARKER == -1;
+        
+        /**
+         * Decode records into float vertices
+         * Only the first Components floats of every output vertex are written.
+         * @param input vertexCount * RECORD_SIZE bytes
+         * @param output First output vertex
+         * @param outputStride Distance between output vertices in floats (>= Components)
+         * @param vertexCount Number of vertices
+         * @param stats Optional bounds and invalid mask (three-component records only)
+         */
+        static void Run(const uint8_t* input, float* output, size_t outputStride, size_t vertexCount,
+                        PackedVertexKernel::DecodeStats* stats = nullptr) {
+            if constexpr (IS_PACKED_INT32) {
+                PackedVertexKernel::ConvertVertices(input, Order, output, outputStride, vertexCount, stats);
+            } else if constexpr (IS_FLOAT) {
+                PackedVertexKernel::ConvertFloatVertices(input, Order, output, outputStride, vertexCount, stats);
+            } else if constexpr (IS_SHORT_HUNDREDTHS) {
+                PackedVertexKernel::ConvertShortVertices(input, output, outputStride, vertexCount, stats);
+            } else {
+                if (stats) {
+                    stats->Reset(vertexCount);
+                }
+                for (size_t i = 0; i < vertexCount; i++, input += RECORD_SIZE, output += outputStride) {
+                    for (size_t c = 0; c < Components; c++) {
+                        output[c] = ApplyScale<Scale>(ReadComponent<Order, Component>(input + c * sizeof(Component)));
+                    }
+                    if constexpr (Components == 3) {
+                        if (stats) {
+                            stats->AddVertex(i, output);
+                        }
+                    }
+                }
+            }
+        }
+    };
+    
+    // Chunk record layouts
+    typedef Decode<ByteOrder::BigEndian, int32_t, 3, DivideBy<10>> Dot2;                         // int32 tenths
+    typedef Decode<ByteOrder::BigEndian, float, 3, NoScale> FloatDots;                            // Dots, uncompressed FDot
+    typedef Decode<ByteOrder::LittleEndian, int16_t, 3, DivideByUnlessMarker<100, -1>> CDot;      // int16 hundredths
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Per-vertex attributes of a shape
+ * The enumerator order is also the float order of the legacy 8-float
+ * vertex (the first eight floats of ShapeLoader::VertexData).
+ */
+enum class VertexAttribute {
+    X = 0, Y, Z,        // Position
+    NX, NY, NZ,         // Normal
+    U, V,               // Texture coordinates
+    Count
+};
+
+/**
+ * Storage type of one vertex attribute
+ */
+enum class AttributeType : uint8_t {
+    Float32
+};
+
+/**
+ * Description of the attributes an interleaved vertex buffer holds
+ * Chunk processors pick the format from what the file carries, so a
+ * position-only shape stores 3 floats per vertex instead of 8. Present
+ * attributes are packed in VertexAttribute order; offsets and stride are
+ * in bytes.
+ */
+class VertexFormat {
+public:
+    static const size_t ATTRIBUTE_COUNT = static_cast<size_t>(VertexAttribute::Count);
+
+    /**
+     * Empty format, add attributes with Add
+     */
+    VertexFormat();
+
+    /**
+     * RFC validated 8-float vertex: position, normal, texture coordinates
+     */
+    static VertexFormat Legacy();
+
+    /**
+     * Position only (Dot2, FDot, Dots, cDot without derived attributes)
+     */
+    static VertexFormat Positions();
+
+    /**
+     * Format holding every attribute of a and b, packed in attribute order
+     * Types are taken from a where both have the attribute.
+     */
+    static VertexFormat Union(const VertexFormat& a, const VertexFormat& b);
+
+    /**
+     * Add or remove an attribute, re-packing the present attributes in attribute order
+     */
+    VertexFormat& Add(VertexAttribute attribute, AttributeType type = AttributeType::Float32);
+    VertexFormat& Remove(VertexAttribute attribute);
+
+    bool Has(VertexAttribute attribute) const { return (presentMask_ >> static_cast<size_t>(attribute)) & 1; }
+    AttributeType GetType(VertexAttribute attribute) const { return types_[static_cast<size_t>(attribute)]; }
+
+    /**
+     * Get byte offset of an attribute inside the vertex (0 if absent)
+     */
+    size_t GetOffset(VertexAttribute attribute) const { return offsets_[static_cast<size_t>(attribute)]; }
+    size_t GetStride() const { return stride_; }
+
+    /**
+     * Offsets and stride in floats, valid while every attribute is Float32
+     */
+    size_t GetFloatOffset(VertexAttribute attribute) const { return GetOffset(attribute) / sizeof(float); }
+    size_t GetFloatStride() const { return stride_ / sizeof(float); }
+
+    size_t GetAttributeCount() const;
+    bool IsEmpty() const { return presentMask_ == 0; }
+
+    static size_t GetTypeSize(AttributeType type);
+
+    /**
+     * Copy vertices between interleaved formats
+     * Attributes missing from the input are written as 0; attributes
+     * missing from the output are dropped.
+     */
+    static void Convert(const float* input, const VertexFormat& inputFormat,
+                        float* output, const VertexFormat& outputFormat, size_t vertexCount);
+
+    bool operator==(const VertexFormat& other) const;
+    bool operator!=(const VertexFormat& other) const { return !(*this == other); }
+
+private:
+    void Pack();
+
+    uint32_t presentMask_;                      // Bit per VertexAttribute
+    AttributeType types_[ATTRIBUTE_COUNT];
+    uint16_t offsets_[ATTRIBUTE_COUNT];
+    uint16_t stride_;
+};
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "PackedVertexKernel.h"
+#include "ByteSpan.h"
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+class ThreadPool;
 
 /**
  * Vertex processing algorithms based on RFC validation
@@ -15,42 +20,101 @@ public:
         DecrunchDots          // DecrunchDots - compression → decompression
     };
     
+    static const size_t RFC_VERTEX_STRIDE = 8;    // Floats per vertex of the original layout
+    static const size_t TILE_OUTPUT_BYTES = 256 * 1024;   // Output written per batch tile (L2-sized)
+    
+    /**
+     * One decode of a batch: an algorithm applied to one input span
+     */
+    struct VertexJob {
+        Algorithm algorithm;
+        ByteSpan input;             // Algorithm input (DecrunchDots: parameter block first)
+        float* output;              // First output vertex
+        size_t outputSize;          // Floats available at output, including the terminator
+        size_t vertexCount;
+        size_t outputStride;        // Floats per output vertex, position first (>= 3)
+        bool gatherStats;           // Fill stats in the decode pass
+        
+        // Results
+        bool succeeded;
+        size_t tileCount;           // Tiles the job was split into (0 if it failed validation)
+        PackedVertexKernel::DecodeStats stats;
+        
+        VertexJob() 
+            : algorithm(Algorithm::PackedToFloat3Comp), output(nullptr), outputSize(0), vertexCount(0),
+              outputStride(RFC_VERTEX_STRIDE), gatherStats(false), succeeded(false), tileCount(0) {}
+    };
+    
     /**
      * Process vertex data using specified algorithm
      * @param algorithm Which processing algorithm to use
      * @param inputData Input vertex data
-     * @param outputBuffer Output buffer (8 floats per vertex)
+     * @param outputBuffer Output buffer, CalculateOutputSize floats plus the terminator
      * @param vertexCount Number of vertices to process
+     * @param outputStride Floats per output vertex, position first (>= 3)
      * @return true if processing succeeded
      */
     static bool ProcessVertices(Algorithm algorithm,
                                const uint8_t* inputData,
                                float* outputBuffer,
-                               size_t vertexCount);
+                               size_t vertexCount,
+                               size_t outputStride = RFC_VERTEX_STRIDE);
     
     /**
      * RFC VALIDATED: convertPackedToFloatVertices
      * Complex algorithm with backward references and advanced pointer arithmetic
+     * @param outputStride Floats per output vertex (RFC_VERTEX_STRIDE or a VertexFormat stride)
+     * @param stats Optional bounds and invalid mask, gathered in the same loop
      */
     static bool ConvertPackedToFloatVertices(const uint32_t* packedVertices,
                                             float* outputVertices,
-                                            size_t vertexCount);
+                                            size_t vertexCount,
+                                            size_t outputStride = RFC_VERTEX_STRIDE,
+                                            PackedVertexKernel::DecodeStats* stats = nullptr);
     
     /**
      * RFC VALIDATED: convertPackedToFloatVertices_3Component  
      * Sequential processing algorithm without backward references
+     * @param outputStride Floats per output vertex (RFC_VERTEX_STRIDE or a VertexFormat stride)
+     * @param stats Optional bounds and invalid mask, gathered in the same loop
      */
     static bool ConvertPackedToFloatVertices3Component(const uint32_t* packedVertices,
                                                       float* outputVertices,
-                                                      size_t vertexCount);
+                                                      size_t vertexCount,
+                                                      size_t outputStride = RFC_VERTEX_STRIDE,
+                                                      PackedVertexKernel::DecodeStats* stats = nullptr);
     
     /**
      * RFC VALIDATED: DecrunchDots decompression pipeline
-     * Decompresses vertex data with 6:32 expansion ratio
+     * Decompresses vertex data with 6:32 expansion ratio, applying the
+     * 24-byte parameter block as per-axis scale and offset
+     * @param outputStride Floats per output vertex, floats after the position are zeroed
+     * @param stats Optional bounds and invalid mask, gathered by the kernel
      */
     static bool DecrunchDotsVertices(const uint8_t* compressedData,
                                    float* outputVertices,
-                                   size_t vertexCount);
+                                   size_t vertexCount,
+                                   size_t outputStride = RFC_VERTEX_STRIDE,
+                                   PackedVertexKernel::DecodeStats* stats = nullptr);
+    
+    /**
+     * Decode a batch of vertex jobs
+     * Every job is validated once, then split into tiles of about
+     * TILE_OUTPUT_BYTES of output that run on the pool. Tiles of a job
+     * write disjoint vertex ranges; its terminator is written once after
+     * the last tile and its stats are merged in vertex order. Waits for
+     * the tiles; called from a task running on the same pool, it runs
+     * them on the calling thread instead of waiting on its own workers.
+     * @param jobs Jobs to run, status and stats are written back into them
+     * @param pool Pool to run tiles on, nullptr runs them on the calling thread
+     * @return true if every job succeeded
+     */
+    static bool ProcessBatch(std::vector<VertexJob>& jobs, ThreadPool* pool = nullptr);
+    
+    /**
+     * Get vertices per batch tile for an output stride (a multiple of 64)
+     */
+    static size_t GetTileVertexCount(size_t outputStride);
     
     /**
      * Calculate required input data size for algorithm
@@ -61,12 +125,13 @@ public:
     static size_t CalculateInputSize(Algorithm algorithm, size_t vertexCount);
     
     /**
-     * Calculate output buffer size (always 8 floats per vertex)
+     * Calculate output buffer size, excluding the terminator float
      * @param vertexCount Number of vertices
+     * @param outputStride Floats per vertex (RFC validated: 8)
      * @return Required output floats
      */
-    static size_t CalculateOutputSize(size_t vertexCount) {
-        return vertexCount * 8;  // RFC validated: 8 floats per vertex
+    static size_t CalculateOutputSize(size_t vertexCount, size_t outputStride = RFC_VERTEX_STRIDE) {
+        return vertexCount * outputStride;
     }
     
     /**
@@ -84,8 +149,17 @@ public:
     
 private:
     /**
-     * RFC VALIDATED: sub_4F2950 data rearrangement function
-     * Used by DecrunchDots algorithm
+     * Algorithm loops without validation or terminator, shared by the
+     * single-call entry points and the batch tiles
+     */
+    static void ConvertPackedRange(const uint32_t* packedVertices, float* outputVertices, size_t vertexCount,
+                                   size_t outputStride, PackedVertexKernel::DecodeStats* stats);
+    static void ConvertPacked3ComponentRange(const uint32_t* packedVertices, float* outputVertices, size_t vertexCount,
+                                             size_t outputStride, PackedVertexKernel::DecodeStats* stats);
+    
+    /**
+     * Decode vertices [first, first + count) of a validated batch job
      */
-    static void Sub4F2950Rearrangement(const uint32_t* input, uint32_t* output);
+    static void DecodeTile(const VertexJob& job, const PackedVertexKernel::CompressionParams& params,
+                           size_t first, size_t count, PackedVertexKernel::DecodeStats* stats);
 };
\ No newline at end of file
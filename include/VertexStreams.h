@@ -0,0 +1,138 @@
+#pragma once
+
+#include "VertexFormat.h"
+#include "MemoryTracker.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+/**
+ * How ShapeData stores its vertices
+ */
+enum class VertexLayout {
+    Interleaved,    // One buffer, vertices laid out by the shape's VertexFormat
+    SoA             // One aligned stream per attribute
+};
+
+/**
+ * Allocator returning memory aligned for full-width SIMD loads
+ * Bytes count against a MemoryTracker subsystem (vertex streams belong to ShapeData).
+ */
+template <typename T, size_t Alignment = 32, MemorySubsystem Subsystem = MemorySubsystem::ShapeData>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind { typedef AlignedAllocator<U, Alignment, Subsystem> other; };
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment, Subsystem>&) {}
+
+    T* allocate(size_t count) {
+        // aligned_alloc wants a size that is a multiple of the alignment
+        size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* memory = std::aligned_alloc(Alignment, bytes ? bytes : Alignment);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        MemoryTracker::OnAllocate(Subsystem, count * sizeof(T));
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, size_t count) {
+        MemoryTracker::OnDeallocate(Subsystem, count * sizeof(T));
+        std::free(memory);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment, Subsystem>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment, Subsystem>&) const { return false; }
+};
+
+typedef std::vector<float, AlignedAllocator<float>> AlignedFloatVector;
+
+/**
+ * View onto one attribute of a vertex array, whatever the layout
+ * Stride is the format's float stride for interleaved vertices and 1 for
+ * an SoA stream, so code written against the view reads either layout;
+ * code that wants the contiguous fast path checks IsContiguous().
+ */
+template <typename T>
+struct StridedSpan {
+    T* ptr;             // Attribute of the first vertex
+    size_t stride;      // Distance between vertices in elements
+    size_t length;      // Number of vertices
+
+    StridedSpan() : ptr(nullptr), stride(1), length(0) {}
+
+    StridedSpan(T* data, size_t elementStride, size_t count) : ptr(data), stride(elementStride), length(count) {}
+
+    T* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    bool IsContiguous() const { return stride == 1; }
+
+    T& operator[](size_t index) const { return ptr[index * stride]; }
+};
+
+typedef StridedSpan<float> AttributeSpan;
+typedef StridedSpan<const float> ConstAttributeSpan;
+
+/**
+ * Structure-of-arrays vertex storage
+ * One 32-byte aligned stream per attribute of the format, so kernels that
+ * only need positions read 12 bytes per vertex instead of a whole
+ * interleaved vertex. Attributes the format lacks have no stream.
+ */
+class VertexStreams {
+public:
+    static const size_t ATTRIBUTE_COUNT = VertexFormat::ATTRIBUTE_COUNT;
+
+    VertexStreams() : count_(0) {}
+
+    /**
+     * Resize the streams of the format's attributes, new vertices are zero
+     * Streams of attributes outside the format are released.
+     */
+    void Resize(size_t vertexCount, const VertexFormat& format);
+    /**
+     * Remove all vertices
+     * @param keepCapacity Keep the stream storage for reuse (pooled shapes)
+     */
+    void Clear(bool keepCapacity = false);
+
+    size_t GetCount() const { return count_; }
+    const VertexFormat& GetFormat() const { return format_; }
+
+    /**
+     * Get stream of an attribute, nullptr if the format lacks it
+     */
+    float* GetStream(VertexAttribute attribute);
+    const float* GetStream(VertexAttribute attribute) const;
+
+    /**
+     * Split interleaved vertices into the streams (replaces the contents)
+     * @param input First vertex, laid out as format describes
+     * @param format Format of the input, also the format of the streams
+     * @param vertexCount Number of vertices
+     */
+    void FromInterleaved(const float* input, const VertexFormat& format, size_t vertexCount);
+
+    /**
+     * Write the streams back as interleaved vertices
+     * Attributes of format without a stream are written as 0.
+     * @param output First output vertex, needs GetCount() * format.GetFloatStride() floats
+     */
+    void ToInterleaved(float* output, const VertexFormat& format) const;
+
+private:
+    AlignedFloatVector streams_[ATTRIBUTE_COUNT];
+    VertexFormat format_;
+    size_t count_;
+};
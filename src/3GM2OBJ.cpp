@@ -1,17 +1,27 @@
 #include "../include/3GMParser.h"
 #include "../include/OBJExporter.h"
 #include "../include/ErrorHandler.h"
+#include "../include/MappedFile.h"
+#include "../include/BatchFileList.h"
+#include "../include/ThreadPool.h"
+#include "../include/AsyncFileLoader.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <condition_variable>
 
 using namespace ShapeLoader;
 
 struct ProgramOptions {
     std::string inputFile;
     std::string outputPath;
+    std::string batchSpec;          // --batch: directory, wildcard pattern or @listfile
+    unsigned threadCount = 0;       // -j: batch worker threads, 0 = hardware threads
+    bool useIoUring = true;         // --no-uring: batch loads files with worker threads
     bool debugMode = false;
     bool verbose = false;
     bool includeNormals = true;
@@ -34,6 +44,7 @@ void ShowVersion() {
 void ShowHelp() {
     ShowVersion();
     std::cout << "Usage: 3GM2OBJ [options] input.3gm [output_path]" << std::endl;
+    std::cout << "       3GM2OBJ [options] --batch <dir|pattern|@list> [-o output_dir]" << std::endl;
     std::cout << std::endl;
     std::cout << "Arguments:" << std::endl;
     std::cout << "  input.3gm          Input 3GM file to convert" << std::endl;
@@ -44,7 +55,11 @@ void ShowHelp() {
     std::cout << "  -v, --version      Show version information" << std::endl;
     std::cout << "  -d, --debug        Enable debug mode with detailed chunk analysis" << std::endl;
     std::cout << "  --verbose          Enable verbose output" << std::endl;
-    std::cout << "  -o PATH            Specify output path" << std::endl;
+    std::cout << "  -o PATH            Specify output path (output directory with --batch)" << std::endl;
+    std::cout << "  --batch SPEC       Convert all .3GM files in a directory, files matching a" << std::endl;
+    std::cout << "                     pattern like 'shapes/*LOD*.3GM', or files listed in @list.txt" << std::endl;
+    std::cout << "  -j N               Batch worker threads (default: one per hardware thread)" << std::endl;
+    std::cout << "  --no-uring         Batch: load files with worker threads instead of io_uring" << std::endl;
     std::cout << std::endl;
     std::cout << "Export Options:" << std::endl;
     std::cout << "  --no-normals       Don't export vertex normals" << std::endl;
@@ -59,6 +74,7 @@ void ShowHelp() {
     std::cout << "  3GM2OBJ -o models/ship ship.3gm     # Convert to models/ship.obj" << std::endl;
     std::cout << "  3GM2OBJ -d --verbose ship.3gm       # Debug mode with detailed output" << std::endl;
     std::cout << "  3GM2OBJ --scale 0.1 ship.3gm        # Scale down by 10x" << std::endl;
+    std::cout << "  3GM2OBJ --batch shapes -j 8 -o out  # Convert a whole directory" << std::endl;
     std::cout << std::endl;
 }
 
@@ -83,6 +99,21 @@ bool ParseArguments(int argc, char* argv[], ProgramOptions& options) {
         else if (arg == "-o" && i + 1 < argc) {
             options.outputPath = argv[++i];
         }
+        else if (arg == "--batch" && i + 1 < argc) {
+            options.batchSpec = argv[++i];
+        }
+        else if (arg == "--no-uring") {
+            options.useIoUring = false;
+        }
+        else if (arg == "-j" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long count = std::strtoul(argv[++i], &end, 10);
+            if (count == 0 || count > 1024 || *end != '\0') {
+                std::cerr << "Error: Invalid thread count: " << argv[i] << std::endl;
+                return false;
+            }
+            options.threadCount = static_cast<unsigned>(count);
+        }
         else if (arg == "--no-normals") {
             options.includeNormals = false;
         }
@@ -137,6 +168,14 @@ bool ValidateOptions(const ProgramOptions& options) {
         return true;
     }
     
+    if (!options.batchSpec.empty()) {
+        if (!options.inputFile.empty()) {
+            std::cerr << "Error: --batch cannot be combined with an input file" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
     if (options.inputFile.empty()) {
         std::cerr << "Error: No input file specified" << std::endl;
         return false;
@@ -177,6 +216,192 @@ void PrintSummary(const ShapeData& shapeData, double parseTime, double exportTim
     std::cout << "   Total Time: " << std::fixed << std::setprecision(2) << (parseTime + exportTime) << "ms" << std::endl;
 }
 
+struct BatchFileResult {
+    bool success = false;
+    size_t vertexCount = 0;
+    size_t primitiveCount = 0;
+    double timeMs = 0.0;
+    std::string error;
+};
+
+OBJExporter::ExportOptions MakeExportOptions(const ProgramOptions& options) {
+    OBJExporter::ExportOptions exportOptions;
+    exportOptions.includeNormals = options.includeNormals;
+    exportOptions.includeTextureCoords = options.includeTextureCoords;
+    exportOptions.includeVertexColors = options.includeVertexColors;
+    exportOptions.generateMTL = options.generateMTL;
+    exportOptions.flipTextureY = options.flipTextureY;
+    exportOptions.scale = options.scale;
+    return exportOptions;
+}
+
+BatchFileResult ConvertBatchFile(const ProgramOptions& options, const LoadedFile& input, const std::string& outputPath) {
+    BatchFileResult result;
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    if (!input.success) {
+        result.error = "cannot open input file: " + input.error;
+    } else {
+        // Files already run in parallel, so each parse stays on its worker
+        Parser3GM parser;
+        parser.SetThreadCount(1);
+        
+        if (!parser.ParseBuffer(input.data.data(), input.data.size(), std::filesystem::path(input.path).filename().string())) {
+            result.error = "parse failed";
+        } else {
+            const ShapeData& shapeData = parser.GetShapeData();
+            OBJExporter exporter;
+            
+            if (!exporter.ExportToOBJ(shapeData, outputPath, MakeExportOptions(options))) {
+                result.error = "export failed";
+            } else {
+                result.success = true;
+                result.vertexCount = shapeData.vertexCount;
+                result.primitiveCount = shapeData.primitiveCount;
+            }
+        }
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    result.timeMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
+
+/**
+ * Convert every file of a batch spec in one process
+ * Files are submitted largest first to a work-stealing pool; idle workers
+ * take queued files from busy ones so the tail is shared across cores.
+ */
+int RunBatch(const ProgramOptions& options) {
+    std::vector<BatchFile> files;
+    if (!BatchFileList::Collect(options.batchSpec, files)) {
+        std::cerr << "Error: Cannot expand batch input: " << options.batchSpec << std::endl;
+        return 1;
+    }
+    if (files.empty()) {
+        std::cerr << "Error: No input files matched: " << options.batchSpec << std::endl;
+        return 1;
+    }
+    
+    if (!options.outputPath.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(options.outputPath, ec);
+        if (ec) {
+            std::cerr << "Error: Cannot create output directory: " << options.outputPath << std::endl;
+            return 1;
+        }
+    }
+    
+    std::vector<std::string> outputPaths;
+    std::map<std::string, std::string> outputOwners;
+    for (const auto& file : files) {
+        std::string outputPath = (std::filesystem::path(options.outputPath) / std::filesystem::path(file.path).stem()).string();
+        
+        auto owner = outputOwners.emplace(outputPath, file.path);
+        if (!owner.second) {
+            std::cerr << "Error: " << file.path << " and " << owner.first->second 
+                      << " would both write " << outputPath << ".obj" << std::endl;
+            return 1;
+        }
+        outputPaths.push_back(outputPath);
+    }
+    
+    unsigned threadCount = options.threadCount > 0 ? options.threadCount : ThreadPool::GetDefaultThreadCount();
+    if (threadCount > files.size()) {
+        threadCount = static_cast<unsigned>(files.size());
+    }
+    
+    AsyncFileLoader loader;
+    if (!options.useIoUring) {
+        loader.SetBackend(AsyncFileLoader::Backend::ThreadPool);
+    }
+    
+    std::cout << "🔄 Batch: " << files.size() << " file(s) on " << threadCount << " thread(s), "
+              << AsyncFileLoader::GetBackendName(loader.GetBackend()) << " input" << std::endl;
+    
+    std::vector<std::string> paths;
+    for (const auto& file : files) {
+        paths.push_back(file.path);
+    }
+    
+    std::vector<BatchFileResult> results(files.size());
+    std::mutex outputMutex;
+    size_t completed = 0;
+    auto batchStart = std::chrono::high_resolution_clock::now();
+    
+    {
+        // Loaded files waiting for a worker are capped to bound memory
+        const size_t maxQueued = static_cast<size_t>(threadCount) * 2;
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        size_t queued = 0;
+        
+        ThreadPool pool(threadCount);
+        std::vector<std::future<void>> pending;
+        pending.reserve(files.size());
+        
+        loader.LoadAll(paths, [&](LoadedFile& file) {
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueCondition.wait(lock, [&]() { return queued < maxQueued; });
+                queued++;
+            }
+            
+            auto input = std::make_shared<LoadedFile>(std::move(file));
+            size_t i = input->index;
+            pending.push_back(pool.Submit([&, i, input]() mutable {
+                results[i] = ConvertBatchFile(options, *input, outputPaths[i]);
+                input.reset();
+                
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    queued--;
+                    queueCondition.notify_one();
+                }
+                
+                std::lock_guard<std::mutex> lock(outputMutex);
+                completed++;
+                if (options.verbose) {
+                    std::cout << "[" << completed << "/" << files.size() << "] " 
+                              << (results[i].success ? "✅ " : "❌ ") << files[i].path << std::endl;
+                }
+            }));
+        });
+        
+        for (auto& task : pending) {
+            task.get();
+        }
+    }
+    
+    auto batchEnd = std::chrono::high_resolution_clock::now();
+    double wallTime = std::chrono::duration<double, std::milli>(batchEnd - batchStart).count();
+    
+    std::cout << std::endl;
+    std::cout << "📊 Batch Summary:" << std::endl;
+    
+    size_t failed = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        const BatchFileResult& result = results[i];
+        if (!result.success) {
+            failed++;
+        }
+        
+        std::cout << "   " << (result.success ? "✅ " : "❌ ") << files[i].path;
+        if (result.success) {
+            std::cout << " - " << result.vertexCount << " vertices, " << result.primitiveCount << " primitives";
+        } else {
+            std::cout << " - " << result.error;
+        }
+        std::cout << ", " << std::fixed << std::setprecision(2) << result.timeMs << "ms" << std::endl;
+    }
+    
+    std::cout << std::endl;
+    std::cout << "   Converted: " << (files.size() - failed) << "/" << files.size() << std::endl;
+    std::cout << "   Total Time: " << std::fixed << std::setprecision(2) << wallTime << "ms" << std::endl;
+    
+    return failed == 0 ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
     ProgramOptions options;
     
@@ -202,36 +427,34 @@ int main(int argc, char* argv[]) {
     // Initialize error handler
     ErrorHandler::SetVerbose(options.verbose);
     
+    if (!options.batchSpec.empty()) {
+        return RunBatch(options);
+    }
+    
     if (options.verbose) {
         ShowVersion();
         std::cout << "🔄 Processing: " << options.inputFile << std::endl;
         std::cout << std::endl;
     }
     
-    // Read input file
-    std::ifstream file(options.inputFile, std::ios::binary);
-    if (!file.is_open()) {
+    // Map input file (no copy; read() fallback for pipes and special files)
+    MappedFile input;
+    if (!input.Open(options.inputFile)) {
         std::cerr << "Error: Cannot open input file: " << options.inputFile << std::endl;
         return 1;
     }
     
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> data(fileSize);
-    file.read(reinterpret_cast<char*>(data.data()), fileSize);
-    file.close();
+    size_t fileSize = input.Size();
     
     if (options.verbose) {
-        std::cout << "📁 File Size: " << fileSize << " bytes" << std::endl;
+        std::cout << "📁 File Size: " << fileSize << " bytes" << (input.IsMapped() ? " (mapped)" : "") << std::endl;
     }
     
     // Parse 3GM file
     Parser3GM parser;
     
     auto parseStart = std::chrono::high_resolution_clock::now();
-    bool parseSuccess = parser.ParseBuffer(data.data(), fileSize, std::filesystem::path(options.inputFile).filename().string());
+    bool parseSuccess = parser.ParseBuffer(input.Data(), fileSize, std::filesystem::path(options.inputFile).filename().string());
     auto parseEnd = std::chrono::high_resolution_clock::now();
     
     double parseTime = std::chrono::duration<double, std::milli>(parseEnd - parseStart).count();
@@ -258,13 +481,7 @@ int main(int argc, char* argv[]) {
     
     // Export to OBJ
     OBJExporter exporter;
-    OBJExporter::ExportOptions exportOptions;
-    exportOptions.includeNormals = options.includeNormals;
-    exportOptions.includeTextureCoords = options.includeTextureCoords;
-    exportOptions.includeVertexColors = options.includeVertexColors;
-    exportOptions.generateMTL = options.generateMTL;
-    exportOptions.flipTextureY = options.flipTextureY;
-    exportOptions.scale = options.scale;
+    OBJExporter::ExportOptions exportOptions = MakeExportOptions(options);
     
     auto exportStart = std::chrono::high_resolution_clock::now();
     bool exportSuccess = exporter.ExportToOBJ(shapeData, outputPath, exportOptions);
@@ -1,5 +1,6 @@
 #include "Dot2Chunk.h"
 #include "ChunkHeader.h" 
+#include "ChunkValidator.h"
 #include "ShapeData.h"
 #include "VertexProcessor.h"
 #include "ErrorHandler.h"
@@ -12,7 +13,7 @@
  */
 
 bool Dot2ChunkProcessor::ProcessChunk(const ChunkHeader& header, 
-                                    const uint8_t* data, 
+                                    ByteSpan data, 
                                     ShapeData& shape) {
     if (!ValidateChunkData(header, data)) {
         return ErrorHandler::PostEvent(0x6A, "Invalid Dot2 chunk data");
@@ -30,20 +31,33 @@ bool Dot2ChunkProcessor::ProcessChunk(const ChunkHeader& header,
         return ErrorHandler::PostEvent(0x6A, "Invalid Dot2 vertex data size");
     }
     
-    size_t vertexCount = vertexDataSize / 12;
-    
     // Skip compression parameters (8 bytes) as validated in RFC
-    const uint32_t* packedVertices = reinterpret_cast<const uint32_t*>(data + 8);
+    ValidatedChunk records;
+    if (!ChunkValidator::ValidateRecords(header, data, ChunkRecordLayout(8, 12, vertexDataSize / 12), records)) {
+        return ErrorHandler::PostEvent(0x6A, "Dot2 vertex data exceeds chunk payload");
+    }
+    
+    size_t vertexCount = records.GetRecordCount();
+    const uint32_t* packedVertices = reinterpret_cast<const uint32_t*>(records.GetRecords());
     
-    // Allocate vertex buffer (8 floats per vertex as per RFC validation)
+    // Dot2 carries positions only, so the buffer holds 3 floats per vertex
+    shape.SetVertexFormat(VertexFormat::Positions());
     shape.AllocateVertexBuffer(vertexCount);
     float* outputVertices = shape.GetVertexBuffer();
     
     // RFC VALIDATED: Use convertPackedToFloatVertices algorithm
-    if (!VertexProcessor::ConvertPackedToFloatVertices(packedVertices, outputVertices, vertexCount)) {
+    PackedVertexKernel::DecodeStats stats;
+    if (!VertexProcessor::ConvertPackedToFloatVertices(packedVertices, outputVertices, vertexCount,
+                                                       shape.GetVertexFormat().GetFloatStride(), &stats)) {
         return ErrorHandler::PostEvent(0x6A, "Failed to process Dot2 vertices");
     }
     
+    if (stats.HasBounds()) {
+        float bounds[6];
+        stats.GetBoundingBox(bounds);
+        shape.SetBoundingBox(bounds);
+    }
+    
     shape.SetVertexCount(vertexCount);
     return true;
 }
@@ -89,8 +103,9 @@ bool Dot2ChunkProcessor::ProcessVertexData(const uint32_t* packedVertices,
 }
 
 bool Dot2ChunkProcessor::ValidateChunkData(const ChunkHeader& header, 
-                                          const uint8_t* data) const {
-    if (!data) {
+                                          ByteSpan data) const {
+    // Payload must be fully inside the view
+    if (!data.data() || data.size() < header.size) {
         return false;
     }
     
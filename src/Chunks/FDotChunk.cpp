@@ -1,5 +1,6 @@
 #include "FDotChunk.h"
 #include "ChunkHeader.h"
+#include "ChunkValidator.h"
 #include "ShapeData.h"
 #include "VertexProcessor.h"
 #include "ErrorHandler.h"
@@ -12,28 +13,40 @@
  */
 
 bool FDotChunkProcessor::ProcessChunk(const ChunkHeader& header, 
-                                     const uint8_t* data, 
+                                     ByteSpan data, 
                                      ShapeData& shape) {
-    if (!ValidateChunkData(header, data)) {
+    // RFC VALIDATED: Calculate vertex count
+    // FDot format: 24 bytes compression params + 6 bytes per vertex
+    // Validated once here, so DecrunchDots runs without per-vertex checks
+    ValidatedChunk records;
+    if (!ChunkValidator::ValidateChunk(*this, header, data, 
+                                       ChunkRecordLayout(24, 6, CalculateVertexCount(header.size)), records)) {
         return ErrorHandler::PostEvent(0x6A, "Invalid FDot chunk data");
     }
     
-    // RFC VALIDATED: Calculate vertex count
-    // FDot format: 24 bytes compression params + 6 bytes per vertex
-    size_t vertexCount = CalculateVertexCount(header.size);
+    size_t vertexCount = records.GetRecordCount();
     if (vertexCount == 0) {
         return ErrorHandler::PostEvent(0x6A, "No vertices in FDot chunk");
     }
     
-    // Allocate vertex buffer (8 floats per vertex as per RFC validation)
+    // FDot carries positions only, so the buffer holds 3 floats per vertex
+    shape.SetVertexFormat(VertexFormat::Positions());
     shape.AllocateVertexBuffer(vertexCount);
     float* outputVertices = shape.GetVertexBuffer();
     
     // RFC VALIDATED: Use DecrunchDots algorithm
-    if (!VertexProcessor::DecrunchDotsVertices(data, outputVertices, vertexCount)) {
+    PackedVertexKernel::DecodeStats stats;
+    if (!VertexProcessor::DecrunchDotsVertices(data.data(), outputVertices, vertexCount,
+                                               shape.GetVertexFormat().GetFloatStride(), &stats)) {
         return ErrorHandler::PostEvent(0x6A, "Failed to decompress FDot vertices");
     }
     
+    if (stats.HasBounds()) {
+        float bounds[6];
+        stats.GetBoundingBox(bounds);
+        shape.SetBoundingBox(bounds);
+    }
+    
     shape.SetVertexCount(vertexCount);
     return true;
 }
@@ -55,8 +68,9 @@ size_t FDotChunkProcessor::CalculateVertexCount(size_t chunkSize) const {
 }
 
 bool FDotChunkProcessor::ValidateChunkData(const ChunkHeader& header, 
-                                          const uint8_t* data) const {
-    if (!data) {
+                                          ByteSpan data) const {
+    // Payload must be fully inside the view
+    if (!data.data() || data.size() < header.size) {
         return false;
     }
     
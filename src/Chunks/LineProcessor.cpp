@@ -3,6 +3,7 @@
 #include "../../include_new/ByteSwap.h"
 #include "../../include_new/SurfaceGenerator.h"
 #include "../../include_new/GlobalVariables.h"
+#include "../../include_new/MemoryTracker.h"
 #include <iostream>
 #include <cstring>
 
@@ -330,6 +331,7 @@ bool LineProcessor::PrepareOutputBuffer(size_t estimatedSize) {
         }
         
         bufferSize_ = estimatedSize;
+        MemoryTracker::OnAllocate(MemorySubsystem::LineProcessor, bufferSize_);
     }
     
     // Clear buffer
@@ -346,6 +348,7 @@ bool LineProcessor::FinalizeOutput(LineProcessingState& state) {
 
 void LineProcessor::CleanupBuffers() {
     if (outputBuffer_) {
+        MemoryTracker::OnDeallocate(MemorySubsystem::LineProcessor, bufferSize_);
         delete[] outputBuffer_;
         outputBuffer_ = nullptr;
         bufferSize_ = 0;
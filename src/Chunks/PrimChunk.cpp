@@ -12,7 +12,7 @@
  */
 
 bool PrimChunkProcessor::ProcessChunk(const ChunkHeader& header, 
-                                     const uint8_t* data, 
+                                     ByteSpan data, 
                                      ShapeData& shape) {
     if (!ValidateChunkData(header, data)) {
         return ErrorHandler::PostEvent(0x6A, "Invalid Prim chunk data");
@@ -20,14 +20,14 @@ bool PrimChunkProcessor::ProcessChunk(const ChunkHeader& header,
     
     // RFC DIFFERENCE: Prim chunks use direct processing
     // Line chunks use 4-phase convertChunkedDataToSurfaces pipeline
-    if (!ParsePrimitiveData(data, header.size, shape)) {
+    if (!ParsePrimitiveData(data.data(), header.size, shape)) {
         return ErrorHandler::PostEvent(0x6A, "Failed to parse Prim chunk data");
     }
     
     // Set shape processing flag (NOT the Line-processed flag bit 3)
     // Prim chunks use different processing path
-    uint32_t currentFlags = shape.GetShapeFlags();
-    shape.SetShapeFlags(currentFlags | 0x04);  // Set bit 2 for Prim-processed
+    // Atomic OR: other streams of a lazily decoded shape may set flags concurrently
+    shape.AddShapeFlags(0x04);  // Set bit 2 for Prim-processed
     
     return true;
 }
@@ -46,8 +46,9 @@ bool PrimChunkProcessor::ParsePrimitiveData(const uint8_t* data, size_t size, Sh
 }
 
 bool PrimChunkProcessor::ValidateChunkData(const ChunkHeader& header, 
-                                          const uint8_t* data) const {
-    if (!data) {
+                                          ByteSpan data) const {
+    // Payload must be fully inside the view
+    if (!data.data() || data.size() < header.size) {
         return false;
     }
     
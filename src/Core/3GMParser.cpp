@@ -1,11 +1,12 @@
 #include "3GMParser.h"
 #include "ErrorHandler.h"
 #include "GlobalVariables.h"
-#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 
 Parser3GM::Parser3GM() 
-    : debugMode_(false), processedChunkCount_(0) {
+    : lazyDecoding_(false), threadCount_(0), debugMode_(false), processedChunkCount_(0) {
     
     // Initialize global systems
     GlobalVariables::InitializeGlobals();
@@ -26,6 +27,13 @@ void Parser3GM::RegisterChunkProcessor(ChunkType type, std::unique_ptr<ChunkProc
     }
 }
 
+void Parser3GM::SetThreadCount(unsigned threadCount) {
+    if (threadCount != threadCount_) {
+        threadPool_.reset();
+    }
+    threadCount_ = threadCount;
+}
+
 void Parser3GM::RegisterDefaultProcessors() {
     // TODO: Register all chunk processors when they're implemented
     // RegisterChunkProcessor(ChunkType::Dot2, std::make_unique<Dot2ChunkProcessor>());
@@ -51,8 +59,8 @@ bool Parser3GM::ParseFile(const std::string& filename) {
         return false;
     }
     
-    // Parse from loaded buffer
-    return ParseBuffer(fileData_.data(), fileData_.size(), filename);
+    // Parse directly from the mapped file
+    return ParseBuffer(inputFile_.Data(), inputFile_.Size(), filename);
 }
 
 bool Parser3GM::ParseBuffer(const uint8_t* data, size_t size, const std::string& debugName) {
@@ -62,7 +70,7 @@ bool Parser3GM::ParseBuffer(const uint8_t* data, size_t size, const std::string&
     }
     
     if (debugMode_) {
-        std::cout << "📋 Buffer size: " << size << " bytes" << std::endl;
+        std::cout << "📋 Buffer " << debugName << " size: " << size << " bytes" << std::endl;
     }
     
     // Step 1: Detect and process file header
@@ -115,24 +123,14 @@ bool Parser3GM::ParseBuffer(const uint8_t* data, size_t size, const std::string&
 }
 
 bool Parser3GM::LoadFileData(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        ErrorHandler::PostEvent(0x6A, "Could not open file: " + filename);
-        return false;
-    }
-    
-    size_t fileSize = file.tellg();
-    if (fileSize == 0) {
-        ErrorHandler::PostEvent(0x6A, "Empty file");
+    // MappedFile reports why the file could not be read
+    if (!inputFile_.Open(filename, inputOptions_)) {
         return false;
     }
     
-    fileData_.resize(fileSize);
-    file.seekg(0, std::ios::beg);
-    file.read(reinterpret_cast<char*>(fileData_.data()), fileSize);
-    
     if (debugMode_) {
-        std::cout << "✓ Loaded " << fileSize << " bytes from file" << std::endl;
+        std::cout << "✓ " << (inputFile_.IsMapped() ? "Mapped " : "Loaded ") 
+                  << inputFile_.Size() << " bytes from file" << std::endl;
     }
     
     return true;
@@ -146,6 +144,20 @@ bool Parser3GM::ProcessAllChunks() {
     const auto& chunks = chunkReader_->GetDiscoveredChunks();
     processedChunkCount_ = 0;
     
+    // Both modes process every chunk into its own slice and merge it, so the
+    // merged result is identical whether the slices run eagerly (on the
+    // thread pool or inline) or on first access to their stream
+    if (!lazyDecoding_) {
+        return ProcessAllChunksInSlices(chunks, ShouldProcessInParallel(chunks));
+    }
+    return DeferAllChunksInSlices(chunks);
+}
+
+bool Parser3GM::DeferAllChunksInSlices(const std::vector<ChunkHeader>& chunks) {
+    // First vertex of every vertex chunk in the merged shape, filled as the
+    // Positions stream merges its slices in file order
+    auto vertexBases = std::make_shared<std::vector<size_t>>();
+    
     for (const auto& header : chunks) {
         // Skip End chunk - it's just a terminator
         if (header.IsEndMarker()) {
@@ -153,27 +165,216 @@ bool Parser3GM::ProcessAllChunks() {
         }
         
         // Get chunk data
-        const uint8_t* chunkData = chunkReader_->GetChunkData(header);
-        if (!chunkData) {
-            ErrorHandler::PostEvent(0x6A, "Could not get chunk data");
-            return false;
+        ByteSpan chunkData = chunkReader_->GetChunkData(header);
+        if (!chunkData.data()) {
+            return ErrorHandler::PostEvent(0x6A, "Could not get chunk data");
+        }
+        
+        ShapeStream stream = ShapeData::GetStreamForChunk(header.type);
+        auto it = chunkProcessors_.find(header.type);
+        
+        // Metadata chunks are cheap and write the shape directly, as in eager parsing
+        if (stream == ShapeStream::Count || it == chunkProcessors_.end()) {
+            if (!ProcessChunk(header, chunkData)) {
+                if (debugMode_) {
+                    std::cout << "❌ Failed to process chunk: " << header.GetName() << std::endl;
+                }
+                return false;
+            }
+            processedChunkCount_++;
+            continue;
+        }
+        
+        if (debugMode_) {
+            std::cout << "⏸  Deferring " << header.GetName() 
+                      << " chunk (" << header.size << " bytes)" << std::endl;
         }
         
-        // Process chunk
-        if (!ProcessChunk(header, chunkData)) {
+        ChunkProcessor* processor = it->second.get();
+        if (stream == ShapeStream::Positions) {
+            size_t vertexChunk = vertexBases->size();
+            vertexBases->push_back(0);
+            parsedShape_.DeferChunk(stream, header, chunkData,
+                [processor, vertexBases, vertexChunk](const ChunkHeader& chunkHeader, ByteSpan data, ShapeData& shape) {
+                    (*vertexBases)[vertexChunk] = shape.GetVertexCount();
+                    ShapeData slice;
+                    if (!processor->ProcessChunk(chunkHeader, data, slice)) {
+                        return false;
+                    }
+                    return shape.MergeSlice(slice, (*vertexBases)[vertexChunk]);
+                });
+        } else {
+            // Primitives index the last vertex chunk before them in the file
+            size_t precedingVertexChunks = vertexBases->size();
+            parsedShape_.DeferChunk(stream, header, chunkData,
+                [processor, vertexBases, precedingVertexChunks](const ChunkHeader& chunkHeader, ByteSpan data, ShapeData& shape) {
+                    size_t vertexBase = 0;
+                    if (precedingVertexChunks > 0) {
+                        shape.GetVertexCount();     // Positions is an earlier stream: decoded first
+                        vertexBase = (*vertexBases)[precedingVertexChunks - 1];
+                    }
+                    ShapeData slice;
+                    if (!processor->ProcessChunk(chunkHeader, data, slice)) {
+                        return false;
+                    }
+                    return shape.MergeSlice(slice, vertexBase);
+                });
+        }
+        processedChunkCount_++;
+    }
+    
+    return true;
+}
+
+bool Parser3GM::ShouldProcessInParallel(const std::vector<ChunkHeader>& chunks) const {
+    if (lazyDecoding_ || threadCount_ == 1) {
+        return false;
+    }
+    
+    size_t parallelChunks = 0;
+    size_t parallelBytes = 0;
+    for (const auto& header : chunks) {
+        if (ShapeData::GetStreamForChunk(header.type) != ShapeStream::Count &&
+            chunkProcessors_.find(header.type) != chunkProcessors_.end()) {
+            parallelChunks++;
+            parallelBytes += header.size;
+        }
+    }
+    
+    return parallelChunks >= 2 && parallelBytes >= PARALLEL_MIN_BYTES;
+}
+
+bool Parser3GM::ProcessAllChunksInSlices(const std::vector<ChunkHeader>& chunks, bool useThreadPool) {
+    struct ChunkTask {
+        const ChunkHeader* header;
+        ByteSpan data;
+        ChunkProcessor* processor;
+        ShapeStream stage;
+        std::unique_ptr<ShapeData> slice;
+        bool succeeded;
+    };
+    
+    std::vector<ChunkTask> tasks;
+    
+    // Metadata chunks are cheap and write the shape directly - keep them serial
+    for (const auto& header : chunks) {
+        if (header.IsEndMarker()) {
+            continue;
+        }
+        
+        ByteSpan chunkData = chunkReader_->GetChunkData(header);
+        if (!chunkData.data()) {
+            return ErrorHandler::PostEvent(0x6A, "Could not get chunk data");
+        }
+        
+        ShapeStream stage = ShapeData::GetStreamForChunk(header.type);
+        auto it = chunkProcessors_.find(header.type);
+        
+        if (stage == ShapeStream::Count || it == chunkProcessors_.end()) {
+            if (!ProcessChunk(header, chunkData)) {
+                return false;
+            }
+            processedChunkCount_++;
+            continue;
+        }
+        
+        ChunkTask task;
+        task.header = &header;
+        task.data = chunkData;
+        task.processor = it->second.get();
+        task.stage = stage;
+        task.slice = std::make_unique<ShapeData>();
+        task.succeeded = false;
+        tasks.push_back(std::move(task));
+    }
+    
+    if (useThreadPool && !threadPool_) {
+        threadPool_ = std::make_unique<ThreadPool>(threadCount_);
+    }
+    
+    // Run on the pool, or inline when the file is too small to be worth it
+    auto dispatch = [&](std::vector<std::future<void>>& pending, std::function<void()> work) {
+        if (useThreadPool) {
+            pending.push_back(threadPool_->Submit(work));
+        } else {
+            work();
+        }
+    };
+    
+    // Run stages in dependency order; chunks within a stage are independent
+    for (size_t stage = 0; stage < static_cast<size_t>(ShapeStream::Count); stage++) {
+        std::vector<std::future<void>> pending;
+        std::map<ChunkProcessor*, std::vector<ChunkTask*>> serialGroups;
+        
+        for (auto& task : tasks) {
+            if (static_cast<size_t>(task.stage) != stage) {
+                continue;
+            }
+            
+            if (!task.processor->SupportsConcurrentChunks()) {
+                serialGroups[task.processor].push_back(&task);
+                continue;
+            }
+            
+            ChunkTask* taskPtr = &task;
+            dispatch(pending, [taskPtr]() {
+                taskPtr->succeeded = taskPtr->processor->ProcessChunk(*taskPtr->header, taskPtr->data, *taskPtr->slice);
+            });
+        }
+        
+        // Non-reentrant processors get all their chunks on one worker, in file order
+        for (auto& group : serialGroups) {
+            std::vector<ChunkTask*> groupTasks = group.second;
+            dispatch(pending, [groupTasks]() {
+                for (ChunkTask* task : groupTasks) {
+                    task->succeeded = task->processor->ProcessChunk(*task->header, task->data, *task->slice);
+                }
+            });
+        }
+        
+        bool stageFailed = false;
+        for (auto& future : pending) {
+            try {
+                future.get();
+            } catch (const std::exception& e) {
+                ErrorHandler::PostEvent(0x6A, std::string("Chunk processor threw: ") + e.what());
+                stageFailed = true;
+            }
+        }
+        if (stageFailed) {
+            return false;
+        }
+    }
+    
+    // Merge slices in file order; primitives index the last preceding vertex chunk
+    size_t vertexBase = 0;
+    for (auto& task : tasks) {
+        if (!task.succeeded) {
             if (debugMode_) {
-                std::cout << "❌ Failed to process chunk: " << header.GetName() << std::endl;
+                std::cout << "❌ Failed to process chunk: " << task.header->GetName() << std::endl;
             }
             return false;
         }
         
+        if (task.stage == ShapeStream::Positions) {
+            vertexBase = parsedShape_.GetVertexCount();
+        }
+        
+        if (!parsedShape_.MergeSlice(*task.slice, vertexBase)) {
+            return false;
+        }
         processedChunkCount_++;
     }
     
+    if (debugMode_ && useThreadPool) {
+        std::cout << "🔀 Processed " << tasks.size() << " chunks on " 
+                  << threadPool_->GetThreadCount() << " threads" << std::endl;
+    }
+    
     return true;
 }
 
-bool Parser3GM::ProcessChunk(const ChunkHeader& header, const uint8_t* data) {
+bool Parser3GM::ProcessChunk(const ChunkHeader& header, ByteSpan data) {
     auto it = chunkProcessors_.find(header.type);
     if (it == chunkProcessors_.end()) {
         if (debugMode_) {
@@ -197,7 +398,7 @@ const std::vector<ChunkHeader>& Parser3GM::GetDiscoveredChunks() const {
 
 void Parser3GM::Reset() {
     chunkProcessors_.clear();
-    fileData_.clear();
+    inputFile_.Close();
     filename_.clear();
     chunkReader_.reset();
     parsedShape_.Reset();
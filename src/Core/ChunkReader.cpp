@@ -5,7 +5,7 @@
 #include <iomanip>
 
 ChunkReader::ChunkReader(const uint8_t* data, size_t size, size_t startOffset)
-    : fileData_(data), fileSize_(size), currentOffset_(startOffset) {
+    : fileData_(data), fileSize_(size), startOffset_(startOffset), currentOffset_(startOffset) {
     
     if (!fileData_) {
         ErrorHandler::PostEvent(0x6A, "Null file data in ChunkReader");
@@ -51,7 +51,7 @@ bool ChunkReader::ReadNextChunkHeader(ChunkHeader& header) {
     uint32_t chunkSize = ByteSwap::ReadLittleEndian32(fileData_ + currentOffset_ + 4);
     
     // Create header
-    header = ChunkHeader(chunkID, chunkSize);
+    header = ChunkHeader(chunkID, chunkSize, currentOffset_);
     
     // Validate chunk doesn't extend past file
     if (currentOffset_ + header.GetTotalSize() > fileSize_) {
@@ -62,13 +62,13 @@ bool ChunkReader::ReadNextChunkHeader(ChunkHeader& header) {
     return header.IsValid();
 }
 
-const uint8_t* ChunkReader::GetChunkData(const ChunkHeader& header) const {
-    if (!fileData_ || currentOffset_ + 8 >= fileSize_) {
-        return nullptr;
+ByteSpan ChunkReader::GetChunkData(const ChunkHeader& header) const {
+    if (!fileData_ || header.offset + header.GetTotalSize() > fileSize_) {
+        return ByteSpan();
     }
     
     // Data starts after 8-byte header
-    return fileData_ + currentOffset_ + 8;
+    return ByteSpan(fileData_ + header.offset + 8, header.size);
 }
 
 bool ChunkReader::SkipToNextChunk(const ChunkHeader& header) {
@@ -85,9 +85,7 @@ bool ChunkReader::SkipToNextChunk(const ChunkHeader& header) {
 
 void ChunkReader::Reset() {
     // Reset to the original start offset (after header)
-    size_t startOffset = (fileSize_ >= 8) ? 
-        (discoveredChunks_.empty() ? currentOffset_ : currentOffset_ - GetCurrentOffset()) : 0;
-    currentOffset_ = startOffset;
+    currentOffset_ = (fileSize_ >= 8) ? startOffset_ : 0;
 }
 
 bool ChunkReader::IsAtEnd() const {
@@ -0,0 +1,180 @@
+#include "ChunkTable.h"
+#include "ByteSwap.h"
+#include "HeaderDetector.h"
+#include "TagScanner.h"
+
+std::string ChunkTableEntry::GetTag() const {
+    char tag[4] = {
+        static_cast<char>(header.rawID & 0xFF),
+        static_cast<char>((header.rawID >> 8) & 0xFF),
+        static_cast<char>((header.rawID >> 16) & 0xFF),
+        static_cast<char>((header.rawID >> 24) & 0xFF)
+    };
+    return std::string(tag, 4);
+}
+
+ChunkTable::ChunkTable()
+    : sizeOrder_(SizeByteOrder::BigEndian), recoveredCount_(0) {
+}
+
+void ChunkTable::Clear() {
+    data_ = ByteSpan();
+    entries_.clear();
+    sizeOrder_ = SizeByteOrder::BigEndian;
+    recoveredCount_ = 0;
+}
+
+bool ChunkTable::IsKnownTag(uint32_t rawID) {
+    return GetChunkTypeFromRawID(rawID) != ChunkType::Unknown;
+}
+
+bool ChunkTable::Build(ByteSpan data) {
+    Clear();
+    data_ = data;
+
+    const size_t fileSize = data.size();
+    if (fileSize < 4) {
+        return false;
+    }
+
+    // Full headers are laid out as a "3DGM" chunk; version-only headers
+    // are a bare dword in front of the first chunk
+    FileHeader fileHeader = HeaderDetector::DetectHeader(data.data(), fileSize);
+    size_t pos = (fileHeader.type == HeaderType::VersionOnly) ? fileHeader.chunkOffset : 0;
+
+    // Headerless level files may carry leading bytes before the first tag
+    if (pos + 4 > fileSize || !IsKnownTag(ByteSwap::ReadLittleEndian32(data.data() + pos))) {
+        pos = Resync(pos);
+    }
+
+    DetectSizeByteOrder(pos);
+
+    while (pos + 4 <= fileSize) {
+        uint32_t rawID = ByteSwap::ReadLittleEndian32(data.data() + pos);
+
+        if (!IsKnownTag(rawID)) {
+            pos = Resync(pos + 1);
+            continue;
+        }
+
+        ChunkTableEntry entry;
+        entry.position = pos;
+
+        if (GetChunkTypeFromRawID(rawID) == ChunkType::End) {
+            // Terminator may be written without a size field
+            entry.header = ChunkHeader(rawID, 0, pos);
+            entry.size = (pos + 8 <= fileSize) ? 8 : fileSize - pos;
+            entries_.push_back(entry);
+            break;
+        }
+
+        if (pos + 8 > fileSize) {
+            break;  // Truncated chunk header
+        }
+
+        uint32_t dataSize = ReadSize(data.data() + pos + 4);
+        size_t next = pos + 8 + dataSize;
+
+        if (dataSize > fileSize - pos - 8 || !IsBoundary(next)) {
+            // Size field is damaged - chunk ends where the next one starts
+            next = Resync(pos + 8);
+            dataSize = static_cast<uint32_t>(next - pos - 8);
+            entry.recovered = true;
+            recoveredCount_++;
+        }
+
+        entry.header = ChunkHeader(rawID, dataSize, pos);
+        entry.size = next - pos;
+        entries_.push_back(entry);
+
+        pos = next;
+    }
+
+    return !entries_.empty();
+}
+
+const ChunkTableEntry* ChunkTable::Find(ChunkType type) const {
+    for (const auto& entry : entries_) {
+        if (entry.header.type == type) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<const ChunkTableEntry*> ChunkTable::FindAll(ChunkType type) const {
+    std::vector<const ChunkTableEntry*> result;
+    for (const auto& entry : entries_) {
+        if (entry.header.type == type) {
+            result.push_back(&entry);
+        }
+    }
+    return result;
+}
+
+uint32_t ChunkTable::ReadSize(const uint8_t* sizeField) const {
+    return sizeOrder_ == SizeByteOrder::BigEndian
+        ? ByteSwap::ReadBigEndian32(sizeField)
+        : ByteSwap::ReadLittleEndian32(sizeField);
+}
+
+bool ChunkTable::IsBoundary(size_t offset) const {
+    const size_t fileSize = data_.size();
+    if (offset > fileSize) {
+        return false;
+    }
+    if (offset + 4 > fileSize) {
+        return true;  // End of file (tolerate trailing padding)
+    }
+    return IsKnownTag(ByteSwap::ReadLittleEndian32(data_.data() + offset));
+}
+
+void ChunkTable::DetectSizeByteOrder(size_t firstChunk) {
+    sizeOrder_ = SizeByteOrder::BigEndian;
+
+    const size_t fileSize = data_.size();
+    if (firstChunk + 8 > fileSize) {
+        return;
+    }
+
+    const uint8_t* sizeField = data_.data() + firstChunk + 4;
+    const size_t remaining = fileSize - firstChunk - 8;
+
+    uint32_t sizeBE = ByteSwap::ReadBigEndian32(sizeField);
+    if (sizeBE <= remaining && IsBoundary(firstChunk + 8 + sizeBE)) {
+        return;
+    }
+
+    uint32_t sizeLE = ByteSwap::ReadLittleEndian32(sizeField);
+    if (sizeLE <= remaining && IsBoundary(firstChunk + 8 + sizeLE)) {
+        sizeOrder_ = SizeByteOrder::LittleEndian;
+    }
+}
+
+size_t ChunkTable::Resync(size_t offset) const {
+    const size_t fileSize = data_.size();
+    size_t firstTag = fileSize;
+
+    for (size_t pos = TagScanner::FindNextTag(data_.data(), fileSize, offset);
+         pos < fileSize;
+         pos = TagScanner::FindNextTag(data_.data(), fileSize, pos + 1)) {
+        if (GetChunkTypeFromRawID(ByteSwap::ReadLittleEndian32(data_.data() + pos)) == ChunkType::End) {
+            return pos;
+        }
+
+        // Prefer a tag whose own size field is consistent, payload bytes
+        // can spell a tag by accident
+        if (pos + 8 <= fileSize) {
+            uint32_t dataSize = ReadSize(data_.data() + pos + 4);
+            if (dataSize <= fileSize - pos - 8 && IsBoundary(pos + 8 + dataSize)) {
+                return pos;
+            }
+        }
+
+        if (firstTag == fileSize) {
+            firstTag = pos;
+        }
+    }
+
+    return firstTag;
+}
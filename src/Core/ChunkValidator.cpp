@@ -0,0 +1,35 @@
+#include "ChunkValidator.h"
+#include "ChunkProcessor.h"
+
+bool ChunkValidator::ValidateRecords(const ChunkHeader& header, ByteSpan buffer,
+                                     const ChunkRecordLayout& layout, ValidatedChunk& validated) {
+    validated = ValidatedChunk();
+
+    if (layout.recordCount > 0 && (!buffer.data() || layout.recordSize == 0)) {
+        return false;
+    }
+    if (layout.offset > buffer.size()) {
+        return false;
+    }
+
+    // Divide instead of multiplying so a corrupt count cannot overflow
+    size_t available = buffer.size() - layout.offset;
+    if (layout.recordCount > 0 && layout.recordCount > available / layout.recordSize) {
+        return false;
+    }
+
+    validated.header_ = header;
+    validated.records_ = buffer.data() ? buffer.data() + layout.offset : nullptr;
+    validated.recordSize_ = layout.recordSize;
+    validated.recordCount_ = layout.recordCount;
+    return true;
+}
+
+bool ChunkValidator::ValidateChunk(const ChunkProcessor& processor, const ChunkHeader& header, ByteSpan payload,
+                                   const ChunkRecordLayout& layout, ValidatedChunk& validated) {
+    if (!processor.ValidateChunkData(header, payload)) {
+        validated = ValidatedChunk();
+        return false;
+    }
+    return ValidateRecords(header, payload, layout, validated);
+}
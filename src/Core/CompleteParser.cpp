@@ -2,6 +2,7 @@
 #include "../../include_new/HeaderDetector.h"
 #include "../../include_new/ChunkReader.h"
 #include "../../include_new/ErrorHandler.h"
+#include "../../include_new/ParseContext.h"
 #include "../Processing/VertexProcessor.cpp"
 #include "../Processing/PrimitiveProcessor.cpp"
 #include "../Processing/SurfaceGenerator.cpp"
@@ -28,14 +29,21 @@ class Complete3GMParser {
 private:
     std::unique_ptr<VertexProcessor> vertexProcessor_;
     std::unique_ptr<PrimitiveProcessor> primitiveProcessor_;
-    std::unique_ptr<SurfaceGenerator> surfaceGenerator_;
+    std::unique_ptr<ParseContext> ownContext_;     // Only when no context is shared in
+    ParseContext& parseContext_;                    // Keeps the surface generator from file to file
     std::unique_ptr<AnimationSystem> animationSystem_;
     std::unique_ptr<LineProcessor> lineProcessor_;
     
     bool systemsInitialized_;
     
 public:
-    Complete3GMParser() : systemsInitialized_(false) {
+    /**
+     * @param context Buffers to reuse across parsers, nullptr = own buffers
+     */
+    explicit Complete3GMParser(ParseContext* context = nullptr)
+        : ownContext_(context ? nullptr : std::make_unique<ParseContext>()),
+          parseContext_(context ? *context : *ownContext_),
+          systemsInitialized_(false) {
         InitializeAllSystems();
     }
     
@@ -50,12 +58,11 @@ public:
             // Initialize all processors
             vertexProcessor_ = std::make_unique<VertexProcessor>();
             primitiveProcessor_ = std::make_unique<PrimitiveProcessor>();
-            surfaceGenerator_ = std::make_unique<SurfaceGenerator>();
             animationSystem_ = std::make_unique<AnimationSystem>();
             lineProcessor_ = std::make_unique<LineProcessor>();
             
-            // Initialize systems with proper parameters
-            if (!surfaceGenerator_->Initialize(1000, 5000)) {
+            // Initialize systems with proper parameters; the context initializes its generator once
+            if (!GetSurfaceGenerator().IsSystemReady()) {
                 std::cerr << "❌ Surface generator initialization failed\n";
                 return false;
             }
@@ -77,7 +84,6 @@ public:
     
     void CleanupAllSystems() {
         if (animationSystem_) animationSystem_->Cleanup();
-        if (surfaceGenerator_) surfaceGenerator_->Cleanup();
         systemsInitialized_ = false;
     }
     
@@ -111,6 +117,13 @@ public:
     }
     
 private:
+    /**
+     * The context's generator; a trim frees it, so it is looked up on every use
+     */
+    SurfaceGenerator& GetSurfaceGenerator() {
+        return parseContext_.GetSurfaceGenerator(1000, 5000);
+    }
+    
     bool ReadFile(const std::string& filePath, std::vector<uint8_t>& data) {
         std::ifstream file(filePath, std::ios::binary);
         if (!file) {
@@ -143,6 +156,9 @@ private:
     }
     
     bool ParseFileData(const std::vector<uint8_t>& data, const std::string& filename) {
+        // Surfaces of the previous file are forgotten, the tables are kept
+        parseContext_.Begin();
+        
         // Step 1: Header Detection
         std::cout << "🔍 Step 1: Header Detection\n";
         FileHeader header = HeaderDetector::DetectHeader(data.data(), data.size());
@@ -199,31 +215,27 @@ private:
                      uint32_t& primChunks, uint32_t& lineChunks, 
                      uint32_t& animationChunks, uint32_t& unknownChunks) {
         
-        std::vector<uint8_t> chunkData;
-        const uint8_t* rawData = reader.GetChunkData(header);
-        if (!rawData) {
+        // View into the file buffer - handlers copy only what they keep
+        ByteSpan chunkData = reader.GetChunkData(header);
+        if (!chunkData.data()) {
             return false;
         }
         
         // Determine chunk type and process accordingly
         if (IsPrimChunk(header.rawID)) {
             primChunks++;
-            chunkData.assign(rawData, rawData + header.size);
             return ProcessPrimitiveChunk(chunkData, header);
         }
         else if (IsLineChunk(header.rawID)) {
             lineChunks++;
-            chunkData.assign(rawData, rawData + header.size);
             return ProcessLineChunk(chunkData, header);
         }
         else if (IsAnimationChunk(header.rawID)) {
             animationChunks++;
-            chunkData.assign(rawData, rawData + header.size);
             return ProcessAnimationChunk(chunkData, header);
         }
         else {
             unknownChunks++;
-            chunkData.assign(rawData, rawData + header.size);
             return ProcessUnknownChunk(chunkData, header);
         }
     }
@@ -244,7 +256,7 @@ private:
                (chunkType == 0x46506F73); // "FPos"
     }
     
-    bool ProcessPrimitiveChunk(const std::vector<uint8_t>& data, const ChunkHeader& header) {
+    bool ProcessPrimitiveChunk(ByteSpan data, const ChunkHeader& header) {
         std::cout << "   🎯 Processing Prim chunk (size=" << data.size() << ")\n";
         
         // Process with primitive processor
@@ -259,7 +271,7 @@ private:
         int16_t textureID = 0;
         uint16_t flags = 0;
         
-        uint16_t surfaceID = surfaceGenerator_->GetOrCreateSurface(primitiveType, textureID, flags);
+        uint16_t surfaceID = GetSurfaceGenerator().GetOrCreateSurface(primitiveType, textureID, flags);
         if (surfaceID == 0) {
             std::cout << "   ⚠️  Surface creation failed\n";
             return false;
@@ -269,14 +281,14 @@ private:
         return true;
     }
     
-    bool ProcessLineChunk(const std::vector<uint8_t>& data, const ChunkHeader& header) {
+    bool ProcessLineChunk(ByteSpan data, const ChunkHeader& header) {
         std::cout << "   🔄 Processing Line chunk (size=" << data.size() << ")\n";
         
         return lineProcessor_->ProcessLineChunk(data.data(), data.size(), 
                                                "Chunk_" + std::to_string(header.rawID));
     }
     
-    bool ProcessAnimationChunk(const std::vector<uint8_t>& data, const ChunkHeader& header) {
+    bool ProcessAnimationChunk(ByteSpan data, const ChunkHeader& header) {
         std::cout << "   🎬 Processing Animation chunk (size=" << data.size() << ")\n";
         
         if (header.rawID == 0x736F5046) { // soPF
@@ -289,7 +301,7 @@ private:
         return false;
     }
     
-    bool ProcessUnknownChunk(const std::vector<uint8_t>& data, const ChunkHeader& header) {
+    bool ProcessUnknownChunk(ByteSpan data, const ChunkHeader& header) {
         std::cout << "   ❓ Unknown chunk type: 0x" << std::hex << header.rawID 
                   << std::dec << " (size=" << data.size() << ")\n";
         
@@ -301,7 +313,7 @@ private:
         std::cout << "\n📊 System Statistics:\n";
         
         // Surface Generator Stats
-        auto surfaceStats = surfaceGenerator_->GetStatistics();
+        auto surfaceStats = GetSurfaceGenerator().GetStatistics();
         std::cout << "   Surfaces: " << surfaceStats.allocatedSurfaces 
                   << " (max: " << surfaceStats.maxSurfaces << ")\n";
         
@@ -0,0 +1,63 @@
+#include "ParseContext.h"
+#include "SurfaceGenerator.h"
+#include <algorithm>
+
+ParseContext::ParseContext(const TrimPolicy& policy)
+    : policy_(policy), parseCount_(0), trimCount_(0), intervalPeak_(0) {
+}
+
+ParseContext::~ParseContext() = default;
+
+void ParseContext::Begin() {
+    if (parseCount_ > 0) {
+        intervalPeak_ = std::max(intervalPeak_, GetUsedBytes());
+
+        if (GetRetainedBytes() > policy_.maxRetainedBytes) {
+            Trim();
+        } else if (policy_.decayInterval > 0 && parseCount_ % policy_.decayInterval == 0) {
+            // One huge file should not pin its buffers for the rest of a batch of small ones
+            if (GetRetainedBytes() > 2 * intervalPeak_) {
+                Trim();
+            }
+            intervalPeak_ = 0;
+        }
+    }
+
+    arena_.Reset();
+    chunkTable_.Clear();
+    streamWindow_.clear();
+    if (surfaceGenerator_) {
+        surfaceGenerator_->Reset();
+    }
+    parseCount_++;
+}
+
+SurfaceGenerator& ParseContext::GetSurfaceGenerator(int32_t maxTextures, int32_t maxSurfaces) {
+    if (!surfaceGenerator_) {
+        surfaceGenerator_ = std::make_unique<SurfaceGenerator>();
+    }
+    SurfaceGenerator::Statistics stats = surfaceGenerator_->GetStatistics();
+    if (!surfaceGenerator_->IsSystemReady() || stats.maxTextures != maxTextures || stats.maxSurfaces != maxSurfaces) {
+        surfaceGenerator_->Initialize(maxTextures, maxSurfaces);
+    }
+    return *surfaceGenerator_;
+}
+
+void ParseContext::Trim() {
+    arena_.Release();
+    chunkTable_ = ChunkTable();
+    StreamWindowBuffer().swap(streamWindow_);
+    surfaceGenerator_.reset();
+    trimCount_++;
+}
+
+size_t ParseContext::GetRetainedBytes() const {
+    return arena_.GetBytesReserved() + chunkTable_.GetReservedBytes() + streamWindow_.capacity() +
+           (surfaceGenerator_ ? surfaceGenerator_->GetTableBytes() : 0);
+}
+
+size_t ParseContext::GetUsedBytes() const {
+    // The surface tables have a fixed size, so they count as used while they exist
+    return arena_.GetBytesUsed() + chunkTable_.GetChunkCount() * sizeof(ChunkTableEntry) + streamWindow_.size() +
+           (surfaceGenerator_ ? surfaceGenerator_->GetTableBytes() : 0);
+}
@@ -0,0 +1,178 @@
+#include "StreamingChunkReader.h"
+#include "ByteSwap.h"
+#include "HeaderDetector.h"
+#include "ErrorHandler.h"
+
+StreamingChunkReader::StreamingChunkReader(size_t windowSize)
+    : windowSize_(windowSize < 16 ? 16 : windowSize),
+      window_(&ownWindow_),
+      sizeOrder_(ChunkTable::SizeByteOrder::BigEndian),
+      sizeOrderForced_(false),
+      sizeOrderKnown_(false),
+      bytesRead_(0),
+      chunksDelivered_(0),
+      chunksSkipped_(0),
+      peakBuffered_(0),
+      oversizeChunkBytes_(0) {
+}
+
+void StreamingChunkReader::SetHandler(ChunkType type, ChunkHandler handler) {
+    handlers_[type] = handler;
+}
+
+void StreamingChunkReader::SetSizeByteOrder(ChunkTable::SizeByteOrder order) {
+    sizeOrder_ = order;
+    sizeOrderForced_ = true;
+}
+
+bool StreamingChunkReader::Run(ByteSource& source) {
+    bytesRead_ = 0;
+    chunksDelivered_ = 0;
+    chunksSkipped_ = 0;
+    peakBuffered_ = 0;
+    oversizeChunkBytes_ = 0;
+    sizeOrderKnown_ = sizeOrderForced_;
+
+    // Window only grows to the largest handled chunk, never past windowSize_
+    window_->resize(8);
+
+    if (!ReadExact(source, window_->data(), 4)) {
+        return ErrorHandler::PostEvent(0x6A, "Stream is empty or too short for a chunk tag");
+    }
+
+    uint32_t first = ByteSwap::ReadLittleEndian32(window_->data());
+    bool tagPending = true;   // window_ already holds the next tag
+
+    if (GetChunkTypeFromRawID(first) == ChunkType::Unknown) {
+        FileHeader fileHeader = HeaderDetector::DetectHeader(window_->data(), 4);
+        if (fileHeader.type != HeaderType::VersionOnly) {
+            // No seeking back on a stream, so headerless data must start with a tag
+            return ErrorHandler::PostEvent(0x6A, "Stream does not start with a chunk tag or version header");
+        }
+        tagPending = false;
+    }
+
+    size_t streamOffset = tagPending ? 0 : 4;
+
+    for (;;) {
+        if (!tagPending) {
+            size_t got = 0;
+            while (got < 4) {
+                size_t bytes = source.Read(window_->data() + got, 4 - got);
+                if (bytes == 0) break;
+                got += bytes;
+            }
+            bytesRead_ += got;
+
+            if (got == 0 && !source.HasError()) {
+                return true;  // Clean end of input without "End " marker
+            }
+            if (got < 4) {
+                return ErrorHandler::PostEvent(0x6A, "Stream ended inside a chunk tag");
+            }
+        }
+        tagPending = false;
+
+        uint32_t rawID = ByteSwap::ReadLittleEndian32(window_->data());
+        ChunkType type = GetChunkTypeFromRawID(rawID);
+
+        if (type == ChunkType::End) {
+            // Terminator may be written without a size field - stop here
+            auto handlerIt = handlers_.find(type);
+            if (handlerIt != handlers_.end()) {
+                handlerIt->second(ChunkHeader(rawID, 0, streamOffset), ByteSpan(window_->data(), 4), streamOffset);
+            }
+            return true;
+        }
+
+        if (!ReadExact(source, window_->data() + 4, 4)) {
+            return ErrorHandler::PostEvent(0x6A, "Stream ended inside a chunk header");
+        }
+
+        if (!sizeOrderKnown_) {
+            DetectSizeByteOrder(window_->data() + 4);
+        }
+
+        uint32_t dataSize = ReadSize(window_->data() + 4);
+        ChunkHeader header(rawID, dataSize, streamOffset);
+
+        auto handlerIt = handlers_.find(type);
+        if (handlerIt == handlers_.end()) {
+            // Unhandled or unknown chunk - trust its size field and drop the payload
+            if (!Skip(source, dataSize)) {
+                return ErrorHandler::PostEvent(0x6A, "Stream ended inside a skipped chunk");
+            }
+            chunksSkipped_++;
+        } else {
+            size_t chunkBytes = 8 + static_cast<size_t>(dataSize);
+            if (chunkBytes > windowSize_) {
+                oversizeChunkBytes_ = chunkBytes;
+                return ErrorHandler::PostEvent(0x6A, std::string("Chunk ") + header.GetName() + " of " +
+                                               std::to_string(chunkBytes) + " bytes exceeds streaming window of " +
+                                               std::to_string(windowSize_) + " bytes");
+            }
+
+            if (window_->size() < chunkBytes) {
+                window_->resize(chunkBytes);
+            }
+            if (!ReadExact(source, window_->data() + 8, dataSize)) {
+                return ErrorHandler::PostEvent(0x6A, std::string("Stream ended inside chunk ") + header.GetName());
+            }
+            if (chunkBytes > peakBuffered_) {
+                peakBuffered_ = chunkBytes;
+            }
+
+            chunksDelivered_++;
+            if (!handlerIt->second(header, ByteSpan(window_->data(), chunkBytes), streamOffset)) {
+                return false;
+            }
+        }
+
+        streamOffset += 8 + static_cast<size_t>(dataSize);
+    }
+}
+
+bool StreamingChunkReader::ReadExact(ByteSource& source, uint8_t* buffer, size_t count) {
+    size_t got = 0;
+    while (got < count) {
+        size_t bytes = source.Read(buffer + got, count - got);
+        if (bytes == 0) {
+            bytesRead_ += got;
+            return false;
+        }
+        got += bytes;
+    }
+    bytesRead_ += got;
+    return true;
+}
+
+bool StreamingChunkReader::Skip(ByteSource& source, size_t count) {
+    uint8_t scratch[4096];
+    while (count > 0) {
+        size_t step = count < sizeof(scratch) ? count : sizeof(scratch);
+        if (!ReadExact(source, scratch, step)) {
+            return false;
+        }
+        count -= step;
+    }
+    return true;
+}
+
+void StreamingChunkReader::DetectSizeByteOrder(const uint8_t* sizeField) {
+    uint32_t sizeBE = ByteSwap::ReadBigEndian32(sizeField);
+    uint32_t sizeLE = ByteSwap::ReadLittleEndian32(sizeField);
+
+    // Without look-ahead the only evidence is which reading is plausible
+    if (sizeBE + 8ull > windowSize_ && sizeLE + 8ull <= windowSize_) {
+        sizeOrder_ = ChunkTable::SizeByteOrder::LittleEndian;
+    } else {
+        sizeOrder_ = ChunkTable::SizeByteOrder::BigEndian;
+    }
+    sizeOrderKnown_ = true;
+}
+
+uint32_t StreamingChunkReader::ReadSize(const uint8_t* sizeField) const {
+    return sizeOrder_ == ChunkTable::SizeByteOrder::BigEndian
+        ? ByteSwap::ReadBigEndian32(sizeField)
+        : ByteSwap::ReadLittleEndian32(sizeField);
+}
@@ -0,0 +1,282 @@
+#include "TagScanner.h"
+#include "ChunkTypes.h"
+#include "CpuFeatures.h"
+#include "ByteSwap.h"
+#include <atomic>
+#include <cstring>
+
+#ifdef SHAPELOADER_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * Lookup tables derived once from KnownChunkTypes
+ */
+struct TagTables {
+    bool firstByte[256];        // Scalar prefilter on the first tag byte
+
+    uint8_t firstBytes[16];     // Distinct first bytes (SSE2 filter)
+    size_t firstCount;
+    uint8_t secondBytes[16];    // Distinct second bytes (SSE2 filter)
+    size_t secondCount;
+    bool byteListsUsable;       // false if a position has more than 16 distinct bytes
+
+    // Nibble classification per tag byte position (AVX2 filter):
+    // byte b can appear at position k iff nibbleLo[k][b & 15] & nibbleHi[k][b >> 4]
+    alignas(16) uint8_t nibbleLo[4][16];
+    alignas(16) uint8_t nibbleHi[4][16];
+    bool nibbleUsable;          // false if a position needs more than 8 classes
+
+    TagTables() : firstCount(0), secondCount(0), byteListsUsable(true), nibbleUsable(true) {
+        std::memset(firstByte, 0, sizeof(firstByte));
+        std::memset(nibbleLo, 0, sizeof(nibbleLo));
+        std::memset(nibbleHi, 0, sizeof(nibbleHi));
+
+        for (size_t i = 0; i < KnownChunkTypeCount; i++) {
+            uint32_t rawID = static_cast<uint32_t>(KnownChunkTypes[i]);
+            uint8_t bytes[4];
+            ByteSwap::WriteLittleEndian32(bytes, rawID);
+
+            firstByte[bytes[0]] = true;
+            // A byte left out of a list would hide its tags from the SSE2 filter
+            if (!AddDistinct(firstBytes, firstCount, bytes[0]) ||
+                !AddDistinct(secondBytes, secondCount, bytes[1])) {
+                byteListsUsable = false;
+            }
+        }
+
+        // One class bit per distinct high nibble keeps the lookup exact per position
+        for (int k = 0; k < 4; k++) {
+            int classCount = 0;
+            for (size_t i = 0; i < KnownChunkTypeCount; i++) {
+                uint8_t byte = static_cast<uint8_t>(static_cast<uint32_t>(KnownChunkTypes[i]) >> (8 * k));
+                uint8_t hi = byte >> 4;
+                uint8_t lo = byte & 0x0F;
+
+                if (nibbleHi[k][hi] == 0) {
+                    if (classCount == 8) {
+                        nibbleUsable = false;
+                        return;
+                    }
+                    nibbleHi[k][hi] = static_cast<uint8_t>(1 << classCount++);
+                }
+                nibbleLo[k][lo] |= nibbleHi[k][hi];
+            }
+        }
+    }
+
+    /**
+     * @return false if the value is new and the list is full
+     */
+    static bool AddDistinct(uint8_t* list, size_t& count, uint8_t value) {
+        for (size_t i = 0; i < count; i++) {
+            if (list[i] == value) return true;
+        }
+        if (count == 16) {
+            return false;
+        }
+        list[count++] = value;
+        return true;
+    }
+};
+
+const TagTables& GetTables() {
+    static const TagTables tables;
+    return tables;
+}
+
+inline bool IsTagAt(const uint8_t* data) {
+    return GetChunkTypeFromRawID(ByteSwap::ReadLittleEndian32(data)) != ChunkType::Unknown;
+}
+
+inline unsigned CountTrailingZeros(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned index = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Confirm candidate bits from a SIMD filter, lowest offset first
+ * @return Offset of the first real tag, or size if none
+ */
+inline size_t ConfirmCandidates(const uint8_t* data, size_t size, size_t base, uint32_t mask) {
+    while (mask) {
+        size_t pos = base + CountTrailingZeros(mask);
+        if (IsTagAt(data + pos)) {
+            return pos;
+        }
+        mask &= mask - 1;
+    }
+    return size;
+}
+
+TagScanner::Kernel SelectKernel() {
+    if (CpuFeatures::HasAVX2() && GetTables().nibbleUsable) {
+        return TagScanner::Kernel::AVX2;
+    }
+    if (CpuFeatures::HasSSE2() && GetTables().byteListsUsable) {
+        return TagScanner::Kernel::SSE2;
+    }
+    return TagScanner::Kernel::Scalar;
+}
+
+std::atomic<int> g_activeKernel(-1);
+
+} // anonymous namespace
+
+size_t TagScanner::FindNextTag(const uint8_t* data, size_t size, size_t offset) {
+    if (!data || offset >= size || size - offset < 4) {
+        return size;
+    }
+
+    switch (GetKernel()) {
+        case Kernel::AVX2: return FindNextTagAVX2(data, size, offset);
+        case Kernel::SSE2: return FindNextTagSSE2(data, size, offset);
+        default:           return FindNextTagScalar(data, size, offset);
+    }
+}
+
+TagScanner::Kernel TagScanner::GetKernel() {
+    int kernel = g_activeKernel.load(std::memory_order_relaxed);
+    if (kernel < 0) {
+        kernel = static_cast<int>(SelectKernel());
+        g_activeKernel.store(kernel, std::memory_order_relaxed);
+    }
+    return static_cast<Kernel>(kernel);
+}
+
+void TagScanner::SetKernel(Kernel kernel) {
+    if (kernel == Kernel::AVX2 && !(CpuFeatures::HasAVX2() && GetTables().nibbleUsable)) {
+        kernel = Kernel::SSE2;
+    }
+    if (kernel == Kernel::SSE2 && !(CpuFeatures::HasSSE2() && GetTables().byteListsUsable)) {
+        kernel = Kernel::Scalar;
+    }
+    g_activeKernel.store(static_cast<int>(kernel), std::memory_order_relaxed);
+}
+
+const char* TagScanner::GetKernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::AVX2: return "AVX2";
+        case Kernel::SSE2: return "SSE2";
+        default:           return "Scalar";
+    }
+}
+
+size_t TagScanner::FindNextTagScalar(const uint8_t* data, size_t size, size_t offset) {
+    const TagTables& tables = GetTables();
+
+    for (size_t pos = offset; pos + 4 <= size; pos++) {
+        if (tables.firstByte[data[pos]] && IsTagAt(data + pos)) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+#ifdef SHAPELOADER_X86
+
+SHAPELOADER_TARGET("sse2")
+size_t TagScanner::FindNextTagSSE2(const uint8_t* data, size_t size, size_t offset) {
+    const TagTables& tables = GetTables();
+
+    __m128i firstBytes[16];
+    __m128i secondBytes[16];
+    for (size_t i = 0; i < tables.firstCount; i++) {
+        firstBytes[i] = _mm_set1_epi8(static_cast<char>(tables.firstBytes[i]));
+    }
+    for (size_t i = 0; i < tables.secondCount; i++) {
+        secondBytes[i] = _mm_set1_epi8(static_cast<char>(tables.secondBytes[i]));
+    }
+
+    size_t pos = offset;
+
+    // Need 16 offsets plus the 3 trailing bytes of the last tag
+    while (pos + 16 + 3 <= size) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+
+        __m128i firstMatch = _mm_setzero_si128();
+        for (size_t i = 0; i < tables.firstCount; i++) {
+            firstMatch = _mm_or_si128(firstMatch, _mm_cmpeq_epi8(first, firstBytes[i]));
+        }
+        __m128i secondMatch = _mm_setzero_si128();
+        for (size_t i = 0; i < tables.secondCount; i++) {
+            secondMatch = _mm_or_si128(secondMatch, _mm_cmpeq_epi8(second, secondBytes[i]));
+        }
+
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(firstMatch, secondMatch)));
+        if (mask) {
+            size_t found = ConfirmCandidates(data, size, pos, mask);
+            if (found != size) {
+                return found;
+            }
+        }
+        pos += 16;
+    }
+
+    return FindNextTagScalar(data, size, pos);
+}
+
+SHAPELOADER_TARGET("avx2")
+size_t TagScanner::FindNextTagAVX2(const uint8_t* data, size_t size, size_t offset) {
+    const TagTables& tables = GetTables();
+
+    __m256i nibbleLo[4];
+    __m256i nibbleHi[4];
+    for (int k = 0; k < 4; k++) {
+        nibbleLo[k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.nibbleLo[k])));
+        nibbleHi[k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.nibbleHi[k])));
+    }
+
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t pos = offset;
+
+    // Need 32 offsets plus the 3 trailing bytes of the last tag
+    while (pos + 32 + 3 <= size) {
+        __m256i miss = zero;
+
+        for (int k = 0; k < 4; k++) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + k));
+            __m256i lo = _mm256_and_si256(bytes, lowNibble);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), lowNibble);
+            __m256i classes = _mm256_and_si256(_mm256_shuffle_epi8(nibbleLo[k], lo),
+                                               _mm256_shuffle_epi8(nibbleHi[k], hi));
+            miss = _mm256_or_si256(miss, _mm256_cmpeq_epi8(classes, zero));
+        }
+
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(miss));
+        if (mask) {
+            size_t found = ConfirmCandidates(data, size, pos, mask);
+            if (found != size) {
+                return found;
+            }
+        }
+        pos += 32;
+    }
+
+    return FindNextTagScalar(data, size, pos);
+}
+
+#else
+
+size_t TagScanner::FindNextTagSSE2(const uint8_t* data, size_t size, size_t offset) {
+    return FindNextTagScalar(data, size, offset);
+}
+
+size_t TagScanner::FindNextTagAVX2(const uint8_t* data, size_t size, size_t offset) {
+    return FindNextTagScalar(data, size, offset);
+}
+
+#endif
@@ -0,0 +1,208 @@
+#include "QuantizedPositions.h"
+#include "ByteSwap.h"
+#include <algorithm>
+#include <cmath>
+
+PackedVertexKernel::CompressionParams QuantizedPositions::IdentityParams() {
+    PackedVertexKernel::CompressionParams params;
+    for (int axis = 0; axis < 3; axis++) {
+        params.scale[axis] = 1.0f;
+        params.offset[axis] = 0.0f;
+    }
+    return params;
+}
+
+size_t QuantizedPositions::GetVertexSize(PositionEncoding encoding) {
+    switch (encoding) {
+        case PositionEncoding::Int16:   return PackedVertexKernel::COMPRESSED_VERTEX_SIZE;
+        case PositionEncoding::Int32:   return PackedVertexKernel::INT32_VERTEX_SIZE;
+        case PositionEncoding::Float16: return PackedVertexKernel::HALF_VERTEX_SIZE;
+        default:                        return 3 * sizeof(float);
+    }
+}
+
+namespace {
+    double GetIntegerLimit(PositionEncoding encoding) {
+        return encoding == PositionEncoding::Int16 ? 32767.0 : 2147483647.0;
+    }
+
+    float GetGridDivisor(PositionGrid grid) {
+        return grid == PositionGrid::Tenths ? 10.0f : 100.0f;
+    }
+}
+
+bool QuantizedPositions::FitsGrid(const ConstAttributeSpan axes[3], PositionGrid grid, PositionEncoding encoding) {
+    double limit = GetIntegerLimit(encoding);
+    float divisor = GetGridDivisor(grid);
+
+    // int16 hundredths decode with the cDot kernel, which reads -1 as an unused axis
+    bool reservesMarker = encoding == PositionEncoding::Int16 && grid == PositionGrid::Hundredths;
+    for (int axis = 0; axis < 3; axis++) {
+        for (size_t i = 0; i < axes[axis].size(); i++) {
+            float value = axes[axis][i];
+            double steps = std::nearbyint(static_cast<double>(value) * divisor);
+            if (steps > limit || steps < -limit - 1.0 || (reservesMarker && steps == -1.0)) {
+                return false;
+            }
+            float decoded = static_cast<float>(static_cast<int32_t>(steps)) / divisor;
+            if (decoded != value || std::signbit(decoded) != std::signbit(value)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool QuantizedPositions::Encode(ConstAttributeSpan x, ConstAttributeSpan y, ConstAttributeSpan z,
+                                PositionEncoding encoding) {
+    Clear();
+    if (encoding == PositionEncoding::Float32 || x.size() != y.size() || x.size() != z.size()) {
+        return false;
+    }
+
+    size_t count = x.size();
+    const ConstAttributeSpan axes[3] = { x, y, z };
+
+    // Bounds per axis; quantising NaN or infinity has no meaning
+    double minimum[3] = { 0.0, 0.0, 0.0 };
+    double maximum[3] = { 0.0, 0.0, 0.0 };
+    for (int axis = 0; axis < 3; axis++) {
+        for (size_t i = 0; i < count; i++) {
+            float value = axes[axis][i];
+            if (!std::isfinite(value)) {
+                return false;
+            }
+            if (i == 0 || value < minimum[axis]) minimum[axis] = value;
+            if (i == 0 || value > maximum[axis]) maximum[axis] = value;
+        }
+    }
+
+    // Dot2 tenths and cDot hundredths are kept as stored when they fit, tenths first for the range
+    PositionGrid grid = PositionGrid::None;
+    if (encoding != PositionEncoding::Float16) {
+        if (FitsGrid(axes, PositionGrid::Tenths, encoding)) {
+            grid = PositionGrid::Tenths;
+        } else if (FitsGrid(axes, PositionGrid::Hundredths, encoding)) {
+            grid = PositionGrid::Hundredths;
+        }
+    }
+
+    PackedVertexKernel::CompressionParams params = IdentityParams();
+    double limit = GetIntegerLimit(encoding);
+    for (int axis = 0; axis < 3; axis++) {
+        if (grid != PositionGrid::None) {
+            params.scale[axis] = 1.0f / GetGridDivisor(grid);
+            continue;
+        }
+
+        // Centre offset; the scale maps the largest half-extent onto the integer range
+        params.offset[axis] = static_cast<float>((minimum[axis] + maximum[axis]) * 0.5);
+        double extent = std::max(maximum[axis] - params.offset[axis], params.offset[axis] - minimum[axis]);
+
+        if (encoding == PositionEncoding::Float16) {
+            if (extent >= 65504.0) {
+                return false;
+            }
+        } else if (extent > 0.0) {
+            params.scale[axis] = static_cast<float>(extent / limit);
+            if (params.scale[axis] == 0.0f) {
+                params.scale[axis] = 1.0f;
+            }
+        }
+    }
+
+    size_t vertexSize = GetVertexSize(encoding);
+    data_.resize(count * vertexSize);
+    uint8_t* out = data_.data();
+    for (size_t i = 0; i < count; i++, out += vertexSize) {
+        for (int axis = 0; axis < 3; axis++) {
+            double relative = static_cast<double>(axes[axis][i]) - params.offset[axis];
+            if (encoding == PositionEncoding::Float16) {
+                uint16_t half = PackedVertexKernel::FloatToHalf(static_cast<float>(relative));
+                ByteSwap::WriteLittleEndian16(out + axis * 2, half);
+                continue;
+            }
+
+            // On a grid the steps are exact (FitsGrid), over the bounds they are rounded
+            double steps = grid != PositionGrid::None ? std::nearbyint(relative * GetGridDivisor(grid))
+                                                      : std::nearbyint(relative / params.scale[axis]);
+            steps = std::min(limit, std::max(-limit - 1.0, steps));
+            if (encoding == PositionEncoding::Int32) {
+                ByteSwap::WriteLittleEndian32(out + axis * 4, static_cast<uint32_t>(static_cast<int32_t>(steps)));
+            } else {
+                ByteSwap::WriteLittleEndian16(out + axis * 2, static_cast<uint16_t>(static_cast<int16_t>(steps)));
+            }
+        }
+    }
+
+    encoding_ = encoding;
+    grid_ = grid;
+    params_ = params;
+    count_ = count;
+    return true;
+}
+
+void QuantizedPositions::Clear(bool keepCapacity) {
+    data_.clear();
+    if (!keepCapacity) {
+        data_.shrink_to_fit();
+    }
+    encoding_ = PositionEncoding::Float32;
+    grid_ = PositionGrid::None;
+    params_ = IdentityParams();
+    count_ = 0;
+}
+
+float QuantizedPositions::DecodeValue(const uint8_t* vertex, int axis) const {
+    if (encoding_ == PositionEncoding::Float16) {
+        return params_.offset[axis] + PackedVertexKernel::HalfToFloat(ByteSwap::ReadLittleEndian16(vertex + axis * 2)) * params_.scale[axis];
+    }
+
+    int32_t steps = encoding_ == PositionEncoding::Int32
+        ? static_cast<int32_t>(ByteSwap::ReadLittleEndian32(vertex + axis * 4))
+        : static_cast<int16_t>(ByteSwap::ReadLittleEndian16(vertex + axis * 2));
+    if (grid_ != PositionGrid::None) {
+        return static_cast<float>(steps) / GetGridDivisor(grid_);
+    }
+    return params_.offset[axis] + static_cast<float>(steps) * params_.scale[axis];
+}
+
+void QuantizedPositions::GetPosition(size_t index, float position[3]) const {
+    if (index >= count_) {
+        position[0] = position[1] = position[2] = 0.0f;
+        return;
+    }
+
+    // Same arithmetic as the bulk kernels
+    const uint8_t* in = data_.data() + index * GetVertexSize();
+    for (int axis = 0; axis < 3; axis++) {
+        position[axis] = DecodeValue(in, axis);
+    }
+}
+
+size_t QuantizedPositions::Decode(size_t first, size_t count, float* output, size_t outputStride) const {
+    if (first >= count_ || !output || encoding_ == PositionEncoding::Float32) {
+        return 0;
+    }
+    count = std::min(count, count_ - first);
+
+    // Kernels where one matches the storage, the scalar decode for the other grids
+    const uint8_t* in = data_.data() + first * GetVertexSize();
+    if (encoding_ == PositionEncoding::Int16 && grid_ == PositionGrid::None) {
+        PackedVertexKernel::DecompressVertices(params_, in, output, outputStride, count);
+    } else if (encoding_ == PositionEncoding::Int16 && grid_ == PositionGrid::Hundredths) {
+        PackedVertexKernel::ConvertShortVertices(in, output, outputStride, count);
+    } else if (encoding_ == PositionEncoding::Int32 && grid_ == PositionGrid::Tenths) {
+        PackedVertexKernel::ConvertVertices(in, PackedVertexKernel::ByteOrder::LittleEndian, output, outputStride, count);
+    } else if (encoding_ == PositionEncoding::Float16) {
+        PackedVertexKernel::DequantizeHalfVertices(params_, in, output, outputStride, count);
+    } else {
+        size_t vertexSize = GetVertexSize();
+        for (size_t i = 0; i < count; i++, in += vertexSize, output += outputStride) {
+            for (int axis = 0; axis < 3; axis++) {
+                output[axis] = DecodeValue(in, axis);
+            }
+        }
+    }
+    return count;
+}
@@ -1,14 +1,62 @@
 #include "ShapeData.h"
 #include "SurfaceData.h"
 #include "AnimationData.h"
+#include "ErrorHandler.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 
-ShapeData::ShapeData() 
-    : vertexCount_(0)
+namespace {
+    /**
+     * Stream of a shape being decoded on this thread
+     */
+    struct DecodingStream {
+        const void* shape;
+        size_t stream;
+        bool outOfOrder;        // Its decoder reached a later stream of the shape
+    };
+    
+    // Streams being decoded on this thread, innermost last
+    thread_local std::vector<DecodingStream> t_decodingStreams;
+    
+    /**
+     * Get the innermost stream of a shape being decoded on this thread, nullptr if none
+     */
+    DecodingStream* FindDecodingStream(const void* shape) {
+        for (auto it = t_decodingStreams.rbegin(); it != t_decodingStreams.rend(); ++it) {
+            if (it->shape == shape) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+    
+    /**
+     * Marks a stream as being decoded on this thread for the scope's lifetime
+     */
+    class DecodingScope {
+    public:
+        DecodingScope(const void* shape, size_t stream) { t_decodingStreams.push_back(DecodingStream{shape, stream, false}); }
+        ~DecodingScope() { t_decodingStreams.pop_back(); }
+        
+        DecodingScope(const DecodingScope&) = delete;
+        DecodingScope& operator=(const DecodingScope&) = delete;
+        
+        bool IsOutOfOrder() const { return t_decodingStreams.back().outOfOrder; }
+    };
+}
+
+ShapeData::ShapeData(std::pmr::memory_resource* resource) 
+    : vertexBuffer_(resource)
+    , vertexFormat_(VertexFormat::Legacy())
+    , vertexLayout_(VertexLayout::Interleaved)
+    , positionEncoding_(PositionEncoding::Float32)
+    , vertexCount_(0)
+    , primitiveBuffer_(resource)
     , primitiveCount_(0)
     , shapeFlags_(0)
     , textureId_(-1)
+    , hasBoundingBox_(false)
     , isInitialized_(false) {
     
     // Initialize bounding box to invalid state
@@ -20,12 +68,191 @@ ShapeData::~ShapeData() {
 }
 
 void ShapeData::AllocateVertexBuffer(size_t vertexCount) {
-    // RFC validated: 8 floats per vertex (X,Y,Z + 5 additional data)
-    size_t floatCount = vertexCount * 8;
-    vertexBuffer_.resize(floatCount);
+    // Stride follows the format: 8 floats for the RFC layout, 3 for positions only
+    size_t floatCount = vertexCount * vertexFormat_.GetFloatStride();
+    vertexBuffer_.assign(floatCount + 1, 0.0f);
     vertexCount_ = vertexCount;
 }
 
+void ShapeData::SetVertexCount(size_t count) {
+    vertexCount_ = count;
+    
+    // Decode finished: move the interleaved output into the streams
+    if (vertexLayout_ == VertexLayout::SoA && !vertexBuffer_.empty()) {
+        vertexStreams_.FromInterleaved(vertexBuffer_.data(), vertexFormat_, vertexCount_);
+        vertexBuffer_.clear();
+        vertexBuffer_.shrink_to_fit();
+    }
+    
+    // Quantised mode: positions leave the float storage once decoded
+    if (positionEncoding_ != PositionEncoding::Float32 && vertexFormat_.Has(VertexAttribute::X)) {
+        QuantizePositions();
+    }
+}
+
+bool ShapeData::SetPositionEncoding(PositionEncoding encoding) {
+    DecodeStream(ShapeStream::Positions);
+    if (encoding == positionEncoding_) {
+        return true;
+    }
+    
+    // Back to floats first, quantised encodings are converted through them
+    if (quantizedPositions_.GetEncoding() != PositionEncoding::Float32) {
+        RestorePositions();
+    }
+    positionEncoding_ = encoding;
+    
+    if (encoding != PositionEncoding::Float32 && vertexFormat_.Has(VertexAttribute::X)) {
+        return QuantizePositions();
+    }
+    return true;
+}
+
+bool ShapeData::QuantizePositions() {
+    // Nothing decoded yet: the format keeps its positions for the decoder
+    if (vertexCount_ == 0) {
+        return true;
+    }
+    
+    const ShapeData& shape = *this;
+    if (!quantizedPositions_.Encode(shape.GetAttribute(VertexAttribute::X), shape.GetAttribute(VertexAttribute::Y),
+                                    shape.GetAttribute(VertexAttribute::Z), positionEncoding_)) {
+        return ErrorHandler::PostEvent(0x6A, "Vertex positions cannot be quantised, keeping float positions");
+    }
+    
+    VertexFormat format = vertexFormat_;
+    format.Remove(VertexAttribute::X).Remove(VertexAttribute::Y).Remove(VertexAttribute::Z);
+    SetVertexFormat(format);
+    return true;
+}
+
+void ShapeData::RestorePositions() {
+    SetVertexFormat(VertexFormat::Union(vertexFormat_, VertexFormat::Positions()));
+    
+    if (vertexLayout_ == VertexLayout::Interleaved) {
+        // X/Y/Z are the first attributes of every format, decode in place
+        quantizedPositions_.Decode(0, vertexCount_, vertexBuffer_.data(), vertexFormat_.GetFloatStride());
+    } else {
+        float* streams[3] = { vertexStreams_.GetStream(VertexAttribute::X), vertexStreams_.GetStream(VertexAttribute::Y),
+                              vertexStreams_.GetStream(VertexAttribute::Z) };
+        float block[3 * 256];
+        for (size_t first = 0; first < vertexCount_; first += 256) {
+            size_t count = quantizedPositions_.Decode(first, 256, block, 3);
+            for (size_t i = 0; i < count; i++) {
+                streams[0][first + i] = block[i * 3 + 0];
+                streams[1][first + i] = block[i * 3 + 1];
+                streams[2][first + i] = block[i * 3 + 2];
+            }
+        }
+    }
+    quantizedPositions_.Clear();
+}
+
+void ShapeData::GetPosition(size_t index, float position[3]) const {
+    if (IsPositionQuantized()) {
+        quantizedPositions_.GetPosition(index, position);
+        return;
+    }
+    
+    ConstAttributeSpan x = GetAttribute(VertexAttribute::X);
+    if (index >= x.size()) {
+        position[0] = position[1] = position[2] = 0.0f;
+        return;
+    }
+    position[0] = x[index];
+    position[1] = GetAttribute(VertexAttribute::Y)[index];
+    position[2] = GetAttribute(VertexAttribute::Z)[index];
+}
+
+size_t ShapeData::DecodePositions(size_t first, size_t count, float* output, size_t outputStride) const {
+    if (IsPositionQuantized()) {
+        return quantizedPositions_.Decode(first, count, output, outputStride);
+    }
+    
+    ConstAttributeSpan x = GetAttribute(VertexAttribute::X);
+    ConstAttributeSpan y = GetAttribute(VertexAttribute::Y);
+    ConstAttributeSpan z = GetAttribute(VertexAttribute::Z);
+    if (first >= x.size() || !output) {
+        return 0;
+    }
+    count = std::min(count, x.size() - first);
+    for (size_t i = 0; i < count; i++, output += outputStride) {
+        output[0] = x[first + i];
+        output[1] = y[first + i];
+        output[2] = z[first + i];
+    }
+    return count;
+}
+
+size_t ShapeData::GetVertexByteCount() const {
+    DecodeStream(ShapeStream::Positions);
+    size_t bytes = vertexBuffer_.size() * sizeof(float) + quantizedPositions_.GetByteCount();
+    for (size_t a = 0; a < VertexStreams::ATTRIBUTE_COUNT; a++) {
+        if (vertexStreams_.GetStream(static_cast<VertexAttribute>(a))) {
+            bytes += vertexStreams_.GetCount() * sizeof(float);
+        }
+    }
+    return bytes;
+}
+
+void ShapeData::SetVertexLayout(VertexLayout layout) {
+    DecodeStream(ShapeStream::Positions);
+    if (layout == vertexLayout_) {
+        return;
+    }
+    
+    vertexLayout_ = layout;
+    if (layout == VertexLayout::SoA) {
+        vertexStreams_.FromInterleaved(vertexBuffer_.data(), vertexFormat_, vertexCount_);
+        vertexBuffer_.clear();
+        vertexBuffer_.shrink_to_fit();
+    } else {
+        vertexBuffer_.resize(vertexCount_ * vertexFormat_.GetFloatStride());
+        vertexStreams_.ToInterleaved(vertexBuffer_.data(), vertexFormat_);
+        vertexStreams_.Clear();
+    }
+}
+
+void ShapeData::SetVertexFormat(const VertexFormat& format) {
+    DecodeStream(ShapeStream::Positions);
+    if (format == vertexFormat_) {
+        return;
+    }
+    
+    if (vertexLayout_ == VertexLayout::SoA) {
+        // Streams of kept attributes stay, dropped ones are released
+        vertexStreams_.Resize(vertexStreams_.GetCount(), format);
+    } else if (vertexCount_ > 0 && vertexBuffer_.size() >= vertexCount_ * vertexFormat_.GetFloatStride()) {
+        // Also taken for an empty buffer of a position-only shape whose positions are quantised
+        std::pmr::vector<float> converted(vertexCount_ * format.GetFloatStride(), 0.0f, vertexBuffer_.get_allocator());
+        VertexFormat::Convert(vertexBuffer_.data(), vertexFormat_, converted.data(), format, vertexCount_);
+        vertexBuffer_.swap(converted);
+    }
+    vertexFormat_ = format;
+    vertexStride = static_cast<uint32_t>(format.GetFloatStride());
+}
+
+AttributeSpan ShapeData::GetAttribute(VertexAttribute attribute) {
+    DecodeStream(ShapeStream::Positions);
+    if (vertexLayout_ == VertexLayout::SoA) {
+        float* stream = vertexStreams_.GetStream(attribute);
+        return stream ? AttributeSpan(stream, 1, vertexStreams_.GetCount()) : AttributeSpan();
+    }
+    if (vertexBuffer_.empty()) {
+        return AttributeSpan();
+    }
+    if (!vertexFormat_.Has(attribute)) {
+        return AttributeSpan();
+    }
+    return AttributeSpan(vertexBuffer_.data() + vertexFormat_.GetFloatOffset(attribute),
+                         vertexFormat_.GetFloatStride(), vertexCount_);
+}
+
+ConstAttributeSpan ShapeData::GetAttribute(VertexAttribute attribute) const {
+    AttributeSpan span = const_cast<ShapeData&>(*this).GetAttribute(attribute);
+    return ConstAttributeSpan(span.data(), span.stride, span.size());
+}
+
 void ShapeData::AllocatePrimitiveBuffer(size_t primitiveCount) {
     // Allocate primitive index buffer
     primitiveBuffer_.resize(primitiveCount);
@@ -38,7 +265,122 @@ void ShapeData::AddSurface(std::unique_ptr<SurfaceData> surface) {
     }
 }
 
+void ShapeData::DeferChunk(ShapeStream stream, const ChunkHeader& header, ByteSpan data, DeferredDecoder decoder) {
+    if (stream == ShapeStream::Count || !decoder) {
+        return;
+    }
+    
+    // A decoder may only defer chunks of earlier streams (see DecodeStream)
+    DecodingStream* decoding = FindDecodingStream(this);
+    if (decoding && static_cast<size_t>(stream) >= decoding->stream) {
+        decoding->outOfOrder = true;
+        ErrorHandler::PostEvent(0x6A, "Deferred decoder deferred a chunk of its own or a later stream");
+        return;
+    }
+    
+    LazyStream& lazy = streams_[static_cast<size_t>(stream)];
+    std::lock_guard<std::mutex> lock(lazy.mutex);
+    
+    DeferredChunk chunk;
+    chunk.header = header;
+    chunk.data = data;
+    chunk.decoder = std::move(decoder);
+    lazy.pending.push_back(std::move(chunk));
+    lazy.decoded.store(false, std::memory_order_release);
+}
+
+bool ShapeData::DecodeStream(ShapeStream stream) const {
+    if (stream == ShapeStream::Count) {
+        return true;
+    }
+    
+    LazyStream& lazy = streams_[static_cast<size_t>(stream)];
+    
+    // Fast path: already decoded (or nothing was deferred)
+    if (lazy.decoded.load(std::memory_order_acquire)) {
+        return lazy.succeeded;
+    }
+    
+    // Inside a decoder of this shape only earlier streams are decoded. A later
+    // stream may be half way through its own decode further up this thread's
+    // stack, or locked by another thread waiting for this one; it fails the
+    // calling decoder's stream instead of handing out partial data.
+    size_t index = static_cast<size_t>(stream);
+    DecodingStream* decoding = FindDecodingStream(this);
+    if (decoding) {
+        if (index == decoding->stream) {
+            return true;    // The decoder filling this stream
+        }
+        if (index > decoding->stream) {
+            decoding->outOfOrder = true;
+            return ErrorHandler::PostEvent(0x6A, "Deferred decoder accessed a later stream of its shape");
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(lazy.mutex);
+    if (lazy.decoded.load(std::memory_order_relaxed)) {
+        return lazy.succeeded;
+    }
+    
+    // Decoders mutate the shape; const accessors only memoise the result
+    ShapeData& shape = const_cast<ShapeData&>(*this);
+    bool succeeded = true;
+    {
+        DecodingScope scope(this, index);
+        for (const auto& chunk : lazy.pending) {
+            if (!chunk.decoder(chunk.header, chunk.data, shape)) {
+                succeeded = false;
+            }
+        }
+        if (scope.IsOutOfOrder()) {
+            succeeded = false;
+        }
+    }
+    
+    lazy.pending.clear();
+    lazy.pending.shrink_to_fit();
+    lazy.succeeded = succeeded;
+    lazy.decoded.store(true, std::memory_order_release);
+    
+    return succeeded;
+}
+
+bool ShapeData::DecodeAll() const {
+    bool succeeded = true;
+    for (size_t i = 0; i < static_cast<size_t>(ShapeStream::Count); i++) {
+        succeeded &= DecodeStream(static_cast<ShapeStream>(i));
+    }
+    return succeeded;
+}
+
+bool ShapeData::IsStreamDecoded(ShapeStream stream) const {
+    if (stream == ShapeStream::Count) {
+        return true;
+    }
+    return streams_[static_cast<size_t>(stream)].decoded.load(std::memory_order_acquire);
+}
+
+ShapeStream ShapeData::GetStreamForChunk(ChunkType type) {
+    switch (type) {
+        case ChunkType::Dot2:
+        case ChunkType::FDot:
+        case ChunkType::Dots:
+        case ChunkType::cDot:
+            return ShapeStream::Positions;
+        case ChunkType::Prim:
+            return ShapeStream::Primitives;
+        case ChunkType::Line:
+            return ShapeStream::Surfaces;
+        case ChunkType::soPF:
+        case ChunkType::FPos:
+            return ShapeStream::Animation;
+        default:
+            return ShapeStream::Count;
+    }
+}
+
 const SurfaceData* ShapeData::GetSurface(size_t index) const {
+    DecodeStream(ShapeStream::Surfaces);
     if (index >= surfaces_.size()) {
         return nullptr;
     }
@@ -54,19 +396,149 @@ void ShapeData::SetAnimationData(std::unique_ptr<AnimationData> animData) {
 
 void ShapeData::SetBoundingBox(const float minMax[6]) {
     std::memcpy(boundingBox_, minMax, sizeof(boundingBox_));
+    hasBoundingBox_ = true;
+}
+
+bool ShapeData::MergeSlice(ShapeData& slice, size_t vertexBase) {
+    slice.DecodeAll();
+    
+    // Quantised positions are merged as floats and re-quantised over the merged bounds
+    if (slice.IsPositionQuantized()) {
+        slice.RestorePositions();
+    }
+    if (IsPositionQuantized()) {
+        RestorePositions();
+    }
+    
+    // Vertices: appended in chunk order, converted if layouts or formats differ
+    if (slice.vertexCount_ > 0) {
+        // The format widens to cover the slice's attributes (an empty shape adopts them)
+        SetVertexFormat(vertexCount_ == 0 ? slice.vertexFormat_ 
+                                          : VertexFormat::Union(vertexFormat_, slice.vertexFormat_));
+        
+        size_t stride = vertexFormat_.GetFloatStride();
+        if (vertexLayout_ == VertexLayout::Interleaved && slice.vertexLayout_ == VertexLayout::Interleaved &&
+            slice.vertexFormat_ == vertexFormat_) {
+            vertexBuffer_.resize(vertexCount_ * stride);
+            vertexBuffer_.insert(vertexBuffer_.end(), slice.vertexBuffer_.begin(),
+                                 slice.vertexBuffer_.begin() + slice.vertexCount_ * stride);
+            vertexCount_ += slice.vertexCount_;
+        } else {
+            size_t base = vertexCount_;
+            vertexCount_ += slice.vertexCount_;
+            if (vertexLayout_ == VertexLayout::SoA) {
+                vertexStreams_.Resize(vertexCount_, vertexFormat_);
+            } else {
+                vertexBuffer_.resize(vertexCount_ * stride);
+            }
+            
+            const ShapeData& source = slice;
+            for (size_t a = 0; a < VertexStreams::ATTRIBUTE_COUNT; a++) {
+                VertexAttribute attribute = static_cast<VertexAttribute>(a);
+                AttributeSpan out = GetAttribute(attribute);
+                ConstAttributeSpan in = source.GetAttribute(attribute);
+                for (size_t i = 0; i < in.size(); i++) {
+                    out[base + i] = in[i];
+                }
+            }
+        }
+    }
+    
+    if (positionEncoding_ != PositionEncoding::Float32 && vertexFormat_.Has(VertexAttribute::X)) {
+        QuantizePositions();
+    }
+    
+    // Primitives: rebase indices onto the referenced vertex chunk
+    bool indicesFit = true;
+    if (slice.primitiveCount_ > 0) {
+        primitiveBuffer_.resize(primitiveCount_);
+        primitiveBuffer_.reserve(primitiveCount_ + slice.primitiveCount_);
+        for (size_t i = 0; i < slice.primitiveCount_; i++) {
+            size_t index = vertexBase + slice.primitiveBuffer_[i];
+            if (index > 0xFFFF) {
+                indicesFit = false;
+                index = 0xFFFF;
+            }
+            primitiveBuffer_.push_back(static_cast<uint16_t>(index));
+        }
+        primitiveCount_ += slice.primitiveCount_;
+    }
+    
+    for (auto& surface : slice.surfaces_) {
+        surfaces_.push_back(std::move(surface));
+    }
+    
+    if (slice.animationData_) {
+        animationData_ = std::move(slice.animationData_);
+    }
+    
+    // Bounds grow to cover the slice
+    if (slice.hasBoundingBox_) {
+        if (!hasBoundingBox_) {
+            SetBoundingBox(slice.boundingBox_);
+        } else {
+            for (int axis = 0; axis < 3; axis++) {
+                boundingBox_[axis] = std::min(boundingBox_[axis], slice.boundingBox_[axis]);
+                boundingBox_[3 + axis] = std::max(boundingBox_[3 + axis], slice.boundingBox_[3 + axis]);
+            }
+        }
+    }
+    
+    shapeFlags_.fetch_or(slice.shapeFlags_);
+    if (textureId_ == -1) {
+        textureId_ = slice.textureId_;
+    }
+    
+    slice.Reset();
+    
+    if (!indicesFit) {
+        return ErrorHandler::PostEvent(0x6A, "Rebased primitive index exceeds 16-bit range");
+    }
+    return true;
 }
 
 bool ShapeData::IsValid() const {
+    if (textureId_ < -1) return false;  // -1 is valid (no texture)
+    
+    // Deferred positions are validated when they are decoded, not here
+    if (!IsStreamDecoded(ShapeStream::Positions)) return true;
+    
     // Basic validation checks
     if (vertexCount_ == 0) return false;
-    if (vertexBuffer_.size() != vertexCount_ * 8) return false;  // RFC validated: 8 floats per vertex
-    if (textureId_ < -1) return false;  // -1 is valid (no texture)
+    if (vertexLayout_ == VertexLayout::SoA) {
+        if (vertexStreams_.GetCount() != vertexCount_) return false;
+    } else {
+        // Decoded buffers may carry the terminator float after the last vertex
+        if (vertexBuffer_.size() < vertexCount_ * vertexFormat_.GetFloatStride()) return false;
+    }
+    if (IsPositionQuantized() && quantizedPositions_.GetCount() != vertexCount_) return false;
     
     return true;
 }
 
 void ShapeData::Reset() {
+    Clear(false);
+}
+
+void ShapeData::Recycle() {
+    Clear(true);
+    vertexLayout_ = VertexLayout::Interleaved;
+    positionEncoding_ = PositionEncoding::Float32;
+}
+
+void ShapeData::Clear(bool keepCapacity) {
+    for (auto& lazy : streams_) {
+        std::lock_guard<std::mutex> lock(lazy.mutex);
+        lazy.pending.clear();
+        lazy.succeeded = true;
+        lazy.decoded.store(true, std::memory_order_release);
+    }
+    
     vertexBuffer_.clear();
+    vertexStreams_.Clear(keepCapacity);
+    quantizedPositions_.Clear(keepCapacity);
+    vertexFormat_ = VertexFormat::Legacy();
+    vertexStride = static_cast<uint32_t>(vertexFormat_.GetFloatStride());
     primitiveBuffer_.clear();
     surfaces_.clear();
     animationData_.reset();
@@ -76,14 +548,15 @@ void ShapeData::Reset() {
     shapeFlags_ = 0;
     textureId_ = -1;
     std::memset(boundingBox_, 0, sizeof(boundingBox_));
+    hasBoundingBox_ = false;
     isInitialized_ = false;
 }
 
 void ShapeData::PrintDebugInfo() const {
     std::cout << "ShapeData Debug Info:\n";
-    std::cout << "  Vertices: " << vertexCount_ << "\n";
-    std::cout << "  Primitives: " << primitiveCount_ << "\n";
-    std::cout << "  Surfaces: " << surfaces_.size() << "\n";
+    std::cout << "  Vertices: " << GetVertexCount() << "\n";
+    std::cout << "  Primitives: " << GetPrimitiveCount() << "\n";
+    std::cout << "  Surfaces: " << GetSurfaceCount() << "\n";
     std::cout << "  Texture ID: " << textureId_ << "\n";
     std::cout << "  Flags: 0x" << std::hex << shapeFlags_ << std::dec << "\n";
     std::cout << "  Line Processed: " << (IsLineProcessed() ? "Yes" : "No") << "\n";
@@ -0,0 +1,67 @@
+#include "ShapeDataPool.h"
+
+void ShapeDataPool::Releaser::operator()(ShapeData* shape) const {
+    if (pool) {
+        pool->Release(shape);
+    } else {
+        delete shape;
+    }
+}
+
+ShapeDataPool::ShapeDataPool(size_t maxPooled, std::pmr::memory_resource* resource)
+    : maxPooled_(maxPooled), resource_(resource), reuseCount_(0) {
+    idle_.reserve(maxPooled);
+}
+
+ShapeDataPool::Handle ShapeDataPool::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            ShapeData* shape = idle_.back().release();
+            idle_.pop_back();
+            reuseCount_++;
+            return Handle(shape, Releaser{this});
+        }
+    }
+    return Handle(new ShapeData(resource_), Releaser{this});
+}
+
+void ShapeDataPool::Release(ShapeData* shape) {
+    if (!shape) {
+        return;
+    }
+
+    // Recycled outside the lock, it may free surfaces and animation data
+    shape->Recycle();
+
+    std::unique_ptr<ShapeData> owned(shape);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < maxPooled_) {
+            idle_.push_back(std::move(owned));
+        }
+    }
+    // No room in the pool: destroyed here, after the lock is released
+    owned.reset();
+}
+
+void ShapeDataPool::Trim(size_t keep) {
+    std::vector<std::unique_ptr<ShapeData>> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (idle_.size() > keep) {
+            released.push_back(std::move(idle_.back()));
+            idle_.pop_back();
+        }
+    }
+}
+
+size_t ShapeDataPool::GetIdleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+size_t ShapeDataPool::GetReuseCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reuseCount_;
+}
@@ -0,0 +1,121 @@
+#include "VertexFormat.h"
+
+VertexFormat::VertexFormat() : presentMask_(0), stride_(0) {
+    for (size_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+        types_[i] = AttributeType::Float32;
+        offsets_[i] = 0;
+    }
+}
+
+VertexFormat VertexFormat::Legacy() {
+    VertexFormat format;
+    for (size_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+        format.Add(static_cast<VertexAttribute>(i));
+    }
+    return format;
+}
+
+VertexFormat VertexFormat::Positions() {
+    VertexFormat format;
+    format.Add(VertexAttribute::X).Add(VertexAttribute::Y).Add(VertexAttribute::Z);
+    return format;
+}
+
+VertexFormat VertexFormat::Union(const VertexFormat& a, const VertexFormat& b) {
+    VertexFormat format = a;
+    for (size_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+        VertexAttribute attribute = static_cast<VertexAttribute>(i);
+        if (!format.Has(attribute) && b.Has(attribute)) {
+            format.Add(attribute, b.GetType(attribute));
+        }
+    }
+    return format;
+}
+
+VertexFormat& VertexFormat::Add(VertexAttribute attribute, AttributeType type) {
+    size_t index = static_cast<size_t>(attribute);
+    if (index >= ATTRIBUTE_COUNT) {
+        return *this;
+    }
+    presentMask_ |= 1u << index;
+    types_[index] = type;
+    Pack();
+    return *this;
+}
+
+VertexFormat& VertexFormat::Remove(VertexAttribute attribute) {
+    size_t index = static_cast<size_t>(attribute);
+    if (index >= ATTRIBUTE_COUNT) {
+        return *this;
+    }
+    presentMask_ &= ~(1u << index);
+    types_[index] = AttributeType::Float32;
+    Pack();
+    return *this;
+}
+
+size_t VertexFormat::GetAttributeCount() const {
+    size_t count = 0;
+    for (uint32_t mask = presentMask_; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+}
+
+size_t VertexFormat::GetTypeSize(AttributeType type) {
+    switch (type) {
+        case AttributeType::Float32: return 4;
+        default:                     return 0;
+    }
+}
+
+void VertexFormat::Convert(const float* input, const VertexFormat& inputFormat,
+                           float* output, const VertexFormat& outputFormat, size_t vertexCount) {
+    size_t inputStride = inputFormat.GetFloatStride();
+    size_t outputStride = outputFormat.GetFloatStride();
+
+    for (size_t a = 0; a < ATTRIBUTE_COUNT; a++) {
+        VertexAttribute attribute = static_cast<VertexAttribute>(a);
+        if (!outputFormat.Has(attribute)) {
+            continue;
+        }
+
+        float* out = output + outputFormat.GetFloatOffset(attribute);
+        if (!inputFormat.Has(attribute)) {
+            for (size_t i = 0; i < vertexCount; i++, out += outputStride) {
+                *out = 0.0f;
+            }
+            continue;
+        }
+
+        const float* in = input + inputFormat.GetFloatOffset(attribute);
+        for (size_t i = 0; i < vertexCount; i++, in += inputStride, out += outputStride) {
+            *out = *in;
+        }
+    }
+}
+
+bool VertexFormat::operator==(const VertexFormat& other) const {
+    if (presentMask_ != other.presentMask_) {
+        return false;
+    }
+    for (size_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+        if (Has(static_cast<VertexAttribute>(i)) && types_[i] != other.types_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VertexFormat::Pack() {
+    size_t offset = 0;
+    for (size_t i = 0; i < ATTRIBUTE_COUNT; i++) {
+        if (Has(static_cast<VertexAttribute>(i))) {
+            offsets_[i] = static_cast<uint16_t>(offset);
+            offset += GetTypeSize(types_[i]);
+        } else {
+            offsets_[i] = 0;
+        }
+    }
+    stride_ = static_cast<uint16_t>(offset);
+}
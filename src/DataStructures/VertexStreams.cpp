@@ -0,0 +1,65 @@
+#include "VertexStreams.h"
+
+void VertexStreams::Resize(size_t vertexCount, const VertexFormat& format) {
+    for (size_t attribute = 0; attribute < ATTRIBUTE_COUNT; attribute++) {
+        if (format.Has(static_cast<VertexAttribute>(attribute))) {
+            streams_[attribute].resize(vertexCount, 0.0f);
+        } else {
+            streams_[attribute].clear();
+            streams_[attribute].shrink_to_fit();
+        }
+    }
+    format_ = format;
+    count_ = vertexCount;
+}
+
+void VertexStreams::Clear(bool keepCapacity) {
+    for (auto& stream : streams_) {
+        stream.clear();
+        if (!keepCapacity) {
+            stream.shrink_to_fit();
+        }
+    }
+    format_ = VertexFormat();
+    count_ = 0;
+}
+
+float* VertexStreams::GetStream(VertexAttribute attribute) {
+    return format_.Has(attribute) ? streams_[static_cast<size_t>(attribute)].data() : nullptr;
+}
+
+const float* VertexStreams::GetStream(VertexAttribute attribute) const {
+    return format_.Has(attribute) ? streams_[static_cast<size_t>(attribute)].data() : nullptr;
+}
+
+void VertexStreams::FromInterleaved(const float* input, const VertexFormat& format, size_t vertexCount) {
+    Resize(vertexCount, format);
+
+    // One stream at a time keeps each output stream sequential
+    size_t inputStride = format.GetFloatStride();
+    for (size_t attribute = 0; attribute < ATTRIBUTE_COUNT; attribute++) {
+        if (!format.Has(static_cast<VertexAttribute>(attribute))) {
+            continue;
+        }
+        float* out = streams_[attribute].data();
+        const float* in = input + format.GetFloatOffset(static_cast<VertexAttribute>(attribute));
+        for (size_t i = 0; i < vertexCount; i++, in += inputStride) {
+            out[i] = *in;
+        }
+    }
+}
+
+void VertexStreams::ToInterleaved(float* output, const VertexFormat& format) const {
+    size_t outputStride = format.GetFloatStride();
+    for (size_t attribute = 0; attribute < ATTRIBUTE_COUNT; attribute++) {
+        VertexAttribute current = static_cast<VertexAttribute>(attribute);
+        if (!format.Has(current)) {
+            continue;
+        }
+        const float* in = GetStream(current);
+        float* out = output + format.GetFloatOffset(current);
+        for (size_t i = 0; i < count_; i++, out += outputStride) {
+            *out = in ? in[i] : 0.0f;
+        }
+    }
+}
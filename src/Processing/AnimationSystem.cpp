@@ -1,9 +1,11 @@
-#include "../../include_new/AnimationSystem.h"
-#include "../../include_new/ErrorHandler.h"
-#include "../../include_new/ByteSwap.h"
-// #include "../../include_new/GlobalVariables.h" // Skip for now
+#include "AnimationSystem.h"
+#include "ErrorHandler.h"
+#include "ByteSwap.h"
+#include "ByteSpan.h"
+#include "ShapeData.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 /**
@@ -12,7 +14,7 @@
  */
 
 AnimationSystem::AnimationSystem() 
-    : maxBatches_(0), maxKeyframes_(0), systemInitialized_(false),
+    : blendTarget_(nullptr), maxBatches_(0), maxKeyframes_(0), systemInitialized_(false),
       frameInterpolations_(0), lastUpdateTime_(0.0f) {
     // Constructor - system not ready until Initialize() called
 }
@@ -59,6 +61,8 @@ void AnimationSystem::Cleanup() {
     keyframes_.clear();
     sopfChunks_.clear();
     fposChunks_.clear();
+    batchShapes_.clear();
+    blendTarget_ = nullptr;
     
     globals_.systemInitialized = false;
     systemInitialized_ = false;
@@ -313,7 +317,6 @@ bool AnimationSystem::ProcessSoPFChunk(const uint8_t* chunkData, size_t chunkSiz
     SoPFChunkData sopfData;
     
     // Parse soPF chunk header
-    const uint32_t* header = reinterpret_cast<const uint32_t*>(chunkData);
     sopfData.shapeID = ByteSwap::ReadLittleEndian32(chunkData);
     sopfData.propertyCount = ByteSwap::ReadLittleEndian32(chunkData + 4);
     sopfData.timeStamp = *reinterpret_cast<const float*>(chunkData + 8);
@@ -325,9 +328,8 @@ bool AnimationSystem::ProcessSoPFChunk(const uint8_t* chunkData, size_t chunkSiz
         return false;
     }
     
-    // Copy property data
-    sopfData.propertyData.resize(sopfData.dataSize);
-    std::memcpy(sopfData.propertyData.data(), chunkData + 16, sopfData.dataSize);
+    // Property data outlives the chunk buffer, so this is the one place it is copied
+    sopfData.propertyData = ByteSpan(chunkData, chunkSize).subspan(16, sopfData.dataSize).ToVector();
     
     // Store soPF data
     sopfChunks_.push_back(std::move(sopfData));
@@ -437,7 +439,6 @@ bool AnimationSystem::TransformBatchVertices(uint32_t batchIndex) {
         return false;
     }
     
-    const AnimationBatch& batch = batches_[batchIndex];
     std::cout << "🔄 Transforming vertices for batch " << batchIndex << "\n";
     
     // Simplified implementation - would perform actual vertex transformations
@@ -445,7 +446,7 @@ bool AnimationSystem::TransformBatchVertices(uint32_t batchIndex) {
 }
 
 bool AnimationSystem::TransformVertexFromKeyFrame(uint32_t batchIndex, uint32_t targetBatch,
-                                                uint32_t dataOffset, float interpolationFactor) {
+                                                uint32_t /*dataOffset*/, float interpolationFactor) {
     // RFC VALIDATED: Based on transformVertexFromKeyFrame.cpp pattern
     if (batchIndex >= batches_.size() || targetBatch >= batches_.size()) {
         return false;
@@ -454,8 +455,58 @@ bool AnimationSystem::TransformVertexFromKeyFrame(uint32_t batchIndex, uint32_t
     std::cout << "🔄 Interpolating vertices: batch " << batchIndex 
               << " → " << targetBatch << " (factor=" << interpolationFactor << ")\n";
     
-    // Simplified implementation - would perform actual vertex interpolation
     frameInterpolations_++;
+    
+    // Batches without keyframe shapes only count the interpolation
+    const ShapeData* from = GetBatchShape(batchIndex);
+    const ShapeData* to = GetBatchShape(targetBatch);
+    if (!from || !to || !blendTarget_) {
+        return true;
+    }
+    return BlendShapePositions(*from, *to, interpolationFactor, *blendTarget_);
+}
+
+void AnimationSystem::SetBatchShape(uint32_t batchIndex, const ShapeData* shape) {
+    if (batchIndex >= batchShapes_.size()) {
+        batchShapes_.resize(batchIndex + 1, nullptr);
+    }
+    batchShapes_[batchIndex] = shape;
+}
+
+const ShapeData* AnimationSystem::GetBatchShape(uint32_t batchIndex) const {
+    return batchIndex < batchShapes_.size() ? batchShapes_[batchIndex] : nullptr;
+}
+
+bool AnimationSystem::BlendShapePositions(const ShapeData& from, const ShapeData& to, float factor, ShapeData& out) {
+    size_t vertexCount = out.GetVertexCount();
+    if (from.GetVertexCount() != vertexCount || to.GetVertexCount() != vertexCount) {
+        return ErrorHandler::PostEvent(0x504, "Keyframe shapes differ in vertex count");
+    }
+    
+    const VertexAttribute axes[3] = { VertexAttribute::X, VertexAttribute::Y, VertexAttribute::Z };
+    for (VertexAttribute axis : axes) {
+        ConstAttributeSpan a = from.GetAttribute(axis);
+        ConstAttributeSpan b = to.GetAttribute(axis);
+        AttributeSpan result = out.GetAttribute(axis);
+        if (vertexCount > 0 && (a.empty() || b.empty() || result.empty())) {
+            // Quantised positions have no float attribute to blend in place
+            return ErrorHandler::PostEvent(0x504, "Blend shapes need float positions");
+        }
+        
+        if (a.IsContiguous() && b.IsContiguous() && result.IsContiguous()) {
+            // SoA: plain arrays the compiler vectorises
+            const float* pa = a.data();
+            const float* pb = b.data();
+            float* pr = result.data();
+            for (size_t i = 0; i < vertexCount; i++) {
+                pr[i] = pa[i] + (pb[i] - pa[i]) * factor;
+            }
+        } else {
+            for (size_t i = 0; i < vertexCount; i++) {
+                result[i] = a[i] + (b[i] - a[i]) * factor;
+            }
+        }
+    }
     return true;
 }
 
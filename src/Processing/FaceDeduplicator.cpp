@@ -0,0 +1,111 @@
+#include "FaceDeduplicator.h"
+#include "HashMix.h"
+#include <algorithm>
+#include <utility>
+
+FaceDeduplicator::FaceDeduplicator(std::pmr::memory_resource* resource, Winding winding)
+    : slots_(resource), count_(0), winding_(winding) {
+}
+
+void FaceDeduplicator::Reserve(size_t faceCount) {
+    if (faceCount <= GetCapacity()) {
+        return;
+    }
+    size_t slotCount = 16;
+    while (slotCount / 2 < faceCount) {
+        slotCount *= 2;
+    }
+    Rehash(slotCount);
+}
+
+bool FaceDeduplicator::Insert(uint32_t a, uint32_t b, uint32_t c) {
+    if (a == EMPTY || b == EMPTY || c == EMPTY) {
+        return true;    // Cannot be keyed, never a duplicate
+    }
+    if (count_ + 1 > GetCapacity()) {
+        Rehash(std::max<size_t>(16, slots_.size() * 2));
+    }
+
+    Key key = MakeKey(a, b, c);
+    size_t mask = slots_.size() - 1;
+    for (size_t slot = Hash(key) & mask; ; slot = (slot + 1) & mask) {
+        Key& entry = slots_[slot];
+        if (entry.v[0] == EMPTY) {
+            entry = key;
+            count_++;
+            return true;
+        }
+        if (entry.v[0] == key.v[0] && entry.v[1] == key.v[1] && entry.v[2] == key.v[2]) {
+            return false;
+        }
+    }
+}
+
+void FaceDeduplicator::Clear() {
+    if (count_ > 0) {
+        std::fill(slots_.begin(), slots_.end(), Key{{EMPTY, EMPTY, EMPTY}});
+        count_ = 0;
+    }
+}
+
+void FaceDeduplicator::Release() {
+    std::pmr::vector<Key>(slots_.get_allocator().resource()).swap(slots_);
+    count_ = 0;
+}
+
+void FaceDeduplicator::SetWinding(Winding winding) {
+    // Keys of the old mode do not compare with keys of the new one
+    if (winding != winding_) {
+        Clear();
+        winding_ = winding;
+    }
+}
+
+FaceDeduplicator::Key FaceDeduplicator::MakeKey(uint32_t a, uint32_t b, uint32_t c) const {
+    if (winding_ == Winding::Ignore) {
+        if (a > b) std::swap(a, b);
+        if (b > c) std::swap(b, c);
+        if (a > b) std::swap(a, b);
+        return Key{{a, b, c}};
+    }
+
+    // Rotate the smallest index to the front, which keeps the winding
+    if (a < b && a < c) {
+        return Key{{a, b, c}};
+    }
+    if (b < a && b < c) {
+        return Key{{b, c, a}};
+    }
+    if (c < a && c < b) {
+        return Key{{c, a, b}};
+    }
+
+    // Degenerate triangle with a repeated smallest index: smallest rotation
+    Key rotations[3] = {{{a, b, c}}, {{b, c, a}}, {{c, a, b}}};
+    return *std::min_element(rotations, rotations + 3, [](const Key& x, const Key& y) {
+        return std::lexicographical_compare(x.v, x.v + 3, y.v, y.v + 3);
+    });
+}
+
+size_t FaceDeduplicator::Hash(const Key& key) {
+    // Pack the 96 bits into one word, then finalise
+    uint64_t h = (static_cast<uint64_t>(key.v[0]) << 32) | key.v[1];
+    return HashMix::Finalize(HashMix::Combine(h, key.v[2]));
+}
+
+void FaceDeduplicator::Rehash(size_t slotCount) {
+    std::pmr::vector<Key> old(slotCount, Key{{EMPTY, EMPTY, EMPTY}}, slots_.get_allocator().resource());
+    old.swap(slots_);
+
+    size_t mask = slots_.size() - 1;
+    for (const Key& key : old) {
+        if (key.v[0] == EMPTY) {
+            continue;
+        }
+        size_t slot = Hash(key) & mask;
+        while (slots_[slot].v[0] != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = key;
+    }
+}
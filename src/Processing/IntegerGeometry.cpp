@@ -0,0 +1,86 @@
+#include "IntegerGeometry.h"
+#include "HashMix.h"
+#include "VertexDecoder.h"
+#include <algorithm>
+#include <unordered_map>
+
+size_t IntegerVertexHash::operator()(const IntegerVertex& vertex) const {
+    // Combine the three coordinates, then finalise so nearby grid points
+    // spread over the whole table
+    uint64_t h = static_cast<uint64_t>(vertex.x);
+    h = HashMix::Combine(h, static_cast<uint64_t>(vertex.y));
+    h = HashMix::Combine(h, static_cast<uint64_t>(vertex.z));
+    return HashMix::Finalize(h);
+}
+
+void IntegerGeometry::DecodeDot2(const uint8_t* records, size_t vertexCount, IntegerVertexArray& positions) {
+    using VertexDecoding::ReadComponent;
+    const auto order = VertexDecoding::ByteOrder::BigEndian;
+
+    size_t first = positions.size();
+    positions.resize(first + vertexCount);
+    IntegerVertex* out = positions.data() + first;
+    for (size_t i = 0; i < vertexCount; i++, records += 12) {
+        out[i].x = static_cast<int64_t>(ReadComponent<order, int32_t>(records + 0)) * 10;
+        out[i].y = static_cast<int64_t>(ReadComponent<order, int32_t>(records + 4)) * 10;
+        out[i].z = static_cast<int64_t>(ReadComponent<order, int32_t>(records + 8)) * 10;
+    }
+}
+
+void IntegerGeometry::DecodeCDot(const uint8_t* records, size_t vertexCount, IntegerVertexArray& positions) {
+    using VertexDecoding::ReadComponent;
+    const auto order = VertexDecoding::ByteOrder::LittleEndian;
+
+    // -1 marks an unused axis, decoded as 0 like the float path does
+    auto read = [](const uint8_t* data) {
+        int16_t value = ReadComponent<order, int16_t>(data);
+        return value != -1 ? static_cast<int64_t>(value) : 0;
+    };
+
+    size_t first = positions.size();
+    positions.resize(first + vertexCount);
+    IntegerVertex* out = positions.data() + first;
+    for (size_t i = 0; i < vertexCount; i++, records += 6) {
+        out[i].x = read(records + 0);
+        out[i].y = read(records + 2);
+        out[i].z = read(records + 4);
+    }
+}
+
+size_t IntegerGeometry::Weld(const IntegerVertexArray& positions, IntegerVertexArray& unique,
+                             std::pmr::vector<uint32_t>& remap) {
+    unique.clear();
+    unique.reserve(positions.size());
+    remap.resize(positions.size());
+
+    std::pmr::unordered_map<IntegerVertex, uint32_t, IntegerVertexHash> indices(unique.get_allocator().resource());
+    indices.reserve(positions.size());
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        auto inserted = indices.emplace(positions[i], static_cast<uint32_t>(unique.size()));
+        if (inserted.second) {
+            unique.push_back(positions[i]);
+        }
+        remap[i] = inserted.first->second;
+    }
+    return unique.size();
+}
+
+bool IntegerGeometry::GetBounds(const IntegerVertexArray& positions, int64_t minMax[6]) {
+    if (positions.empty()) {
+        return false;
+    }
+
+    minMax[0] = minMax[3] = positions[0].x;
+    minMax[1] = minMax[4] = positions[0].y;
+    minMax[2] = minMax[5] = positions[0].z;
+    for (const auto& p : positions) {
+        minMax[0] = std::min(minMax[0], p.x);
+        minMax[1] = std::min(minMax[1], p.y);
+        minMax[2] = std::min(minMax[2], p.z);
+        minMax[3] = std::max(minMax[3], p.x);
+        minMax[4] = std::max(minMax[4], p.y);
+        minMax[5] = std::max(minMax[5], p.z);
+    }
+    return true;
+}
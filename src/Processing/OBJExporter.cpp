@@ -56,7 +56,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
     // Write header
     objFile_ << "# 3GM to OBJ Converter - RFC Validated Parser" << std::endl;
     objFile_ << "# Generated from Clusterball 3GM file" << std::endl;
-    objFile_ << "# Vertex count: " << shapeData.vertexCount << std::endl;
+    objFile_ << "# Vertex count: " << shapeData.GetVertexCount() << std::endl;
     objFile_ << "# Primitive count: " << shapeData.primitiveCount << std::endl;
     objFile_ << std::endl;
     
@@ -66,31 +66,59 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
         objFile_ << "mtllib " << mtlName << std::endl << std::endl;
     }
     
-    // Write vertices
-    if (shapeData.vertexData && shapeData.vertexCount > 0) {
+    // Attribute views and DecodePositions read interleaved, SoA and quantised shapes alike
+    size_t vertexCount = shapeData.GetVertexCount();
+    
+    // Only attributes the shape's vertex format carries are written
+    const VertexFormat& format = shapeData.GetVertexFormat();
+    bool hasPositions = shapeData.IsPositionQuantized() || format.Has(VertexAttribute::X);
+    bool hasNormals = options.includeNormals && format.Has(VertexAttribute::NX);
+    bool hasTexCoords = options.includeTextureCoords && format.Has(VertexAttribute::U);
+    
+    // Write vertices (positions are read in blocks, dequantised if the shape keeps them quantised)
+    if (vertexCount > 0 && hasPositions) {
         objFile_ << "# Vertices" << std::endl;
-        for (uint32_t i = 0; i < shapeData.vertexCount; ++i) {
-            const float* vertex = &shapeData.vertexData[i * shapeData.vertexStride];
-            WriteVertex(objFile_, vertex, options);
+        float positions[3 * 256];
+        for (size_t first = 0; first < vertexCount; first += 256) {
+            size_t count = shapeData.DecodePositions(first, 256, positions, 3);
+            for (size_t j = 0; j < count; ++j) {
+                size_t i = first + j;
+                
+                // Optional colors follow the position (3 floats per vertex)
+                float vertex[6] = { positions[j * 3 + 0], positions[j * 3 + 1], positions[j * 3 + 2], 0.0f, 0.0f, 0.0f };
+                if (shapeData.vertexColorData) {
+                    vertex[3] = shapeData.vertexColorData[i * 3 + 0];
+                    vertex[4] = shapeData.vertexColorData[i * 3 + 1];
+                    vertex[5] = shapeData.vertexColorData[i * 3 + 2];
+                }
+                WriteVertex(objFile_, vertex, options);
+            }
         }
         objFile_ << std::endl;
     }
     
     // Write normals
-    if (options.includeNormals && shapeData.normalData && shapeData.vertexCount > 0) {
+    if (hasNormals && vertexCount > 0 && hasPositions) {
+        ConstAttributeSpan nx = shapeData.GetAttribute(VertexAttribute::NX);
+        ConstAttributeSpan ny = shapeData.GetAttribute(VertexAttribute::NY);
+        ConstAttributeSpan nz = shapeData.GetAttribute(VertexAttribute::NZ);
+        
         objFile_ << "# Normals" << std::endl;
-        for (uint32_t i = 0; i < shapeData.vertexCount; ++i) {
-            const float* normal = &shapeData.normalData[i * 3];
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const float normal[3] = { nx[i], ny[i], nz[i] };
             WriteNormal(objFile_, normal);
         }
         objFile_ << std::endl;
     }
     
     // Write texture coordinates
-    if (options.includeTextureCoords && shapeData.textureCoordData && shapeData.vertexCount > 0) {
+    if (hasTexCoords && vertexCount > 0 && hasPositions) {
+        ConstAttributeSpan u = shapeData.GetAttribute(VertexAttribute::U);
+        ConstAttributeSpan v = shapeData.GetAttribute(VertexAttribute::V);
+        
         objFile_ << "# Texture Coordinates" << std::endl;
-        for (uint32_t i = 0; i < shapeData.vertexCount; ++i) {
-            const float* texCoord = &shapeData.textureCoordData[i * 2];
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const float texCoord[2] = { u[i], v[i] };
             WriteTextureCoord(objFile_, texCoord, options);
         }
         objFile_ << std::endl;
@@ -126,7 +154,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
                                 prim.indices[j + 1] + 1,
                                 prim.indices[j + 2] + 1
                             };
-                            WriteFace(objFile_, indices, options.includeNormals, options.includeTextureCoords);
+                            WriteFace(objFile_, indices, hasNormals, hasTexCoords);
                         }
                     }
                     break;
@@ -147,7 +175,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
                                     prim.indices[j + 2] + 1
                                 };
                             }
-                            WriteFace(objFile_, indices, options.includeNormals, options.includeTextureCoords);
+                            WriteFace(objFile_, indices, hasNormals, hasTexCoords);
                         }
                     }
                     break;
@@ -161,7 +189,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
                                 prim.indices[j + 1] + 1,
                                 prim.indices[j + 2] + 1
                             };
-                            WriteFace(objFile_, indices, options.includeNormals, options.includeTextureCoords);
+                            WriteFace(objFile_, indices, hasNormals, hasTexCoords);
                             
                             // Second triangle
                             indices = {
@@ -169,7 +197,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
                                 prim.indices[j + 3] + 1,
                                 prim.indices[j + 2] + 1
                             };
-                            WriteFace(objFile_, indices, options.includeNormals, options.includeTextureCoords);
+                            WriteFace(objFile_, indices, hasNormals, hasTexCoords);
                         }
                     }
                     break;
@@ -183,7 +211,7 @@ bool OBJExporter::WriteOBJFile(const ShapeData& shapeData, const std::string& ob
                                 prim.indices[j + 1] + 1,
                                 prim.indices[j + 2] + 1
                             };
-                            WriteFace(objFile_, indices, options.includeNormals, options.includeTextureCoords);
+                            WriteFace(objFile_, indices, hasNormals, hasTexCoords);
                         }
                     }
                     break;
@@ -0,0 +1,833 @@
+#include "PackedVertexKernel.h"
+#include "CpuFeatures.h"
+#include "ByteSwap.h"
+#include "ShapeLoaderAPI.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef SHAPELOADER_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Vertices converted per block when the output is strided
+const size_t BLOCK_VERTICES = 64;
+
+PackedVertexKernel::Kernel SelectKernel() {
+    if (CpuFeatures::HasAVX2()) {
+        return PackedVertexKernel::Kernel::AVX2;
+    }
+    if (CpuFeatures::HasSSSE3()) {
+        return PackedVertexKernel::Kernel::SSSE3;
+    }
+    return PackedVertexKernel::Kernel::Scalar;
+}
+
+std::atomic<int> g_activeKernel(-1);
+
+typedef void (*AccumulateFunction)(const float*, size_t, size_t, PackedVertexKernel::DecodeStats&);
+
+/**
+ * Run a contiguous kernel and spread its x/y/z output over strided vertices
+ * @param convert Called as convert(input, output, vertexCount) with tightly packed output
+ * @param inputStride Bytes per input vertex
+ * @param accumulate Folds each decoded block into stats while it is still in cache
+ */
+template<typename Convert>
+void ConvertStrided(Convert convert, const uint8_t* input, size_t inputStride,
+                    float* output, size_t outputStride, size_t vertexCount,
+                    PackedVertexKernel::DecodeStats* stats, AccumulateFunction accumulate) {
+    if (stats) {
+        stats->Reset(vertexCount);
+    }
+
+    // Tightly packed output without stats converts in one run
+    if (outputStride == 3 && !stats) {
+        convert(input, output, vertexCount);
+        return;
+    }
+
+    // Otherwise convert block by block, into place or into scratch that is spread out
+    float block[BLOCK_VERTICES * 3];
+    for (size_t first = 0; first < vertexCount; first += BLOCK_VERTICES) {
+        size_t count = vertexCount - first < BLOCK_VERTICES ? vertexCount - first : BLOCK_VERTICES;
+        float* decoded = outputStride == 3 ? output + first * 3 : block;
+        convert(input + first * inputStride, decoded, count);
+
+        if (stats) {
+            accumulate(decoded, count, first, *stats);
+        }
+
+        if (outputStride != 3) {
+            float* out = output + first * outputStride;
+            for (size_t i = 0; i < count; i++, out += outputStride) {
+                out[0] = block[i * 3 + 0];
+                out[1] = block[i * 3 + 1];
+                out[2] = block[i * 3 + 2];
+            }
+        }
+    }
+}
+
+/**
+ * Fold per-lane SIMD minima or maxima into per-axis bounds
+ * @param firstAxis Axis of lane 0; lane j holds axis (firstAxis + j) % 3
+ */
+void FoldLanes(const float* lanes, size_t laneCount, int firstAxis, float* bounds, bool takeMin) {
+    for (size_t j = 0; j < laneCount; j++) {
+        int axis = static_cast<int>((firstAxis + j) % 3);
+        if (takeMin ? lanes[j] < bounds[axis] : lanes[j] > bounds[axis]) {
+            bounds[axis] = lanes[j];
+        }
+    }
+}
+
+} // anonymous namespace
+
+void PackedVertexKernel::ConvertVertices(const uint8_t* input, ByteOrder order,
+                                         float* output, size_t outputStride, size_t vertexCount,
+                                         DecodeStats* stats) {
+    if (!input || !output || vertexCount == 0 || outputStride < 3) {
+        if (stats) {
+            stats->Reset(0);
+        }
+        return;
+    }
+
+    void (*convert)(const uint8_t*, ByteOrder, float*, size_t);
+    switch (GetKernel()) {
+        case Kernel::AVX2:  convert = &ConvertAVX2; break;
+        case Kernel::SSSE3: convert = &ConvertSSSE3; break;
+        default:            convert = &ConvertScalar; break;
+    }
+
+    ConvertStrided([&](const uint8_t* in, float* out, size_t count) { convert(in, order, out, count * 3); },
+                   input, 12, output, outputStride, vertexCount, stats, &Accumulate);
+}
+
+void PackedVertexKernel::ConvertFloatVertices(const uint8_t* input, ByteOrder order,
+                                              float* output, size_t outputStride, size_t vertexCount,
+                                              DecodeStats* stats) {
+    if (!input || !output || vertexCount == 0 || outputStride < 3) {
+        if (stats) {
+            stats->Reset(0);
+        }
+        return;
+    }
+
+    void (*convert)(const uint8_t*, ByteOrder, float*, size_t);
+    switch (GetKernel()) {
+        case Kernel::AVX2:  convert = &ConvertFloatAVX2; break;
+        case Kernel::SSSE3: convert = &ConvertFloatSSSE3; break;
+        default:            convert = &ConvertFloatScalar; break;
+    }
+
+    ConvertStrided([&](const uint8_t* in, float* out, size_t count) { convert(in, order, out, count * 3); },
+                   input, 12, output, outputStride, vertexCount, stats, &Accumulate);
+}
+
+bool PackedVertexKernel::ReadCompressionParams(const uint8_t* block, CompressionParams& params) {
+    if (!block) {
+        return false;
+    }
+
+    float values[6];
+    for (int i = 0; i < 6; i++) {
+        uint32_t bits = ByteSwap::ReadLittleEndian32(block + i * 4);
+        std::memcpy(&values[i], &bits, sizeof(float));
+        if (!std::isfinite(values[i])) {
+            return false;
+        }
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        params.scale[axis] = values[axis];
+        params.offset[axis] = values[3 + axis];
+    }
+    return true;
+}
+
+void PackedVertexKernel::DecompressVertices(const CompressionParams& params, const uint8_t* input,
+                                            float* output, size_t outputStride, size_t vertexCount,
+                                            DecodeStats* stats) {
+    if (!input || !output || vertexCount == 0 || outputStride < 3) {
+        if (stats) {
+            stats->Reset(0);
+        }
+        return;
+    }
+
+    void (*decompress)(const CompressionParams&, const uint8_t*, float*, size_t);
+    switch (GetKernel()) {
+        case Kernel::AVX2:  decompress = &DecompressAVX2; break;
+        case Kernel::SSSE3: decompress = &DecompressSSSE3; break;
+        default:            decompress = &DecompressScalar; break;
+    }
+
+    ConvertStrided([&](const uint8_t* in, float* out, size_t count) { decompress(params, in, out, count); },
+                   input, COMPRESSED_VERTEX_SIZE, output, outputStride, vertexCount, stats, &Accumulate);
+}
+
+void PackedVertexKernel::ConvertShortVertices(const uint8_t* input, float* output,
+                                              size_t outputStride, size_t vertexCount,
+                                              DecodeStats* stats) {
+    if (!input || !output || vertexCount == 0 || outputStride < 3) {
+        if (stats) {
+            stats->Reset(0);
+        }
+        return;
+    }
+
+    void (*convert)(const uint8_t*, float*, size_t);
+    switch (GetKernel()) {
+        case Kernel::AVX2:  convert = &ConvertShortAVX2; break;
+        case Kernel::SSSE3: convert = &ConvertShortSSSE3; break;
+        default:            convert = &ConvertShortScalar; break;
+    }
+
+    ConvertStrided(convert, input, 6, output, outputStride, vertexCount, stats, &Accumulate);
+}
+
+void PackedVertexKernel::DequantizeHalfVertices(const CompressionParams& params, const uint8_t* input,
+                                                float* output, size_t outputStride, size_t vertexCount) {
+    if (!input || !output || vertexCount == 0 || outputStride < 3) {
+        return;
+    }
+
+    // F16C ships with every AVX2 CPU in practice but is a separate feature bit
+    void (*dequantize)(const CompressionParams&, const uint8_t*, float*, size_t) =
+        GetKernel() == Kernel::AVX2 && CpuFeatures::HasF16C() ? &DequantizeHalfF16C : &DequantizeHalfScalar;
+
+    ConvertStrided([&](const uint8_t* in, float* out, size_t count) { dequantize(params, in, out, count); },
+                   input, HALF_VERTEX_SIZE, output, outputStride, vertexCount, nullptr, &Accumulate);
+}
+
+float PackedVertexKernel::HalfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        // Infinity, or NaN made quiet the way vcvtph2ps does
+        bits = sign | 0x7F800000 | (mantissa << 13) | (mantissa ? 0x400000 : 0);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal half: normalise into a float exponent
+        exponent = 113;
+        while (!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t PackedVertexKernel::FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        // Infinity stays infinity, NaN stays a (quiet) NaN
+        return static_cast<uint16_t>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 | ((magnitude >> 13) & 0x3FF) : 0));
+    }
+    if (magnitude >= 0x477FF000) {
+        return static_cast<uint16_t>(sign | 0x7C00);     // 65520 and up round past the largest half
+    }
+    if (magnitude <= 0x33000000) {
+        return static_cast<uint16_t>(sign);              // 2^-25 and below round to zero
+    }
+
+    uint32_t half;
+    uint32_t remainder;
+    uint32_t midpoint;
+    if (magnitude < 0x38800000) {
+        // Below 2^-14: subnormal half, shift the full mantissa down
+        uint32_t shift = 126 - (magnitude >> 23);
+        uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        midpoint = 1u << (shift - 1);
+    } else {
+        // Rebias the exponent from 127 to 15 and drop 13 mantissa bits
+        half = (magnitude - 0x38000000) >> 13;
+        remainder = magnitude & 0x1FFF;
+        midpoint = 0x1000;
+    }
+
+    // Round to nearest even; a carry into the exponent is still correct
+    if (remainder > midpoint || (remainder == midpoint && (half & 1))) {
+        half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+void PackedVertexKernel::DecodeStats::Reset(size_t vertexCount) {
+    for (int axis = 0; axis < 3; axis++) {
+        min[axis] = std::numeric_limits<float>::infinity();
+        max[axis] = -std::numeric_limits<float>::infinity();
+    }
+    validCount = 0;
+    invalidCount = 0;
+    invalidMask.assign((vertexCount + 63) / 64, 0);
+}
+
+void PackedVertexKernel::DecodeStats::AddVertex(size_t index, const float* position) {
+    if (!std::isfinite(position[0]) || !std::isfinite(position[1]) || !std::isfinite(position[2])) {
+        if (index / 64 >= invalidMask.size()) {
+            invalidMask.resize(index / 64 + 1, 0);
+        }
+        invalidMask[index / 64] |= uint64_t(1) << (index % 64);
+        invalidCount++;
+        return;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (position[axis] < min[axis]) min[axis] = position[axis];
+        if (position[axis] > max[axis]) max[axis] = position[axis];
+    }
+    validCount++;
+}
+
+void PackedVertexKernel::DecodeStats::Merge(const DecodeStats& part, size_t firstVertex) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (part.min[axis] < min[axis]) min[axis] = part.min[axis];
+        if (part.max[axis] > max[axis]) max[axis] = part.max[axis];
+    }
+    validCount += part.validCount;
+    invalidCount += part.invalidCount;
+
+    // Invalid vertices are rare, skip empty mask words
+    for (size_t word = 0; word < part.invalidMask.size(); word++) {
+        uint64_t bits = part.invalidMask[word];
+        for (size_t bit = 0; bits != 0; bit++, bits >>= 1) {
+            if ((bits & 1) == 0) {
+                continue;
+            }
+            size_t index = firstVertex + word * 64 + bit;
+            if (index / 64 >= invalidMask.size()) {
+                invalidMask.resize(index / 64 + 1, 0);
+            }
+            invalidMask[index / 64] |= uint64_t(1) << (index % 64);
+        }
+    }
+}
+
+void PackedVertexKernel::DecodeStats::GetBoundingBox(float minMax[6]) const {
+    for (int axis = 0; axis < 3; axis++) {
+        minMax[axis] = HasBounds() ? min[axis] : 0.0f;
+        minMax[3 + axis] = HasBounds() ? max[axis] : 0.0f;
+    }
+}
+
+void PackedVertexKernel::Accumulate(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    switch (GetKernel()) {
+        case Kernel::AVX2:  AccumulateAVX2(block, count, firstVertex, stats); break;
+        case Kernel::SSSE3: AccumulateSSSE3(block, count, firstVertex, stats); break;
+        default:            AccumulateScalar(block, count, firstVertex, stats); break;
+    }
+}
+
+void PackedVertexKernel::AccumulateScalar(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    for (size_t i = 0; i < count; i++) {
+        stats.AddVertex(firstVertex + i, block + i * 3);
+    }
+}
+
+PackedVertexKernel::Kernel PackedVertexKernel::GetKernel() {
+    int kernel = g_activeKernel.load(std::memory_order_relaxed);
+    if (kernel < 0) {
+        kernel = static_cast<int>(SelectKernel());
+        g_activeKernel.store(kernel, std::memory_order_relaxed);
+    }
+    return static_cast<Kernel>(kernel);
+}
+
+void PackedVertexKernel::SetKernel(Kernel kernel) {
+    if (kernel == Kernel::AVX2 && !CpuFeatures::HasAVX2()) {
+        kernel = Kernel::SSSE3;
+    }
+    if (kernel == Kernel::SSSE3 && !CpuFeatures::HasSSSE3()) {
+        kernel = Kernel::Scalar;
+    }
+    g_activeKernel.store(static_cast<int>(kernel), std::memory_order_relaxed);
+}
+
+const char* PackedVertexKernel::GetKernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::AVX2:  return "AVX2";
+        case Kernel::SSSE3: return "SSSE3";
+        default:            return "Scalar";
+    }
+}
+
+void PackedVertexKernel::ConvertScalar(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    for (size_t i = 0; i < count; i++, input += 4) {
+        uint32_t packed = order == ByteOrder::BigEndian
+            ? ByteSwap::ReadBigEndian32(input)
+            : ByteSwap::ReadLittleEndian32(input);
+        output[i] = static_cast<float>(static_cast<int32_t>(packed)) / 10.0f;
+    }
+}
+
+void PackedVertexKernel::ConvertFloatScalar(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    for (size_t i = 0; i < count; i++, input += 4) {
+        uint32_t bits = order == ByteOrder::BigEndian
+            ? ByteSwap::ReadBigEndian32(input)
+            : ByteSwap::ReadLittleEndian32(input);
+        std::memcpy(&output[i], &bits, sizeof(float));
+    }
+}
+
+void PackedVertexKernel::DecompressScalar(const CompressionParams& params, const uint8_t* input,
+                                          float* output, size_t count) {
+    for (size_t i = 0; i < count; i++, input += COMPRESSED_VERTEX_SIZE, output += 3) {
+        for (int axis = 0; axis < 3; axis++) {
+            int16_t value = static_cast<int16_t>(ByteSwap::ReadLittleEndian16(input + axis * 2));
+            output[axis] = params.offset[axis] + static_cast<float>(value) * params.scale[axis];
+        }
+    }
+}
+
+void PackedVertexKernel::ConvertShortScalar(const uint8_t* input, float* output, size_t count) {
+    for (size_t i = 0; i < count * 3; i++, input += 2) {
+        int16_t value = static_cast<int16_t>(ByteSwap::ReadLittleEndian16(input));
+        output[i] = value != -1 ? static_cast<float>(value) / 100.0f : 0.0f;
+    }
+}
+
+void PackedVertexKernel::DequantizeHalfScalar(const CompressionParams& params, const uint8_t* input,
+                                              float* output, size_t count) {
+    for (size_t i = 0; i < count; i++, input += HALF_VERTEX_SIZE, output += 3) {
+        for (int axis = 0; axis < 3; axis++) {
+            float value = HalfToFloat(ByteSwap::ReadLittleEndian16(input + axis * 2));
+            output[axis] = params.offset[axis] + value * params.scale[axis];
+        }
+    }
+}
+
+#ifdef SHAPELOADER_X86
+
+SHAPELOADER_TARGET("ssse3")
+void PackedVertexKernel::ConvertSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    // Host-order data goes through an identity shuffle, keeping the loop branch-free
+    const __m128i shuffle = order == ByteOrder::BigEndian
+        ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128 ten = _mm_set1_ps(10.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4));
+        __m128 values = _mm_cvtepi32_ps(_mm_shuffle_epi8(packed, shuffle));
+        _mm_storeu_ps(output + i, _mm_div_ps(values, ten));
+    }
+
+    ConvertScalar(input + i * 4, order, output + i, count - i);
+}
+
+SHAPELOADER_TARGET("avx2")
+void PackedVertexKernel::ConvertAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    // vpshufb works per 128-bit lane, so the same pattern is repeated in both lanes
+    const __m256i shuffle = order == ByteOrder::BigEndian
+        ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                           0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m256 ten = _mm256_set1_ps(10.0f);
+
+    size_t i = 0;
+
+    // Two vectors per step so both divides are in flight together
+    for (; i + 16 <= count; i += 16) {
+        __m256i packedA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 4));
+        __m256i packedB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 4 + 32));
+        __m256 valuesA = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(packedA, shuffle));
+        __m256 valuesB = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(packedB, shuffle));
+        _mm256_storeu_ps(output + i, _mm256_div_ps(valuesA, ten));
+        _mm256_storeu_ps(output + i + 8, _mm256_div_ps(valuesB, ten));
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 4));
+        __m256 values = _mm256_cvtepi32_ps(_mm256_shuffle_epi8(packed, shuffle));
+        _mm256_storeu_ps(output + i, _mm256_div_ps(values, ten));
+    }
+
+    ConvertScalar(input + i * 4, order, output + i, count - i);
+}
+
+SHAPELOADER_TARGET("ssse3")
+void PackedVertexKernel::ConvertFloatSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    const __m128i shuffle = order == ByteOrder::BigEndian
+        ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_shuffle_epi8(packed, shuffle));
+    }
+
+    ConvertFloatScalar(input + i * 4, order, output + i, count - i);
+}
+
+SHAPELOADER_TARGET("avx2")
+void PackedVertexKernel::ConvertFloatAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    const __m256i shuffle = order == ByteOrder::BigEndian
+        ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                           0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_shuffle_epi8(packed, shuffle));
+    }
+
+    ConvertFloatScalar(input + i * 4, order, output + i, count - i);
+}
+
+SHAPELOADER_TARGET("ssse3")
+void PackedVertexKernel::DecompressSSSE3(const CompressionParams& params, const uint8_t* input,
+                                         float* output, size_t count) {
+    // Eight vertices are 24 coordinates, six vectors whose axis pattern
+    // repeats every three: xyzx, yzxy, zxyz
+    const float* s = params.scale;
+    const float* o = params.offset;
+    const __m128 scaleA = _mm_setr_ps(s[0], s[1], s[2], s[0]);
+    const __m128 scaleB = _mm_setr_ps(s[1], s[2], s[0], s[1]);
+    const __m128 scaleC = _mm_setr_ps(s[2], s[0], s[1], s[2]);
+    const __m128 offsetA = _mm_setr_ps(o[0], o[1], o[2], o[0]);
+    const __m128 offsetB = _mm_setr_ps(o[1], o[2], o[0], o[1]);
+    const __m128 offsetC = _mm_setr_ps(o[2], o[0], o[1], o[2]);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* in = input + i * COMPRESSED_VERTEX_SIZE;
+        float* out = output + i * 3;
+
+        __m128i packed[3];
+        packed[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        packed[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+        packed[2] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32));
+
+        for (int k = 0; k < 3; k++) {
+            // Sign-extend int16 to int32 by unpacking into the high half and shifting down
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed[k], packed[k]), 16);
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed[k], packed[k]), 16);
+
+            // Vector k*2 and k*2+1 of the six; patterns run A B C A B C
+            const __m128 scaleLow = k == 0 ? scaleA : (k == 1 ? scaleC : scaleB);
+            const __m128 offsetLow = k == 0 ? offsetA : (k == 1 ? offsetC : offsetB);
+            const __m128 scaleHigh = k == 0 ? scaleB : (k == 1 ? scaleA : scaleC);
+            const __m128 offsetHigh = k == 0 ? offsetB : (k == 1 ? offsetA : offsetC);
+
+            _mm_storeu_ps(out + k * 8, _mm_add_ps(offsetLow, _mm_mul_ps(_mm_cvtepi32_ps(low), scaleLow)));
+            _mm_storeu_ps(out + k * 8 + 4, _mm_add_ps(offsetHigh, _mm_mul_ps(_mm_cvtepi32_ps(high), scaleHigh)));
+        }
+    }
+
+    DecompressScalar(params, input + i * COMPRESSED_VERTEX_SIZE, output + i * 3, count - i);
+}
+
+SHAPELOADER_TARGET("avx2")
+void PackedVertexKernel::DecompressAVX2(const CompressionParams& params, const uint8_t* input,
+                                        float* output, size_t count) {
+    // Eight vertices are 24 coordinates in three vectors starting on axis x, z and y
+    const float* s = params.scale;
+    const float* o = params.offset;
+    const __m256 scaleA = _mm256_setr_ps(s[0], s[1], s[2], s[0], s[1], s[2], s[0], s[1]);
+    const __m256 scaleB = _mm256_setr_ps(s[2], s[0], s[1], s[2], s[0], s[1], s[2], s[0]);
+    const __m256 scaleC = _mm256_setr_ps(s[1], s[2], s[0], s[1], s[2], s[0], s[1], s[2]);
+    const __m256 offsetA = _mm256_setr_ps(o[0], o[1], o[2], o[0], o[1], o[2], o[0], o[1]);
+    const __m256 offsetB = _mm256_setr_ps(o[2], o[0], o[1], o[2], o[0], o[1], o[2], o[0]);
+    const __m256 offsetC = _mm256_setr_ps(o[1], o[2], o[0], o[1], o[2], o[0], o[1], o[2]);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* in = input + i * COMPRESSED_VERTEX_SIZE;
+        float* out = output + i * 3;
+
+        __m256i valuesA = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+        __m256i valuesB = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16)));
+        __m256i valuesC = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32)));
+
+        // Multiply then add, never fused, to round exactly like the scalar loop
+        _mm256_storeu_ps(out, _mm256_add_ps(offsetA, _mm256_mul_ps(_mm256_cvtepi32_ps(valuesA), scaleA)));
+        _mm256_storeu_ps(out + 8, _mm256_add_ps(offsetB, _mm256_mul_ps(_mm256_cvtepi32_ps(valuesB), scaleB)));
+        _mm256_storeu_ps(out + 16, _mm256_add_ps(offsetC, _mm256_mul_ps(_mm256_cvtepi32_ps(valuesC), scaleC)));
+    }
+
+    DecompressScalar(params, input + i * COMPRESSED_VERTEX_SIZE, output + i * 3, count - i);
+}
+
+SHAPELOADER_TARGET("ssse3")
+void PackedVertexKernel::ConvertShortSSSE3(const uint8_t* input, float* output, size_t count) {
+    const __m128 hundred = _mm_set1_ps(100.0f);
+    const __m128i sentinel = _mm_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* in = input + i * 6;
+        float* out = output + i * 3;
+
+        for (int k = 0; k < 3; k++) {
+            __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + k * 16));
+
+            // Sign-extend int16 to int32 by unpacking into the high half and shifting down
+            __m128i values[2];
+            values[0] = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+            values[1] = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+
+            for (int h = 0; h < 2; h++) {
+                // Clear unused (-1) components with a mask instead of a branch
+                __m128 unused = _mm_castsi128_ps(_mm_cmpeq_epi32(values[h], sentinel));
+                __m128 scaled = _mm_div_ps(_mm_cvtepi32_ps(values[h]), hundred);
+                _mm_storeu_ps(out + k * 8 + h * 4, _mm_andnot_ps(unused, scaled));
+            }
+        }
+    }
+
+    ConvertShortScalar(input + i * 6, output + i * 3, count - i);
+}
+
+SHAPELOADER_TARGET("avx2")
+void PackedVertexKernel::ConvertShortAVX2(const uint8_t* input, float* output, size_t count) {
+    const __m256 hundred = _mm256_set1_ps(100.0f);
+    const __m256i sentinel = _mm256_set1_epi32(-1);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* in = input + i * 6;
+        float* out = output + i * 3;
+
+        for (int k = 0; k < 3; k++) {
+            __m256i values = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + k * 16)));
+            __m256 unused = _mm256_castsi256_ps(_mm256_cmpeq_epi32(values, sentinel));
+            __m256 scaled = _mm256_div_ps(_mm256_cvtepi32_ps(values), hundred);
+            _mm256_storeu_ps(out + k * 8, _mm256_blendv_ps(scaled, zero, unused));
+        }
+    }
+
+    ConvertShortScalar(input + i * 6, output + i * 3, count - i);
+}
+
+SHAPELOADER_TARGET("avx,f16c")
+void PackedVertexKernel::DequantizeHalfF16C(const CompressionParams& params, const uint8_t* input,
+                                            float* output, size_t count) {
+    // 24 halves of eight vertices widen to three vectors starting on axis x, z and y
+    const float* s = params.scale;
+    const float* o = params.offset;
+    const __m256 scale[3] = {
+        _mm256_setr_ps(s[0], s[1], s[2], s[0], s[1], s[2], s[0], s[1]),
+        _mm256_setr_ps(s[2], s[0], s[1], s[2], s[0], s[1], s[2], s[0]),
+        _mm256_setr_ps(s[1], s[2], s[0], s[1], s[2], s[0], s[1], s[2])
+    };
+    const __m256 offset[3] = {
+        _mm256_setr_ps(o[0], o[1], o[2], o[0], o[1], o[2], o[0], o[1]),
+        _mm256_setr_ps(o[2], o[0], o[1], o[2], o[0], o[1], o[2], o[0]),
+        _mm256_setr_ps(o[1], o[2], o[0], o[1], o[2], o[0], o[1], o[2])
+    };
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* in = input + i * HALF_VERTEX_SIZE;
+        float* out = output + i * 3;
+
+        for (int v = 0; v < 3; v++) {
+            __m256 values = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + v * 16)));
+            _mm256_storeu_ps(out + v * 8, _mm256_add_ps(offset[v], _mm256_mul_ps(values, scale[v])));
+        }
+    }
+
+    DequantizeHalfScalar(params, input + i * HALF_VERTEX_SIZE, output + i * 3, count - i);
+}
+
+SHAPELOADER_TARGET("ssse3")
+void PackedVertexKernel::AccumulateSSSE3(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    // Eight vertices are six vectors with lane axis patterns xyzx, yzxy, zxyz, repeated
+    const __m128 zero = _mm_setzero_ps();
+    __m128 minimum[3];
+    __m128 maximum[3];
+    for (int p = 0; p < 3; p++) {
+        minimum[p] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        maximum[p] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    }
+
+    size_t valid = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float* in = block + i * 3;
+
+        __m128 values[6];
+        int finite = 0xF;
+        for (int v = 0; v < 6; v++) {
+            values[v] = _mm_loadu_ps(in + v * 4);
+            // x - x is 0 for finite x, NaN for NaN and infinity
+            finite &= _mm_movemask_ps(_mm_cmpeq_ps(_mm_sub_ps(values[v], values[v]), zero));
+        }
+
+        // Rare: a block with an invalid vertex takes the per-vertex path
+        if (finite != 0xF) {
+            AccumulateScalar(in, 8, firstVertex + i, stats);
+            continue;
+        }
+
+        for (int v = 0; v < 6; v++) {
+            minimum[v % 3] = _mm_min_ps(minimum[v % 3], values[v]);
+            maximum[v % 3] = _mm_max_ps(maximum[v % 3], values[v]);
+        }
+        valid += 8;
+    }
+
+    // Pattern p starts on axis 0, 1, 2 for xyzx, yzxy, zxyz
+    alignas(16) float lanes[4];
+    for (int p = 0; p < 3; p++) {
+        _mm_store_ps(lanes, minimum[p]);
+        FoldLanes(lanes, 4, p, stats.min, true);
+        _mm_store_ps(lanes, maximum[p]);
+        FoldLanes(lanes, 4, p, stats.max, false);
+    }
+    stats.validCount += valid;
+
+    AccumulateScalar(block + i * 3, count - i, firstVertex + i, stats);
+}
+
+SHAPELOADER_TARGET("avx2")
+void PackedVertexKernel::AccumulateAVX2(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    // Eight vertices are three vectors starting on axis x, z and y
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 minimum[3];
+    __m256 maximum[3];
+    for (int v = 0; v < 3; v++) {
+        minimum[v] = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        maximum[v] = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    }
+
+    size_t valid = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float* in = block + i * 3;
+
+        __m256 values[3];
+        int finite = 0xFF;
+        for (int v = 0; v < 3; v++) {
+            values[v] = _mm256_loadu_ps(in + v * 8);
+            // x - x is 0 for finite x, NaN for NaN and infinity
+            finite &= _mm256_movemask_ps(_mm256_cmp_ps(_mm256_sub_ps(values[v], values[v]), zero, _CMP_EQ_OQ));
+        }
+
+        // Rare: a block with an invalid vertex takes the per-vertex path
+        if (finite != 0xFF) {
+            AccumulateScalar(in, 8, firstVertex + i, stats);
+            continue;
+        }
+
+        for (int v = 0; v < 3; v++) {
+            minimum[v] = _mm256_min_ps(minimum[v], values[v]);
+            maximum[v] = _mm256_max_ps(maximum[v], values[v]);
+        }
+        valid += 8;
+    }
+
+    static const int firstAxis[3] = {0, 2, 1};
+    alignas(32) float lanes[8];
+    for (int v = 0; v < 3; v++) {
+        _mm256_store_ps(lanes, minimum[v]);
+        FoldLanes(lanes, 8, firstAxis[v], stats.min, true);
+        _mm256_store_ps(lanes, maximum[v]);
+        FoldLanes(lanes, 8, firstAxis[v], stats.max, false);
+    }
+    stats.validCount += valid;
+
+    AccumulateScalar(block + i * 3, count - i, firstVertex + i, stats);
+}
+
+#else
+
+void PackedVertexKernel::ConvertSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    ConvertScalar(input, order, output, count);
+}
+
+void PackedVertexKernel::ConvertAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    ConvertScalar(input, order, output, count);
+}
+
+void PackedVertexKernel::ConvertFloatSSSE3(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    ConvertFloatScalar(input, order, output, count);
+}
+
+void PackedVertexKernel::ConvertFloatAVX2(const uint8_t* input, ByteOrder order, float* output, size_t count) {
+    ConvertFloatScalar(input, order, output, count);
+}
+
+void PackedVertexKernel::DecompressSSSE3(const CompressionParams& params, const uint8_t* input,
+                                         float* output, size_t count) {
+    DecompressScalar(params, input, output, count);
+}
+
+void PackedVertexKernel::DecompressAVX2(const CompressionParams& params, const uint8_t* input,
+                                        float* output, size_t count) {
+    DecompressScalar(params, input, output, count);
+}
+
+void PackedVertexKernel::ConvertShortSSSE3(const uint8_t* input, float* output, size_t count) {
+    ConvertShortScalar(input, output, count);
+}
+
+void PackedVertexKernel::ConvertShortAVX2(const uint8_t* input, float* output, size_t count) {
+    ConvertShortScalar(input, output, count);
+}
+
+void PackedVertexKernel::DequantizeHalfF16C(const CompressionParams& params, const uint8_t* input,
+                                            float* output, size_t count) {
+    DequantizeHalfScalar(params, input, output, count);
+}
+
+void PackedVertexKernel::AccumulateSSSE3(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    AccumulateScalar(block, count, firstVertex, stats);
+}
+
+void PackedVertexKernel::AccumulateAVX2(const float* block, size_t count, size_t firstVertex, DecodeStats& stats) {
+    AccumulateScalar(block, count, firstVertex, stats);
+}
+
+#endif
+
+namespace ShapeLoader {
+namespace Conversion {
+
+uint32_t ConvertPackedToFloatVertices3Component(uint32_t* input, float* output, uint32_t vertexCount) {
+    if (!input || !output) {
+        return 0;
+    }
+
+    // Callers pass integers already swapped to (little-endian) host order
+    PackedVertexKernel::ConvertVertices(reinterpret_cast<const uint8_t*>(input),
+                                        PackedVertexKernel::ByteOrder::LittleEndian,
+                                        output, 8, vertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        for (int k = 3; k < 8; k++) {
+            output[i * 8 + k] = 0.0f;
+        }
+    }
+    return vertexCount;
+}
+
+}
+}
@@ -59,6 +59,26 @@ void SurfaceGenerator::Cleanup() {
     GlobalVariables::Surface::g_systemInitialized = false;
 }
 
+void SurfaceGenerator::Reset() {
+    if (!systemInitialized_) {
+        return;
+    }
+    
+    // Surfaces and hash entries are handed out in order, so nothing past the counters is in use
+    std::fill(textureHashTable_.begin(), textureHashTable_.end(), -1);
+    std::fill(hashCollisionData_.begin(), hashCollisionData_.begin() + nextHashEntry_, SurfaceHashEntry());
+    std::fill(surfaceTable_.begin(), surfaceTable_.begin() + nextSurfaceID_, SurfaceTableEntry());
+    
+    nextSurfaceID_ = 1;
+    nextHashEntry_ = 0;
+}
+
+size_t SurfaceGenerator::GetTableBytes() const {
+    return textureHashTable_.capacity() * sizeof(int32_t) +
+           hashCollisionData_.capacity() * sizeof(SurfaceHashEntry) +
+           surfaceTable_.capacity() * sizeof(SurfaceTableEntry);
+}
+
 uint16_t SurfaceGenerator::GetSurfaceHash(uint16_t primitiveType, int16_t textureID, uint16_t flags) {
     // RFC VALIDATED: Exact algorithm from GetSurfaceHash.cpp lines 20-36
     
@@ -281,9 +301,7 @@ SurfaceGenerator::Statistics SurfaceGenerator::GetStatistics() const {
     stats.allocatedHashEntries = nextHashEntry_;
     stats.maxTextures = maxTextures_;
     stats.maxSurfaces = maxSurfaces_;
-    stats.memoryUsed = (textureHashTable_.size() * sizeof(int32_t)) +
-                       (hashCollisionData_.size() * sizeof(SurfaceHashEntry)) +
-                       (surfaceTable_.size() * sizeof(SurfaceTableEntry));
+    stats.memoryUsed = GetTableBytes();
     return stats;
 }
 
@@ -293,8 +311,8 @@ bool SurfaceGenerator::ValidateSystem() const {
     }
     
     // Check array sizes
-    if (textureHashTable_.size() != maxTextures_ ||
-        surfaceTable_.size() != maxSurfaces_) {
+    if (textureHashTable_.size() != static_cast<size_t>(maxTextures_) ||
+        surfaceTable_.size() != static_cast<size_t>(maxSurfaces_)) {
         return false;
     }
     
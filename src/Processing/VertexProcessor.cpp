@@ -1,13 +1,20 @@
 #include "VertexProcessor.h"
 #include "ByteSwap.h"
+#include "PackedVertexKernel.h"
 #include "GlobalVariables.h"
 #include "ErrorHandler.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <cstring>
+#include <exception>
+#include <future>
+#include <string>
 
 bool VertexProcessor::ProcessVertices(Algorithm algorithm,
                                      const uint8_t* inputData,
                                      float* outputBuffer,
-                                     size_t vertexCount) {
+                                     size_t vertexCount,
+                                     size_t outputStride) {
     if (!ValidateInputData(algorithm, inputData, 0, vertexCount) || !outputBuffer) {
         return false;
     }
@@ -17,16 +24,18 @@ bool VertexProcessor::ProcessVertices(Algorithm algorithm,
             return ConvertPackedToFloatVertices(
                 reinterpret_cast<const uint32_t*>(inputData), 
                 outputBuffer, 
-                vertexCount);
+                vertexCount,
+                outputStride);
             
         case Algorithm::PackedToFloat3Comp:
             return ConvertPackedToFloatVertices3Component(
                 reinterpret_cast<const uint32_t*>(inputData), 
                 outputBuffer, 
-                vertexCount);
+                vertexCount,
+                outputStride);
             
         case Algorithm::DecrunchDots:
-            return DecrunchDotsVertices(inputData, outputBuffer, vertexCount);
+            return DecrunchDotsVertices(inputData, outputBuffer, vertexCount, outputStride);
             
         default:
             ErrorHandler::PostEvent(0x6A, "Unknown vertex processing algorithm");
@@ -36,13 +45,32 @@ bool VertexProcessor::ProcessVertices(Algorithm algorithm,
 
 bool VertexProcessor::ConvertPackedToFloatVertices(const uint32_t* packedVertices,
                                                   float* outputVertices,
-                                                  size_t vertexCount) {
-    if (!packedVertices || !outputVertices || vertexCount == 0) {
+                                                  size_t vertexCount,
+                                                  size_t outputStride,
+                                                  PackedVertexKernel::DecodeStats* stats) {
+    if (!packedVertices || !outputVertices || vertexCount == 0 || outputStride < 3) {
         return ErrorHandler::PostEvent(0x6A, "Invalid parameters for ConvertPackedToFloatVertices");
     }
     
+    ConvertPackedRange(packedVertices, outputVertices, vertexCount, outputStride, stats);
+    
+    // RFC VALIDATED: Add terminator (lines 27-28)
+    uint32_t terminator = GlobalVariables::GetVertexTerminator();
+    std::memcpy(outputVertices + CalculateOutputSize(vertexCount, outputStride), &terminator, sizeof(terminator));
+    
+    return true;
+}
+
+void VertexProcessor::ConvertPackedRange(const uint32_t* packedVertices,
+                                         float* outputVertices,
+                                         size_t vertexCount,
+                                         size_t outputStride,
+                                         PackedVertexKernel::DecodeStats* stats) {
     // RFC VALIDATED: Exact algorithm from convertPackedToFloatVertices.cpp lines 11-34
     float* v4 = outputVertices;  // Output pointer
+    if (stats) {
+        stats->Reset(vertexCount);
+    }
     
     for (size_t i = 0; i < vertexCount; i++) {
         // RFC VALIDATED: Process X coordinate from current position (lines 15-16)
@@ -54,39 +82,56 @@ bool VertexProcessor::ConvertPackedToFloatVertices(const uint32_t* packedVertice
         // Store X as float at current output position (line 18)
         *v4 = static_cast<float>(xPacked);
         
-        // CRITICAL: Jump output pointer forward by 8 floats (line 19)
-        v4 += 8;
+        // CRITICAL: Jump output pointer forward by one vertex (line 19, 8 floats in the RFC layout)
+        v4 += outputStride;
         
         // RFC VALIDATED: Process Y coordinate from 2 positions BACK in input (lines 20-21)
         uint32_t yPacked = ByteSwap::ApplyComplexByteSwap(*(packedVertices - 2));
         
-        // Store Y at output position 7 floats BACK (line 21)
-        *(v4 - 7) = static_cast<float>(yPacked);
+        // Store Y at output position stride - 1 floats BACK (line 21)
+        *(v4 - outputStride + 1) = static_cast<float>(yPacked);
         
         // RFC VALIDATED: Process Z coordinate from 1 position BACK in input (lines 23-24)  
         uint32_t zPacked = ByteSwap::ApplyComplexByteSwap(*(packedVertices - 1));
         
-        // Store Z at output position 6 floats BACK (line 24)
-        *(v4 - 6) = static_cast<float>(zPacked);
+        // Store Z at output position stride - 2 floats BACK (line 24)
+        *(v4 - outputStride + 2) = static_cast<float>(zPacked);
+        
+        if (stats) {
+            stats->AddVertex(i, v4 - outputStride);
+        }
     }
-    
-    // RFC VALIDATED: Add terminator (lines 27-28)
-    uint32_t terminator = GlobalVariables::GetVertexTerminator();
-    *v4 = *reinterpret_cast<const float*>(&terminator);
-    
-    return true;
 }
 
 bool VertexProcessor::ConvertPackedToFloatVertices3Component(const uint32_t* packedVertices,
                                                            float* outputVertices,
-                                                           size_t vertexCount) {
-    if (!packedVertices || !outputVertices || vertexCount == 0) {
+                                                           size_t vertexCount,
+                                                           size_t outputStride,
+                                                           PackedVertexKernel::DecodeStats* stats) {
+    if (!packedVertices || !outputVertices || vertexCount == 0 || outputStride < 3) {
         return ErrorHandler::PostEvent(0x6A, "Invalid parameters for ConvertPackedToFloatVertices3Component");
     }
     
+    ConvertPacked3ComponentRange(packedVertices, outputVertices, vertexCount, outputStride, stats);
+    
+    // RFC VALIDATED: Add terminator (line 27)
+    uint32_t terminator = GlobalVariables::GetVertexTerminator();
+    std::memcpy(outputVertices + CalculateOutputSize(vertexCount, outputStride), &terminator, sizeof(terminator));
+    
+    return true;
+}
+
+void VertexProcessor::ConvertPacked3ComponentRange(const uint32_t* packedVertices,
+                                                   float* outputVertices,
+                                                   size_t vertexCount,
+                                                   size_t outputStride,
+                                                   PackedVertexKernel::DecodeStats* stats) {
     // RFC VALIDATED: Exact algorithm from convertPackedToFloatVertices_3Component.cpp lines 14-26
     float* v4 = outputVertices;  // Output pointer
     const uint32_t* input = packedVertices;
+    if (stats) {
+        stats->Reset(vertexCount);
+    }
     
     for (size_t i = 0; i < vertexCount; i++) {
         // RFC VALIDATED: X coordinate - apply byte-swap to input[0] (line 16)
@@ -98,76 +143,181 @@ bool VertexProcessor::ConvertPackedToFloatVertices3Component(const uint32_t* pac
         // RFC VALIDATED: Z coordinate - apply byte-swap to input[2] (lines 20-21)
         v4[2] = static_cast<float>(ByteSwap::ApplyComplexByteSwap(input[2]));
         
+        if (stats) {
+            stats->AddVertex(i, v4);
+        }
+        
         // RFC VALIDATED: Advance pointers (lines 22-23)
         input += 3;    // Jump by 3 DWORDs (12 bytes)
-        v4 += 8;       // Jump by 8 floats (32 bytes)
+        v4 += outputStride;    // Jump by one vertex (8 floats in the RFC layout)
     }
-    
-    // RFC VALIDATED: Add terminator (line 27)
-    uint32_t terminator = GlobalVariables::GetVertexTerminator();
-    *v4 = *reinterpret_cast<const float*>(&terminator);
-    
-    return true;
 }
 
 bool VertexProcessor::DecrunchDotsVertices(const uint8_t* compressedData,
                                           float* outputVertices,
-                                          size_t vertexCount) {
-    if (!compressedData || !outputVertices || vertexCount == 0) {
+                                          size_t vertexCount,
+                                          size_t outputStride,
+                                          PackedVertexKernel::DecodeStats* stats) {
+    if (!compressedData || !outputVertices || vertexCount == 0 || outputStride < 3) {
         return ErrorHandler::PostEvent(0x6A, "Invalid parameters for DecrunchDotsVertices");
     }
     
-    // RFC VALIDATED: Exact algorithm from DecrunchDots.cpp lines 31-63
-    const uint8_t* inputPtr = compressedData;
-    uint32_t* outputPtr = reinterpret_cast<uint32_t*>(outputVertices);
+    // Phase 1 - Six compression parameters (24 bytes): per-axis scale and offset
+    PackedVertexKernel::CompressionParams params;
+    if (!PackedVertexKernel::ReadCompressionParams(compressedData, params)) {
+        return ErrorHandler::PostEvent(0x6A, "Invalid DecrunchDots compression parameters");
+    }
     
-    // RFC VALIDATED: Phase 1 - Skip 6 compression parameters (lines 31-42)
-    // Total: 24 bytes skipped
-    inputPtr += 4;  // Skip param 1
-    inputPtr += 4;  // Skip param 2
-    inputPtr += 4;  // Skip param 3
-    inputPtr += 4;  // Skip param 4
-    inputPtr += 4;  // Skip param 5
-    inputPtr += 4;  // Skip param 6
+    // Phase 2 - Expand each 6-byte int16 triple to one output vertex:
+    // x, y, z followed by zero floats (five in the sub_4F2950 layout)
+    std::memset(outputVertices, 0, CalculateOutputSize(vertexCount, outputStride) * sizeof(float));
+    PackedVertexKernel::DecompressVertices(params, compressedData + PackedVertexKernel::COMPRESSION_PARAMS_SIZE,
+                                           outputVertices, outputStride, vertexCount, stats);
     
-    // RFC VALIDATED: Phase 2 - Process each vertex (lines 43-62)
-    for (size_t i = 0; i < vertexCount; i++) {
-        // RFC VALIDATED: Read 3 int16 values (6 bytes) from compressed data (lines 48-52)
-        inputPtr += 2;  // Skip to X coordinate (int16)
-        inputPtr += 2;  // Skip to Y coordinate (int16)  
-        inputPtr += 2;  // Skip to Z coordinate (int16)
+    // RFC VALIDATED: Add terminator (line 63)
+    uint32_t terminator = GlobalVariables::GetVertexTerminator();
+    std::memcpy(outputVertices + CalculateOutputSize(vertexCount, outputStride), &terminator, sizeof(terminator));
+    
+    return true;
+}
+
+size_t VertexProcessor::GetTileVertexCount(size_t outputStride) {
+    // Whole 64-vertex groups keep tile stats aligned to invalid-mask words
+    size_t vertices = TILE_OUTPUT_BYTES / (std::max<size_t>(outputStride, 3) * sizeof(float));
+    return std::max<size_t>(vertices / 64 * 64, 64);
+}
+
+void VertexProcessor::DecodeTile(const VertexJob& job, const PackedVertexKernel::CompressionParams& params,
+                                 size_t first, size_t count, PackedVertexKernel::DecodeStats* stats) {
+    const uint8_t* input = job.input.data();
+    float* output = job.output + first * job.outputStride;
+    
+    switch (job.algorithm) {
+        case Algorithm::PackedToFloat:
+            ConvertPackedRange(reinterpret_cast<const uint32_t*>(input) + first * 3, output, count,
+                               job.outputStride, stats);
+            break;
+            
+        case Algorithm::PackedToFloat3Comp:
+            ConvertPacked3ComponentRange(reinterpret_cast<const uint32_t*>(input) + first * 3, output, count,
+                                         job.outputStride, stats);
+            break;
+            
+        case Algorithm::DecrunchDots:
+            std::memset(output, 0, CalculateOutputSize(count, job.outputStride) * sizeof(float));
+            PackedVertexKernel::DecompressVertices(params,
+                input + PackedVertexKernel::COMPRESSION_PARAMS_SIZE + first * PackedVertexKernel::COMPRESSED_VERTEX_SIZE,
+                output, job.outputStride, count, stats);
+            break;
+    }
+}
+
+bool VertexProcessor::ProcessBatch(std::vector<VertexJob>& jobs, ThreadPool* pool) {
+    struct Tile {
+        size_t job;
+        size_t first;
+        size_t count;
+    };
+    
+    std::vector<Tile> tiles;
+    std::vector<PackedVertexKernel::CompressionParams> params(jobs.size());
+    
+    // Validate every job once, up front, instead of per tile
+    for (size_t j = 0; j < jobs.size(); j++) {
+        VertexJob& job = jobs[j];
+        job.succeeded = false;
+        job.tileCount = 0;
+        job.stats.Reset(0);
         
-        // RFC VALIDATED: Apply sub_4F2950 transformation (line 53)
-        uint32_t localBuffer[8];  // This is v13 from original code
-        uint32_t tempOutput[8];   // This is v12 from original code
+        std::string problem;
+        if (!job.input.data() || !job.output || job.vertexCount == 0 || job.outputStride < 3) {
+            problem = "invalid parameters";
+        } else if (CalculateInputSize(job.algorithm, job.vertexCount) == 0 ||
+                   job.input.size() < CalculateInputSize(job.algorithm, job.vertexCount)) {
+            problem = "input too small";
+        } else if (job.outputSize < CalculateOutputSize(job.vertexCount, job.outputStride) + 1) {
+            problem = "output too small";
+        } else if (job.algorithm == Algorithm::DecrunchDots &&
+                   !PackedVertexKernel::ReadCompressionParams(job.input.data(), params[j])) {
+            problem = "invalid compression parameters";
+        }
         
-        Sub4F2950Rearrangement(localBuffer, tempOutput);
+        if (!problem.empty()) {
+            ErrorHandler::PostEvent(0x6A, "Vertex batch job " + std::to_string(j) + ": " + problem);
+            continue;
+        }
         
-        // RFC VALIDATED: Copy transformed data to output (32 bytes) (line 58)
-        std::memcpy(outputPtr, tempOutput, 32);  // 0x20u = 32 bytes
-        outputPtr += 8;  // Advance by 8 DWORDs (32 bytes)
+        size_t tileVertices = GetTileVertexCount(job.outputStride);
+        for (size_t first = 0; first < job.vertexCount; first += tileVertices) {
+            tiles.push_back({ j, first, std::min(tileVertices, job.vertexCount - first) });
+            job.tileCount++;
+        }
+        job.succeeded = true;
     }
     
-    // RFC VALIDATED: Add terminator (line 63)
-    *outputPtr = GlobalVariables::GetVertexTerminator();
+    // Tiles write disjoint vertex ranges; stats go to per-tile slots
+    std::vector<PackedVertexKernel::DecodeStats> tileStats(tiles.size());
+    std::vector<char> tileFailed(tiles.size(), 0);
     
-    return true;
-}
-
-void VertexProcessor::Sub4F2950Rearrangement(const uint32_t* input, uint32_t* output) {
-    // RFC VALIDATED: Exact algorithm from sub_4F2950.cpp lines 6-10
-    // Creates 8-DWORD output buffer from 3-DWORD input with specific rearrangement
+    auto runTile = [&](size_t t) {
+        const Tile& tile = tiles[t];
+        const VertexJob& job = jobs[tile.job];
+        DecodeTile(job, params[tile.job], tile.first, tile.count, job.gatherStats ? &tileStats[t] : nullptr);
+    };
     
-    uint32_t temp[8] = {0};  // v4[8] from original
+    // A worker of the pool waiting on its own tiles could block every worker, so it runs them itself
+    size_t worker;
+    if (pool && tiles.size() > 1 && !pool->GetCurrentWorker(worker)) {
+        std::vector<std::future<void>> pending;
+        pending.reserve(tiles.size());
+        try {
+            for (size_t t = 0; t < tiles.size(); t++) {
+                pending.push_back(pool->Submit([&runTile, t]() { runTile(t); }));
+            }
+        } catch (...) {
+            // Queued tiles reference this frame: let them finish before unwinding it
+            for (auto& tile : pending) {
+                tile.wait();
+            }
+            throw;
+        }
+        for (size_t t = 0; t < pending.size(); t++) {
+            try {
+                pending[t].get();
+            } catch (const std::exception& e) {
+                ErrorHandler::PostEvent(0x6A, std::string("Vertex batch tile threw: ") + e.what());
+                tileFailed[t] = 1;
+            }
+        }
+    } else {
+        for (size_t t = 0; t < tiles.size(); t++) {
+            runTile(t);
+        }
+    }
     
-    // RFC VALIDATED: Rearrangement pattern (lines 7-9)
-    temp[0] = input[0];      // *this
-    temp[1] = input[1];      // *(this + 1) 
-    temp[2] = input[2];      // *(this + 2)
-    // temp[3] through temp[7] remain zero-initialized
+    // Per job, in vertex order: stats, then the single terminator
+    for (size_t t = 0; t < tiles.size(); t++) {
+        VertexJob& job = jobs[tiles[t].job];
+        if (tileFailed[t]) {
+            job.succeeded = false;
+        }
+        if (job.gatherStats) {
+            if (tiles[t].first == 0) {
+                job.stats.Reset(job.vertexCount);
+            }
+            job.stats.Merge(tileStats[t], tiles[t].first);
+        }
+    }
     
-    // RFC VALIDATED: Copy 32 bytes to output (line 10)
-    std::memcpy(output, temp, 32);  // 0x20u = 32 bytes
+    bool allSucceeded = true;
+    uint32_t terminator = GlobalVariables::GetVertexTerminator();
+    for (auto& job : jobs) {
+        if (job.tileCount > 0) {
+            std::memcpy(job.output + CalculateOutputSize(job.vertexCount, job.outputStride), &terminator, sizeof(terminator));
+        }
+        allSucceeded &= job.succeeded;
+    }
+    return allSucceeded;
 }
 
 size_t VertexProcessor::CalculateInputSize(Algorithm algorithm, size_t vertexCount) {
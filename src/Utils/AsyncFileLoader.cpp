@@ -0,0 +1,620 @@
+#include "AsyncFileLoader.h"
+#include "ThreadPool.h"
+#include "ErrorHandler.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <numeric>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define LOADER_OPEN(name)                ::_open(name, _O_RDONLY | _O_BINARY)
+#define LOADER_READ(fd, buf, count, off) ::_read(fd, buf, static_cast<unsigned int>(count))
+#define LOADER_CLOSE(fd)                 ::_close(fd)
+#define LOADER_FSTAT(fd, st)             ::_fstat64(fd, st)
+typedef struct _stat64 LoaderStat;
+#else
+#include <unistd.h>
+#define LOADER_OPEN(name)                ::open(name, O_RDONLY | O_CLOEXEC)
+#define LOADER_READ(fd, buf, count, off) ::pread(fd, buf, count, static_cast<off_t>(off))
+#define LOADER_CLOSE(fd)                 ::close(fd)
+#define LOADER_FSTAT(fd, st)             ::fstat(fd, st)
+typedef struct stat LoaderStat;
+#endif
+
+// The opcodes used below (OPENAT, STATX, READ, CLOSE) first appeared in the
+// Linux 5.6 headers; IORING_FEAT_RW_CUR_POS is a macro of the same release.
+// Older headers build the thread pool backend only.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_FEAT_RW_CUR_POS
+#define SHAPELOADER_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifdef SHAPELOADER_HAS_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace {
+
+/**
+ * Minimal io_uring wrapper over the raw syscalls (no liburing dependency)
+ */
+class IoUring {
+public:
+    IoUring()
+        : fd_(-1), sqRing_(MAP_FAILED), cqRing_(MAP_FAILED), sqes_(nullptr),
+          sqRingSize_(0), cqRingSize_(0), sqesSize_(0), sqeTail_(0), sqeSubmitted_(0) {
+    }
+
+    ~IoUring() {
+        Close();
+    }
+
+    bool Open(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return false;
+        }
+        fd_ = fd;
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            sqRingSize_ = cqRingSize_ = sqRingSize_ > cqRingSize_ ? sqRingSize_ : cqRingSize_;
+        }
+
+        sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sqRing_ == MAP_FAILED) {
+            Close();
+            return false;
+        }
+
+        if (singleMap) {
+            cqRing_ = sqRing_;
+        } else {
+            cqRing_ = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            if (cqRing_ == MAP_FAILED) {
+                Close();
+                return false;
+            }
+        }
+
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            Close();
+            return false;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        uint8_t* sq = static_cast<uint8_t*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries_ = params.sq_entries;
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        uint8_t* cq = static_cast<uint8_t*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        sqeTail_ = sqeSubmitted_ = *sqTail_;
+        return true;
+    }
+
+    void Close() {
+        if (sqes_) {
+            munmap(sqes_, sqesSize_);
+            sqes_ = nullptr;
+        }
+        if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+            munmap(cqRing_, cqRingSize_);
+        }
+        cqRing_ = MAP_FAILED;
+        if (sqRing_ != MAP_FAILED) {
+            munmap(sqRing_, sqRingSize_);
+            sqRing_ = MAP_FAILED;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /**
+     * Get a zeroed submission entry
+     * @return nullptr if the submission queue is full
+     */
+    io_uring_sqe* GetSqe() {
+        unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (sqeTail_ - head >= sqEntries_) {
+            return nullptr;
+        }
+
+        unsigned index = sqeTail_ & sqMask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        sqeTail_++;
+        return sqe;
+    }
+
+    /**
+     * Submit queued entries and optionally wait for completions
+     * @return Number of entries submitted, or -errno
+     */
+    int Submit(unsigned waitFor) {
+        __atomic_store_n(sqTail_, sqeTail_, __ATOMIC_RELEASE);
+        unsigned toSubmit = sqeTail_ - sqeSubmitted_;
+        unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+        for (;;) {
+            int result = static_cast<int>(syscall(__NR_io_uring_enter, fd_, toSubmit, waitFor, flags, nullptr, 0));
+            if (result >= 0) {
+                sqeSubmitted_ += static_cast<unsigned>(result);
+                return result;
+            }
+            if (errno != EINTR) {
+                return -errno;
+            }
+        }
+    }
+
+    /**
+     * Sequence number the next GetSqe entry will get
+     */
+    unsigned GetQueuedCount() const {
+        return sqeTail_;
+    }
+
+    /**
+     * Check whether the entry with this sequence number has reached the kernel
+     */
+    bool IsSubmitted(unsigned sequence) const {
+        return sequence - sqeSubmitted_ >= sqeTail_ - sqeSubmitted_;
+    }
+
+    /**
+     * Take the next completion if one is ready
+     */
+    bool PopCompletion(io_uring_cqe& cqe) {
+        unsigned head = *cqHead_;
+        if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+
+        cqe = cqes_[head & cqMask_];
+        __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    int fd_;
+    void* sqRing_;
+    void* cqRing_;
+    io_uring_sqe* sqes_;
+    size_t sqRingSize_;
+    size_t cqRingSize_;
+    size_t sqesSize_;
+
+    unsigned* sqHead_;
+    unsigned* sqTail_;
+    unsigned* sqArray_;
+    unsigned sqMask_;
+    unsigned sqEntries_;
+    unsigned sqeTail_;          // Local tail, published to the kernel by Submit
+    unsigned sqeSubmitted_;
+
+    unsigned* cqHead_;
+    unsigned* cqTail_;
+    unsigned cqMask_;
+    io_uring_cqe* cqes_;
+};
+
+enum LoaderOp : uint64_t {
+    OP_OPEN = 0,
+    OP_STATX = 1,
+    OP_READ = 2,
+    OP_CLOSE = 3
+};
+
+/**
+ * One file being loaded through the ring
+ * Open and statx run concurrently; the read is queued once both are done.
+ */
+struct RingSlot {
+    bool busy = false;
+    LoadedFile file;
+    int fd = -1;
+    struct statx stx;           // Written by the kernel, address must stay stable
+    unsigned pendingOps = 0;
+    size_t fileSize = 0;
+    size_t offset = 0;
+    int error = 0;
+    bool closing = false;       // IORING_OP_CLOSE queued for fd
+    unsigned closeSequence = 0;
+};
+
+inline uint64_t MakeUserData(size_t slot, LoaderOp op) {
+    return (static_cast<uint64_t>(slot) << 2) | op;
+}
+
+} // namespace
+#endif // SHAPELOADER_HAS_IO_URING
+
+static std::vector<size_t> AllIndices(size_t count) {
+    std::vector<size_t> indices(count);
+    std::iota(indices.begin(), indices.end(), size_t(0));
+    return indices;
+}
+
+AsyncFileLoader::AsyncFileLoader(unsigned queueDepth)
+    : queueDepth_(queueDepth > 0 ? queueDepth : 1),
+      backend_(IsIoUringAvailable() ? Backend::IoUring : Backend::ThreadPool),
+      bytesLoaded_(0),
+      filesFailed_(0),
+      submitCalls_(0) {
+}
+
+void AsyncFileLoader::SetBackend(Backend backend) {
+    if (backend == Backend::IoUring && !IsIoUringAvailable()) {
+        backend = Backend::ThreadPool;
+    }
+    backend_ = backend;
+}
+
+bool AsyncFileLoader::IsIoUringAvailable() {
+#ifdef SHAPELOADER_HAS_IO_URING
+    // Kernels without io_uring return ENOSYS; sandboxes and containers may forbid it with EPERM
+    static const bool available = []() {
+        IoUring ring;
+        return ring.Open(1);
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+const char* AsyncFileLoader::GetBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::IoUring:    return "io_uring";
+        case Backend::ThreadPool: return "thread pool";
+        default:                  return "unknown";
+    }
+}
+
+bool AsyncFileLoader::LoadAll(const std::vector<std::string>& paths, const CompletionHandler& handler) {
+    bytesLoaded_ = 0;
+    filesFailed_ = 0;
+    submitCalls_ = 0;
+
+    if (paths.empty()) {
+        return true;
+    }
+
+    if (backend_ == Backend::IoUring) {
+        LoadWithIoUring(paths, handler);
+    } else {
+        LoadWithThreadPool(paths, AllIndices(paths.size()), handler);
+    }
+    return filesFailed_ == 0;
+}
+
+void AsyncFileLoader::Deliver(LoadedFile& file, const CompletionHandler& handler) {
+    if (file.success) {
+        bytesLoaded_ += file.data.size();
+    } else {
+        filesFailed_++;
+        file.data.clear();
+    }
+    handler(file);
+}
+
+bool AsyncFileLoader::ReadWholeFile(const std::string& path, FileBuffer& data, std::string& error) {
+    data.clear();
+
+    int fd = LOADER_OPEN(path.c_str());
+    if (fd < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+
+    LoaderStat st;
+    if (LOADER_FSTAT(fd, &st) != 0) {
+        error = std::strerror(errno);
+        LOADER_CLOSE(fd);
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(st.st_size));
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto result = LOADER_READ(fd, data.data() + offset, data.size() - offset, offset);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::strerror(errno);
+            LOADER_CLOSE(fd);
+            data.clear();
+            return false;
+        }
+        if (result == 0) {
+            break;      // File shrank since fstat
+        }
+        offset += static_cast<size_t>(result);
+    }
+    data.resize(offset);
+
+    LOADER_CLOSE(fd);
+    return true;
+}
+
+void AsyncFileLoader::LoadWithThreadPool(const std::vector<std::string>& paths, const std::vector<size_t>& indices,
+                                         const CompletionHandler& handler) {
+    // Declared before the pool so they outlive its workers
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<LoadedFile> completed;
+
+    // Reads block, so use more threads than cores would suggest, capped by the queue depth
+    unsigned threadCount = queueDepth_ < 8 ? queueDepth_ : 8;
+    ThreadPool pool(threadCount);
+
+    size_t next = 0;
+    auto submitNext = [&]() {
+        size_t index = indices[next++];
+        pool.Submit([&, index]() {
+            LoadedFile file;
+            file.index = index;
+            file.path = paths[index];
+            file.success = ReadWholeFile(file.path, file.data, file.error);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            completed.push_back(std::move(file));
+            condition.notify_one();
+        });
+    };
+
+    while (next < indices.size() && next < queueDepth_) {
+        submitNext();
+    }
+
+    for (size_t delivered = 0; delivered < indices.size(); delivered++) {
+        LoadedFile file;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return !completed.empty(); });
+            file = std::move(completed.front());
+            completed.pop_front();
+        }
+
+        // Keep the queue full before handing the file over
+        if (next < indices.size()) {
+            submitNext();
+        }
+        Deliver(file, handler);
+    }
+}
+
+void AsyncFileLoader::LoadWithIoUring(const std::vector<std::string>& paths, const CompletionHandler& handler) {
+#ifdef SHAPELOADER_HAS_IO_URING
+    // Each file has at most two operations in flight (open + statx)
+    IoUring ring;
+    if (!ring.Open(queueDepth_ * 2)) {
+        ErrorHandler::PostEvent(0x6A, "io_uring setup failed, loading with worker threads");
+        LoadWithThreadPool(paths, AllIndices(paths.size()), handler);
+        return;
+    }
+
+    std::vector<RingSlot> slots(queueDepth_);
+    std::vector<size_t> freeSlots;
+    for (size_t i = slots.size(); i > 0; i--) {
+        freeSlots.push_back(i - 1);
+    }
+
+    size_t next = 0;
+    size_t active = 0;
+
+    auto queueRead = [&](size_t slotIndex) {
+        RingSlot& slot = slots[slotIndex];
+        io_uring_sqe* sqe = ring.GetSqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = slot.fd;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.file.data.data() + slot.offset);
+        // Length field is 32 bits; larger files take several reads
+        size_t remaining = slot.fileSize - slot.offset;
+        sqe->len = static_cast<uint32_t>(remaining < (1u << 30) ? remaining : (1u << 30));
+        sqe->off = slot.offset;
+        sqe->user_data = MakeUserData(slotIndex, OP_READ);
+        slot.pendingOps = 1;
+    };
+
+    // Hand the file over now; the slot stays busy until its descriptor is closed
+    auto finish = [&](size_t slotIndex) {
+        RingSlot& slot = slots[slotIndex];
+        if (slot.error == EINVAL) {
+            // Opcode not supported by this kernel - read this file the blocking way
+            slot.file.success = ReadWholeFile(slot.file.path, slot.file.data, slot.file.error);
+        } else if (slot.error != 0) {
+            slot.file.success = false;
+            slot.file.error = std::strerror(slot.error);
+        } else {
+            slot.file.data.resize(slot.offset);
+            slot.file.success = true;
+        }
+        Deliver(slot.file, handler);
+        slot.file = LoadedFile();
+
+        if (slot.fd >= 0) {
+            slot.closing = true;
+            slot.closeSequence = ring.GetQueuedCount();
+            io_uring_sqe* sqe = ring.GetSqe();
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = slot.fd;
+            sqe->user_data = MakeUserData(slotIndex, OP_CLOSE);
+            slot.pendingOps = 1;
+        } else {
+            slot.busy = false;
+            freeSlots.push_back(slotIndex);
+            active--;
+        }
+    };
+
+    auto startFile = [&]() {
+        size_t slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+
+        RingSlot& slot = slots[slotIndex];
+        slot.busy = true;
+        slot.file.index = next;
+        slot.file.path = paths[next];
+        slot.fd = -1;
+        slot.fileSize = 0;
+        slot.offset = 0;
+        slot.error = 0;
+        slot.closing = false;
+        slot.pendingOps = 2;
+        next++;
+        active++;
+
+        io_uring_sqe* open = ring.GetSqe();
+        open->opcode = IORING_OP_OPENAT;
+        open->fd = AT_FDCWD;
+        open->addr = reinterpret_cast<uint64_t>(slot.file.path.c_str());
+        open->open_flags = O_RDONLY | O_CLOEXEC;
+        open->user_data = MakeUserData(slotIndex, OP_OPEN);
+
+        io_uring_sqe* stat = ring.GetSqe();
+        stat->opcode = IORING_OP_STATX;
+        stat->fd = AT_FDCWD;
+        stat->addr = reinterpret_cast<uint64_t>(slot.file.path.c_str());
+        stat->len = STATX_SIZE;
+        stat->off = reinterpret_cast<uint64_t>(&slot.stx);
+        stat->user_data = MakeUserData(slotIndex, OP_STATX);
+    };
+
+    while (next < paths.size() || active > 0) {
+        while (next < paths.size() && !freeSlots.empty()) {
+            startFile();
+        }
+
+        int submitted = ring.Submit(1);
+        submitCalls_++;
+        if (submitted < 0 && submitted != -EAGAIN && submitted != -EBUSY) {
+            // Ring unusable: load the files in flight and the rest with threads
+            ErrorHandler::PostEvent(0x6A, std::string("io_uring_enter failed: ") + std::strerror(-submitted));
+            
+            // Descriptors opened or closed by operations that did complete
+            io_uring_cqe cqe;
+            while (ring.PopCompletion(cqe)) {
+                RingSlot& slot = slots[static_cast<size_t>(cqe.user_data >> 2)];
+                LoaderOp op = static_cast<LoaderOp>(cqe.user_data & 3);
+                if (op == OP_OPEN && cqe.res >= 0) {
+                    slot.fd = cqe.res;
+                } else if (op == OP_CLOSE) {
+                    if (cqe.res != -EINVAL) slot.fd = -1;
+                    slot.closing = false;
+                }
+            }
+            
+            std::vector<size_t> retry;
+            for (RingSlot& slot : slots) {
+                if (!slot.busy) {
+                    continue;
+                }
+                // A close that reached the kernel still runs; any other descriptor is ours to close
+                if (slot.fd >= 0 && !(slot.closing && ring.IsSubmitted(slot.closeSequence))) {
+                    ::close(slot.fd);
+                }
+                if (!slot.file.path.empty()) {
+                    retry.push_back(slot.file.index);
+                }
+            }
+            ring.Close();
+            
+            std::sort(retry.begin(), retry.end());
+            for (size_t i = next; i < paths.size(); i++) {
+                retry.push_back(i);
+            }
+            LoadWithThreadPool(paths, retry, handler);
+            return;
+        }
+
+        io_uring_cqe cqe;
+        while (ring.PopCompletion(cqe)) {
+            size_t slotIndex = static_cast<size_t>(cqe.user_data >> 2);
+            LoaderOp op = static_cast<LoaderOp>(cqe.user_data & 3);
+            RingSlot& slot = slots[slotIndex];
+
+            switch (op) {
+                case OP_OPEN:
+                case OP_STATX:
+                    if (cqe.res < 0) {
+                        if (slot.error == 0) slot.error = -cqe.res;
+                    } else if (op == OP_OPEN) {
+                        slot.fd = cqe.res;
+                    } else {
+                        slot.fileSize = static_cast<size_t>(slot.stx.stx_size);
+                    }
+
+                    if (--slot.pendingOps == 0) {
+                        if (slot.error != 0 || slot.fileSize == 0) {
+                            finish(slotIndex);
+                        } else {
+                            slot.file.data.resize(slot.fileSize);
+                            queueRead(slotIndex);
+                        }
+                    }
+                    break;
+
+                case OP_READ:
+                    if (cqe.res == -EAGAIN || cqe.res == -EINTR) {
+                        queueRead(slotIndex);
+                    } else if (cqe.res < 0) {
+                        slot.error = -cqe.res;
+                        finish(slotIndex);
+                    } else if (cqe.res == 0) {
+                        finish(slotIndex);      // File shrank since statx
+                    } else {
+                        slot.offset += static_cast<size_t>(cqe.res);
+                        if (slot.offset < slot.fileSize) {
+                            queueRead(slotIndex);
+                        } else {
+                            finish(slotIndex);
+                        }
+                    }
+                    break;
+
+                case OP_CLOSE:
+                    if (cqe.res == -EINVAL) {
+                        ::close(slot.fd);       // IORING_OP_CLOSE not supported
+                    }
+                    slot.fd = -1;
+                    slot.busy = false;
+                    freeSlots.push_back(slotIndex);
+                    active--;
+                    break;
+            }
+        }
+    }
+#else
+    LoadWithThreadPool(paths, AllIndices(paths.size()), handler);
+#endif
+}
@@ -0,0 +1,123 @@
+#include "BatchFileList.h"
+#include "ErrorHandler.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+bool BatchFileList::Collect(const std::string& spec, std::vector<BatchFile>& files) {
+    files.clear();
+
+    bool success;
+    std::error_code ec;
+
+    if (!spec.empty() && spec[0] == '@') {
+        success = CollectFromList(spec.substr(1), files);
+    } else if (std::filesystem::is_directory(spec, ec)) {
+        success = CollectFromDirectory(spec, nullptr, files);
+    } else {
+        std::filesystem::path patternPath(spec);
+        std::string pattern = patternPath.filename().string();
+
+        if (pattern.find_first_of("*?") == std::string::npos) {
+            files.push_back(MakeEntry(spec));
+            success = true;
+        } else {
+            std::filesystem::path directory = patternPath.has_parent_path() ? patternPath.parent_path()
+                                                                             : std::filesystem::path(".");
+            success = CollectFromDirectory(directory, pattern.c_str(), files);
+        }
+    }
+
+    SortLargestFirst(files);
+    return success;
+}
+
+void BatchFileList::SortLargestFirst(std::vector<BatchFile>& files) {
+    std::stable_sort(files.begin(), files.end(), [](const BatchFile& a, const BatchFile& b) {
+        return a.size > b.size;
+    });
+}
+
+bool BatchFileList::MatchWildcard(const char* pattern, const char* name) {
+    // Greedy match with backtracking to the last '*'
+    const char* starPattern = nullptr;
+    const char* starName = nullptr;
+
+    while (*name) {
+        if (*pattern == '*') {
+            starPattern = ++pattern;
+            starName = name;
+        } else if (*pattern == '?' || *pattern == *name) {
+            pattern++;
+            name++;
+        } else if (starPattern) {
+            pattern = starPattern;
+            name = ++starName;
+        } else {
+            return false;
+        }
+    }
+
+    while (*pattern == '*') {
+        pattern++;
+    }
+    return *pattern == '\0';
+}
+
+bool BatchFileList::Is3GMFile(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return extension == ".3gm";
+}
+
+bool BatchFileList::CollectFromList(const std::string& listFile, std::vector<BatchFile>& files) {
+    std::ifstream list(listFile);
+    if (!list.is_open()) {
+        return ErrorHandler::PostEvent(0x6A, "Could not open file list: " + listFile);
+    }
+
+    std::string line;
+    while (std::getline(list, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] != '#') {
+            files.push_back(MakeEntry(line));
+        }
+    }
+    return true;
+}
+
+bool BatchFileList::CollectFromDirectory(const std::filesystem::path& directory, const char* pattern,
+                                         std::vector<BatchFile>& files) {
+    std::error_code ec;
+    std::filesystem::directory_iterator it(directory, ec);
+
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        const std::filesystem::path& path = it->path();
+        std::error_code entryError;
+        if (!it->is_regular_file(entryError)) {
+            continue;
+        }
+
+        bool match = pattern ? MatchWildcard(pattern, path.filename().string().c_str()) : Is3GMFile(path);
+        if (match) {
+            files.push_back(MakeEntry(path.string()));
+        }
+    }
+
+    if (ec) {
+        return ErrorHandler::PostEvent(0x6A, "Could not list directory " + directory.string() + ": " + ec.message());
+    }
+    return true;
+}
+
+BatchFile BatchFileList::MakeEntry(const std::string& path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+
+    // Unreadable files are kept; the conversion reports them as failed
+    return BatchFile(path, ec ? 0 : size);
+}
@@ -0,0 +1,99 @@
+#include "ByteSource.h"
+#include "ErrorHandler.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define SOURCE_OPEN(name)            ::_open(name, _O_RDONLY | _O_BINARY)
+#define SOURCE_READ(fd, buf, count)  ::_read(fd, buf, static_cast<unsigned int>(count))
+#define SOURCE_CLOSE(fd)             ::_close(fd)
+#else
+#include <unistd.h>
+#define SOURCE_OPEN(name)            ::open(name, O_RDONLY | O_CLOEXEC)
+#define SOURCE_READ(fd, buf, count)  ::read(fd, buf, count)
+#define SOURCE_CLOSE(fd)             ::close(fd)
+#endif
+
+FileDescriptorSource::FileDescriptorSource()
+    : fd_(-1), ownsDescriptor_(false), error_(false) {
+}
+
+FileDescriptorSource::FileDescriptorSource(int fd, bool ownsDescriptor)
+    : fd_(fd), ownsDescriptor_(ownsDescriptor), error_(false) {
+}
+
+FileDescriptorSource::~FileDescriptorSource() {
+    Close();
+}
+
+bool FileDescriptorSource::Open(const std::string& filename) {
+    Close();
+    error_ = false;
+
+    if (filename == "-") {
+        fd_ = 0;
+        ownsDescriptor_ = false;
+        return true;
+    }
+
+    int fd = SOURCE_OPEN(filename.c_str());
+    if (fd < 0) {
+        ErrorHandler::PostEvent(0x6A, "Could not open file: " + filename);
+        return false;
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL) && !defined(_WIN32)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    fd_ = fd;
+    ownsDescriptor_ = true;
+    return true;
+}
+
+void FileDescriptorSource::Close() {
+    if (fd_ >= 0 && ownsDescriptor_) {
+        SOURCE_CLOSE(fd_);
+    }
+    fd_ = -1;
+    ownsDescriptor_ = false;
+}
+
+size_t FileDescriptorSource::Read(uint8_t* buffer, size_t count) {
+    if (fd_ < 0 || count == 0) {
+        return 0;
+    }
+
+    for (;;) {
+        auto result = SOURCE_READ(fd_, buffer, count);
+        if (result >= 0) {
+            return static_cast<size_t>(result);
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        error_ = true;
+        ErrorHandler::PostEvent(0x6A, std::string("Read error: ") + std::strerror(errno));
+        return 0;
+    }
+}
+
+MemorySource::MemorySource(const uint8_t* data, size_t size)
+    : data_(data, size), offset_(0) {
+}
+
+MemorySource::MemorySource(ByteSpan data)
+    : data_(data), offset_(0) {
+}
+
+size_t MemorySource::Read(uint8_t* buffer, size_t count) {
+    size_t available = data_.size() - offset_;
+    size_t bytes = count < available ? count : available;
+    if (bytes > 0) {
+        std::memcpy(buffer, data_.data() + offset_, bytes);
+        offset_ += bytes;
+    }
+    return bytes;
+}
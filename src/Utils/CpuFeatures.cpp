@@ -0,0 +1,74 @@
+#include "CpuFeatures.h"
+
+#if defined(SHAPELOADER_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct DetectedFeatures {
+    bool sse2;
+    bool ssse3;
+    bool avx2;
+    bool f16c;
+
+    DetectedFeatures() : sse2(false), ssse3(false), avx2(false), f16c(false) {
+#if defined(SHAPELOADER_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        sse2 = __builtin_cpu_supports("sse2");
+        ssse3 = __builtin_cpu_supports("ssse3");
+        avx2 = __builtin_cpu_supports("avx2");   // Includes OS YMM state check
+        f16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+#elif defined(SHAPELOADER_X86) && defined(_MSC_VER)
+        int info[4] = {0, 0, 0, 0};
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        sse2 = (info[3] & (1 << 26)) != 0;
+        ssse3 = (info[2] & (1 << 9)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        // AVX registers are only usable if the OS saves YMM state
+        bool ymmEnabled = osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6);
+        f16c = ymmEnabled && (info[2] & (1 << 29)) != 0;
+
+        if (maxLeaf >= 7 && ymmEnabled) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#endif
+    }
+};
+
+const DetectedFeatures& GetFeatures() {
+    static const DetectedFeatures features;
+    return features;
+}
+
+} // anonymous namespace
+
+bool CpuFeatures::HasSSE2() {
+    return GetFeatures().sse2;
+}
+
+bool CpuFeatures::HasSSSE3() {
+    return GetFeatures().ssse3;
+}
+
+bool CpuFeatures::HasAVX2() {
+    return GetFeatures().avx2;
+}
+
+bool CpuFeatures::HasF16C() {
+    return GetFeatures().f16c;
+}
+
+const char* CpuFeatures::GetDescription() {
+    if (HasAVX2()) return "AVX2";
+    if (HasSSSE3()) return "SSSE3";
+    if (HasSSE2()) return "SSE2";
+    return "scalar";
+}
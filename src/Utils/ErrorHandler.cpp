@@ -5,10 +5,10 @@
 namespace ErrorHandler {
 
 // Global error state (matches original last_processed_event)
-bool g_lastProcessedEvent = false;
+std::atomic<bool> g_lastProcessedEvent(false);
 
 // Debug mode flag
-static bool g_debugMode = false;
+static std::atomic<bool> g_debugMode(false);
 
 bool ProcessEvent(uint32_t errorCode) {
     if (g_debugMode) {
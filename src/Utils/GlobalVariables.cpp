@@ -1,8 +1,9 @@
 #include "GlobalVariables.h"
+#include "SurfaceGenerator.h"
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
-class SurfaceGenerator;  // Forward declaration
 
 namespace GlobalVariables {
 
@@ -75,7 +76,7 @@ bool InitializeGlobals() {
     // RFC analysis shows this is used as a sentinel value in float arrays
     // Using quiet NaN as a safe sentinel value
     float nanValue = std::numeric_limits<float>::quiet_NaN();
-    g_vertexTerminator = *reinterpret_cast<uint32_t*>(&nanValue);
+    std::memcpy(&g_vertexTerminator, &nanValue, sizeof(g_vertexTerminator));
     
     // Initialize primitive flags to clean state
     g_primitiveFlags = 0;
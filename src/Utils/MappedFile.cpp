@@ -0,0 +1,224 @@
+#include "MappedFile.h"
+#include "ErrorHandler.h"
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : data_(nullptr), size_(0), mapped_(false)
+#ifdef _WIN32
+    , fileHandle_(nullptr), mappingHandle_(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(nullptr), size_(0), mapped_(false)
+#ifdef _WIN32
+    , fileHandle_(nullptr), mappingHandle_(nullptr)
+#endif
+{
+    MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other) {
+    data_ = other.data_;
+    size_ = other.size_;
+    mapped_ = other.mapped_;
+    fallbackBuffer_ = std::move(other.fallbackBuffer_);
+#ifdef _WIN32
+    fileHandle_ = other.fileHandle_;
+    mappingHandle_ = other.mappingHandle_;
+    other.fileHandle_ = nullptr;
+    other.mappingHandle_ = nullptr;
+#endif
+    // Fallback data lives in the moved vector, so data_ stays valid
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+bool MappedFile::Open(const std::string& filename, const Options& options) {
+    Close();
+
+    if (!options.forceRead) {
+        bool openFailed = false;
+        if (MapFile(filename, options, openFailed)) {
+            return true;
+        }
+        // Already reported; read() cannot open it either
+        if (openFailed) {
+            return false;
+        }
+        if (!options.allowFallback) {
+            return ErrorHandler::PostEvent(0x6A, "Could not map file: " + filename);
+        }
+    }
+
+    return ReadFile(filename);
+}
+
+void MappedFile::Close() {
+    if (mapped_ && data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        if (mappingHandle_) CloseHandle(mappingHandle_);
+        if (fileHandle_) CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+
+    fallbackBuffer_.clear();
+    fallbackBuffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::MapFile(const std::string& filename, const Options& options, bool& openFailed) {
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (options.sequential) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    }
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        ErrorHandler::PostEvent(0x6A, "Could not open file: " + filename);
+        openFailed = true;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    mapped_ = true;
+    return true;
+}
+
+#else
+
+bool MappedFile::MapFile(const std::string& filename, const Options& options, bool& openFailed) {
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        ErrorHandler::PostEvent(0x6A, "Could not open file: " + filename);
+        openFailed = true;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        // Pipes and special files cannot be mapped - use read() fallback
+        ::close(fd);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(st.st_size);
+
+    int mapFlags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+        mapFlags |= MAP_POPULATE;
+    }
+#endif
+
+    void* view = mmap(nullptr, fileSize, PROT_READ, mapFlags, fd, 0);
+    ::close(fd);  // Mapping keeps its own reference to the file
+
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    if (options.sequential) {
+        madvise(view, fileSize, MADV_SEQUENTIAL);
+    }
+#endif
+#if !defined(MAP_POPULATE) && defined(MADV_WILLNEED)
+    if (options.populate) {
+        madvise(view, fileSize, MADV_WILLNEED);
+    }
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = fileSize;
+    mapped_ = true;
+    return true;
+}
+
+#endif
+
+bool MappedFile::ReadFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        ErrorHandler::PostEvent(0x6A, "Could not open file: " + filename);
+        return false;
+    }
+
+    // Read in blocks so non-seekable inputs (pipes) work as well
+    const size_t blockSize = 64 * 1024;
+    size_t used = 0;
+    while (file) {
+        fallbackBuffer_.resize(used + blockSize);
+        file.read(reinterpret_cast<char*>(fallbackBuffer_.data() + used), blockSize);
+        used += static_cast<size_t>(file.gcount());
+    }
+    fallbackBuffer_.resize(used);
+
+    if (used == 0) {
+        ErrorHandler::PostEvent(0x6A, "Empty file");
+        return false;
+    }
+
+    data_ = fallbackBuffer_.data();
+    size_ = used;
+    mapped_ = false;
+    return true;
+}
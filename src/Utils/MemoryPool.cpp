@@ -0,0 +1,261 @@
+#include "MemoryPool.h"
+#include "MemoryTracker.h"
+#include "ShapeLoaderAPI.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // In front of every block; 16 bytes so the block itself stays 16-byte aligned
+    struct alignas(16) BlockHeader {
+        uint32_t sizeClass;
+        uint32_t reserved;
+        FreeListAllocator* owner;       // Allocator whose page holds the block
+    };
+    static_assert(sizeof(BlockHeader) == FreeListAllocator::HEADER_SIZE, "Block header must be HEADER_SIZE bytes");
+
+    const uint32_t LARGE_CLASS = 0xFFFFFFFFu;      // Heap block above MAX_BLOCK_SIZE
+
+    BlockHeader* GetHeader(void* block) {
+        return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(block) - FreeListAllocator::HEADER_SIZE);
+    }
+}
+
+// FreeListAllocator
+
+FreeListAllocator::FreeListAllocator()
+    : pageCursor_(nullptr), pageRemaining_(0), liveBlocks_(0), remoteFree_(nullptr), retiredBalance_(0) {
+    for (size_t i = 0; i < CLASS_COUNT; i++) {
+        freeLists_[i] = nullptr;
+    }
+}
+
+FreeListAllocator::~FreeListAllocator() {
+    for (void* page : pages_) {
+        std::free(page);
+    }
+}
+
+size_t FreeListAllocator::GetSizeClass(size_t size) {
+    size_t sizeClass = 0;
+    while (GetClassSize(sizeClass) < size) {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+uint8_t* FreeListAllocator::CarveBlock(size_t sizeClass) {
+    size_t stride = HEADER_SIZE + GetClassSize(sizeClass);
+    if (pageRemaining_ < stride) {
+        // The tail of the old page is too small for this class and stays unused
+        void* page = std::malloc(PAGE_SIZE);
+        if (!page) {
+            return nullptr;
+        }
+        pages_.push_back(page);
+        pageCursor_ = static_cast<uint8_t*>(page);
+        pageRemaining_ = PAGE_SIZE;
+    }
+
+    uint8_t* block = pageCursor_;
+    pageCursor_ += stride;
+    pageRemaining_ -= stride;
+    return block;
+}
+
+void* FreeListAllocator::Allocate(size_t size) {
+    if (size > MAX_BLOCK_SIZE) {
+        if (size > SIZE_MAX - HEADER_SIZE) {
+            return nullptr;
+        }
+        void* memory = std::malloc(HEADER_SIZE + size);
+        if (!memory) {
+            return nullptr;
+        }
+        static_cast<BlockHeader*>(memory)->sizeClass = LARGE_CLASS;
+        static_cast<BlockHeader*>(memory)->owner = nullptr;
+        return static_cast<uint8_t*>(memory) + HEADER_SIZE;
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    if (!freeLists_[sizeClass]) {
+        DrainRemote();
+    }
+
+    uint8_t* block;
+    if (freeLists_[sizeClass]) {
+        FreeBlock* head = freeLists_[sizeClass];
+        freeLists_[sizeClass] = head->next;
+        block = reinterpret_cast<uint8_t*>(head);
+    } else {
+        uint8_t* memory = CarveBlock(sizeClass);
+        if (!memory) {
+            return nullptr;
+        }
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(memory);
+        header->sizeClass = static_cast<uint32_t>(sizeClass);
+        header->owner = this;
+        block = memory + HEADER_SIZE;
+    }
+    liveBlocks_++;
+    return block;
+}
+
+void FreeListAllocator::Deallocate(void* block) {
+    if (!block) {
+        return;
+    }
+
+    BlockHeader* header = GetHeader(block);
+    if (header->sizeClass == LARGE_CLASS) {
+        std::free(header);
+        return;
+    }
+    if (header->owner != this) {
+        header->owner->DeallocateRemote(block);
+        return;
+    }
+
+    // The header stays in place, so the block keeps its class while on the list
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeLists_[header->sizeClass];
+    freeLists_[header->sizeClass] = freed;
+    liveBlocks_--;
+}
+
+void FreeListAllocator::DeallocateRemote(void* block) {
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = remoteFree_.load(std::memory_order_relaxed);
+    while (!remoteFree_.compare_exchange_weak(freed->next, freed, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    // Only a retired allocator can get here with one block left in use
+    if (retiredBalance_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void FreeListAllocator::DrainRemote() {
+    FreeBlock* freed = remoteFree_.exchange(nullptr, std::memory_order_acquire);
+    while (freed) {
+        FreeBlock* next = freed->next;
+        uint32_t sizeClass = GetHeader(freed)->sizeClass;
+        freed->next = freeLists_[sizeClass];
+        freeLists_[sizeClass] = freed;
+        freed = next;
+    }
+}
+
+void FreeListAllocator::Retire() {
+    // Before this the balance is never positive, so no remote free deletes
+    if (retiredBalance_.fetch_add(static_cast<ptrdiff_t>(liveBlocks_), std::memory_order_acq_rel) +
+        static_cast<ptrdiff_t>(liveBlocks_) == 0) {
+        delete this;
+    }
+}
+
+// ParseArena
+
+ParseArena::ParseArena(size_t initialBlockSize)
+    : current_(0), offset_(0), initialBlockSize_(std::max(initialBlockSize, static_cast<size_t>(BLOCK_ALIGNMENT))),
+      bytesUsed_(0), bytesReserved_(0) {
+}
+
+ParseArena::~ParseArena() {
+    Release();
+}
+
+void ParseArena::Reset() {
+    current_ = 0;
+    offset_ = 0;
+    bytesUsed_ = 0;
+}
+
+void ParseArena::Release() {
+    for (const Block& block : blocks_) {
+        ::operator delete(block.data, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+    MemoryTracker::OnDeallocate(MemorySubsystem::ParseArena, bytesReserved_);
+    blocks_.clear();
+    bytesReserved_ = 0;
+    Reset();
+}
+
+bool ParseArena::AdvanceBlock(size_t bytes, size_t alignment) {
+    // Later retained blocks are tried first; one that is too small is skipped
+    while (current_ + 1 < blocks_.size()) {
+        current_++;
+        offset_ = 0;
+        if (blocks_[current_].size >= bytes && alignment <= BLOCK_ALIGNMENT) {
+            return true;
+        }
+    }
+
+    size_t size = blocks_.empty() ? initialBlockSize_ : blocks_.back().size * 2;
+    size = std::max(size, bytes + alignment);
+
+    Block block;
+    block.data = static_cast<uint8_t*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT), std::nothrow));
+    if (!block.data) {
+        return false;
+    }
+    block.size = size;
+    blocks_.push_back(block);
+    bytesReserved_ += size;
+    MemoryTracker::OnAllocate(MemorySubsystem::ParseArena, size);
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return true;
+}
+
+void* ParseArena::do_allocate(size_t bytes, size_t alignment) {
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            const Block& block = blocks_[current_];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            uintptr_t aligned = (base + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            size_t end = static_cast<size_t>(aligned - base) + bytes;
+            if (end <= block.size) {
+                bytesUsed_ += end - offset_;
+                offset_ = end;
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+        if (!AdvanceBlock(bytes, alignment)) {
+            throw std::bad_alloc();
+        }
+    }
+}
+
+// ShapeLoader API
+
+namespace ShapeLoader {
+namespace Memory {
+
+namespace {
+    /**
+     * One allocator per thread, so allocation never takes a lock
+     * On thread exit the allocator is retired: its pages live on until the
+     * blocks other threads still hold have been freed.
+     */
+    struct ThreadCache {
+        FreeListAllocator* allocator = new FreeListAllocator();
+        ~ThreadCache() { allocator->Retire(); }
+    };
+
+    FreeListAllocator& GetThreadAllocator() {
+        thread_local ThreadCache cache;
+        return *cache.allocator;
+    }
+}
+
+void* AllocateFromFreeList(size_t size) {
+    return GetThreadAllocator().Allocate(size);
+}
+
+void DeallocateToFreeList(void* ptr) {
+    GetThreadAllocator().Deallocate(ptr);
+}
+
+} // namespace Memory
+} // namespace ShapeLoader
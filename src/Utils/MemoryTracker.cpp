@@ -0,0 +1,159 @@
+#include "MemoryTracker.h"
+#include <iomanip>
+
+namespace {
+
+struct Counter {
+    std::atomic<size_t> current{0};
+    std::atomic<size_t> peak{0};
+
+    void Add(size_t bytes) {
+        size_t value = current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t seen = peak.load(std::memory_order_relaxed);
+        while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void Subtract(size_t bytes) {
+        current.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+};
+
+Counter subsystemCounters[MemoryTracker::SUBSYSTEM_COUNT];
+Counter totalCounter;
+
+const char* SUBSYSTEM_NAMES[MemoryTracker::SUBSYSTEM_COUNT] = {
+    "Parse arena",
+    "Converter heap",
+    "Chunk table",
+    "Stream window",
+    "File buffers",
+    "Shape data",
+    "Surface generator",
+    "Animation system",
+    "Line processor"
+};
+
+} // namespace
+
+void MemoryTracker::OnAllocate(MemorySubsystem subsystem, size_t bytes) {
+    subsystemCounters[static_cast<size_t>(subsystem)].Add(bytes);
+    totalCounter.Add(bytes);
+}
+
+void MemoryTracker::OnDeallocate(MemorySubsystem subsystem, size_t bytes) {
+    subsystemCounters[static_cast<size_t>(subsystem)].Subtract(bytes);
+    totalCounter.Subtract(bytes);
+}
+
+MemoryUsage MemoryTracker::GetUsage(MemorySubsystem subsystem) {
+    const Counter& counter = subsystemCounters[static_cast<size_t>(subsystem)];
+    return MemoryUsage{counter.current.load(std::memory_order_relaxed), counter.peak.load(std::memory_order_relaxed)};
+}
+
+MemoryUsage MemoryTracker::GetTotal() {
+    return MemoryUsage{totalCounter.current.load(std::memory_order_relaxed), totalCounter.peak.load(std::memory_order_relaxed)};
+}
+
+void MemoryTracker::ResetPeaks() {
+    for (Counter& counter : subsystemCounters) {
+        counter.peak.store(counter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    totalCounter.peak.store(totalCounter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+const char* MemoryTracker::GetName(MemorySubsystem subsystem) {
+    size_t index = static_cast<size_t>(subsystem);
+    return index < SUBSYSTEM_COUNT ? SUBSYSTEM_NAMES[index] : "Unknown";
+}
+
+void MemoryTracker::Print(std::ostream& out) {
+    out << "  " << std::left << std::setw(20) << "Subsystem"
+        << std::right << std::setw(14) << "Current KB" << std::setw(14) << "Peak KB" << std::endl;
+
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        MemorySubsystem subsystem = static_cast<MemorySubsystem>(i);
+        MemoryUsage usage = GetUsage(subsystem);
+        if (usage.peakBytes == 0) {
+            continue;
+        }
+        out << "  " << std::left << std::setw(20) << GetName(subsystem)
+            << std::right << std::setw(14) << (usage.currentBytes + 1023) / 1024
+            << std::setw(14) << (usage.peakBytes + 1023) / 1024 << std::endl;
+    }
+
+    MemoryUsage total = GetTotal();
+    out << "  " << std::left << std::setw(20) << "Total"
+        << std::right << std::setw(14) << (total.currentBytes + 1023) / 1024
+        << std::setw(14) << (total.peakBytes + 1023) / 1024 << std::endl;
+}
+
+std::pmr::memory_resource* MemoryTracker::GetResource(MemorySubsystem subsystem) {
+    // Never destroyed: pmr containers in static objects may outlive any destruction order
+    static TrackedResource* resources = [] {
+        TrackedResource* array = static_cast<TrackedResource*>(::operator new(sizeof(TrackedResource) * SUBSYSTEM_COUNT));
+        for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+            new (&array[i]) TrackedResource(static_cast<MemorySubsystem>(i));
+        }
+        return array;
+    }();
+    return &resources[static_cast<size_t>(subsystem)];
+}
+
+void* TrackedResource::do_allocate(size_t bytes, size_t alignment) {
+    void* block = upstream_->allocate(bytes, alignment);
+    MemoryTracker::OnAllocate(subsystem_, bytes);
+    return block;
+}
+
+void TrackedResource::do_deallocate(void* block, size_t bytes, size_t alignment) {
+    MemoryTracker::OnDeallocate(subsystem_, bytes);
+    upstream_->deallocate(block, bytes, alignment);
+}
+
+MemoryBudget::MemoryBudget(size_t limitBytes)
+    : limit_(limitBytes), reserved_(0), retained_(0), holders_(0), throttled_(0) {
+}
+
+void MemoryBudget::Acquire(size_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Fits(bytes)) {
+        throttled_++;
+        released_.wait(lock, [&]() { return Fits(bytes); });
+    }
+    reserved_ += bytes;
+    holders_++;
+}
+
+void MemoryBudget::Release(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reserved_ -= bytes < reserved_ ? bytes : reserved_;
+        holders_ = holders_ > 0 ? holders_ - 1 : 0;
+    }
+    released_.notify_all();
+}
+
+void MemoryBudget::UpdateRetained(size_t previous, size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retained_ -= previous < retained_ ? previous : retained_;
+        retained_ += bytes;
+    }
+    released_.notify_all();
+}
+
+size_t MemoryBudget::GetThrottleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return throttled_;
+}
+
+bool MemoryBudget::Fits(size_t bytes) const {
+    if (limit_ == 0 || holders_ == 0) {
+        return true;
+    }
+    // Running work is counted twice (tracked and reserved) until it has grown to its estimate
+    size_t tracked = MemoryTracker::GetTotal().currentBytes;
+    tracked -= retained_ < tracked ? retained_ : tracked;
+    return tracked + reserved_ + bytes <= limit_;
+}
@@ -0,0 +1,123 @@
+#include "ThreadPool.h"
+
+namespace {
+    // Identifies the calling worker so its own submissions stay on its queue
+    thread_local const ThreadPool* g_currentPool = nullptr;
+    thread_local size_t g_currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : nextQueue_(0), stolen_(0), pending_(0), stopping_(false) {
+    if (threadCount == 0) {
+        threadCount = GetDefaultThreadCount();
+    }
+
+    // All queues must exist before the first worker can try to steal
+    queues_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned ThreadPool::GetDefaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+bool ThreadPool::GetCurrentWorker(size_t& index) const {
+    if (g_currentPool != this) {
+        return false;
+    }
+    index = g_currentWorker;
+    return true;
+}
+
+void ThreadPool::Enqueue(std::function<void()> task) {
+    size_t index;
+    if (g_currentPool == this) {
+        index = g_currentWorker;
+    } else {
+        index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    // Count the task before it becomes visible: a worker that pops it first
+    // would otherwise take pending_ below zero and wrap it around
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        pending_.fetch_add(1);
+    }
+    try {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    } catch (...) {
+        pending_.fetch_sub(1);
+        throw;
+    }
+
+    // Any idle worker will do - whoever wakes steals the task if it isn't theirs
+    sleepCondition_.notify_one();
+}
+
+bool ThreadPool::TryPop(size_t queueIndex, std::function<void()>& task) {
+    WorkQueue& queue = *queues_[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::TrySteal(size_t thiefIndex, std::function<void()>& task) {
+    size_t count = queues_.size();
+    for (size_t step = 1; step < count; step++) {
+        if (TryPop((thiefIndex + step) % count, task)) {
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+    g_currentPool = this;
+    g_currentWorker = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (TryPop(index, task) || TrySteal(index, task)) {
+            pending_.fetch_sub(1);
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() { return stopping_ || pending_.load() > 0; });
+
+        // Drain all queues before stopping so no submitted future is left hanging
+        if (stopping_ && pending_.load() == 0) {
+            return;
+        }
+    }
+}
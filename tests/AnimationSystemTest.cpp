@@ -0,0 +1,124 @@
+#include "AnimationSystem.h"
+#include "ShapeData.h"
+#include "TestSupport.h"
+#include <vector>
+
+/**
+ * Keyframe blending reads x/y/z through attribute spans, so every mix of
+ * interleaved and SoA shapes must give the same positions and leave the
+ * other attributes alone. Shapes of different sizes and quantised
+ * positions are refused.
+ */
+
+namespace {
+
+const size_t VERTEX_COUNT = 100;
+
+float Coordinate(size_t vertex, size_t axis, float keyframe) {
+    return static_cast<float>(vertex) * 0.5f + static_cast<float>(axis) * 3.0f + keyframe * 17.0f;
+}
+
+/**
+ * Legacy-format shape whose positions depend on the keyframe, normals and UVs on the vertex only
+ */
+void FillKeyframe(ShapeData& shape, float keyframe, VertexLayout layout, size_t vertexCount = VERTEX_COUNT) {
+    shape.SetVertexLayout(layout);
+    shape.AllocateVertexBuffer(vertexCount);
+    float* vertices = shape.GetVertexBuffer();
+    for (size_t i = 0; i < vertexCount; i++) {
+        for (size_t a = 0; a < 8; a++) {
+            vertices[i * 8 + a] = a < 3 ? Coordinate(i, a, keyframe) : static_cast<float>(i * 8 + a);
+        }
+    }
+    shape.SetVertexCount(vertexCount);
+}
+
+const char* LayoutName(VertexLayout layout) {
+    return layout == VertexLayout::SoA ? "SoA" : "interleaved";
+}
+
+} // namespace
+
+int main() {
+    const VertexAttribute axes[3] = { VertexAttribute::X, VertexAttribute::Y, VertexAttribute::Z };
+    const float factor = 0.375f;
+
+    // Every combination of layouts blends to the same positions
+    for (VertexLayout fromLayout : { VertexLayout::Interleaved, VertexLayout::SoA }) {
+        for (VertexLayout outLayout : { VertexLayout::Interleaved, VertexLayout::SoA }) {
+            ShapeData from;
+            ShapeData to;
+            ShapeData out;
+            FillKeyframe(from, 0.0f, fromLayout);
+            FillKeyframe(to, 1.0f, VertexLayout::SoA);
+            FillKeyframe(out, 5.0f, outLayout);
+
+            Check(AnimationSystem::BlendShapePositions(from, to, factor, out), "%s -> %s blend failed",
+                  LayoutName(fromLayout), LayoutName(outLayout));
+            const ShapeData& result = out;
+            bool blended = true;
+            for (size_t axis = 0; axis < 3; axis++) {
+                ConstAttributeSpan position = result.GetAttribute(axes[axis]);
+                for (size_t i = 0; i < VERTEX_COUNT; i++) {
+                    float a = Coordinate(i, axis, 0.0f);
+                    float b = Coordinate(i, axis, 1.0f);
+                    blended &= position[i] == a + (b - a) * factor;
+                }
+            }
+            Check(blended, "%s -> %s: blended positions wrong", LayoutName(fromLayout), LayoutName(outLayout));
+
+            bool untouched = true;
+            for (size_t a = 3; a < 8; a++) {
+                ConstAttributeSpan attribute = result.GetAttribute(static_cast<VertexAttribute>(a));
+                for (size_t i = 0; i < VERTEX_COUNT; i++) {
+                    untouched &= attribute[i] == static_cast<float>(i * 8 + a);
+                }
+            }
+            Check(untouched, "%s -> %s: blend wrote normals or UVs", LayoutName(fromLayout), LayoutName(outLayout));
+        }
+    }
+
+    // Factors 0 and 1 reproduce the keyframes exactly
+    {
+        ShapeData from;
+        ShapeData to;
+        ShapeData out;
+        FillKeyframe(from, 0.0f, VertexLayout::SoA);
+        FillKeyframe(to, 1.0f, VertexLayout::SoA);
+        FillKeyframe(out, 5.0f, VertexLayout::SoA);
+        AnimationSystem::BlendShapePositions(from, to, 0.0f, out);
+        Check(out.GetAttribute(VertexAttribute::Z)[7] == Coordinate(7, 2, 0.0f), "factor 0 is not the first keyframe");
+        AnimationSystem::BlendShapePositions(from, to, 1.0f, out);
+        Check(out.GetAttribute(VertexAttribute::Z)[7] == Coordinate(7, 2, 1.0f), "factor 1 is not the second keyframe");
+    }
+
+    // Mismatched vertex counts and quantised positions are refused
+    {
+        ShapeData from;
+        ShapeData to;
+        ShapeData shorter;
+        FillKeyframe(from, 0.0f, VertexLayout::SoA);
+        FillKeyframe(to, 1.0f, VertexLayout::SoA);
+        FillKeyframe(shorter, 2.0f, VertexLayout::SoA, VERTEX_COUNT - 1);
+        Check(!AnimationSystem::BlendShapePositions(from, to, factor, shorter), "blend into a smaller shape accepted");
+        Check(!AnimationSystem::BlendShapePositions(from, shorter, factor, to), "blend from a smaller shape accepted");
+
+        ShapeData quantized;
+        FillKeyframe(quantized, 3.0f, VertexLayout::Interleaved);
+        Check(quantized.SetPositionEncoding(PositionEncoding::Int32), "positions not quantised");
+        Check(!AnimationSystem::BlendShapePositions(from, to, factor, quantized), "blend into quantised positions accepted");
+    }
+
+    // Keyframe shapes registered per batch
+    {
+        AnimationSystem animation;
+        ShapeData shape;
+        animation.SetBatchShape(4, &shape);
+        Check(animation.GetBatchShape(4) == &shape, "batch shape not kept");
+        Check(animation.GetBatchShape(3) == nullptr && animation.GetBatchShape(100) == nullptr, "unset batches have shapes");
+        animation.Cleanup();
+        Check(animation.GetBatchShape(4) == nullptr, "Cleanup kept batch shapes");
+    }
+
+    return Finish("Keyframe blends match in every layout");
+}
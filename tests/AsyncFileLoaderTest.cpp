@@ -0,0 +1,96 @@
+#include "AsyncFileLoader.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Both backends must hand every file over exactly once with the bytes
+ * ReadWholeFile reads: empty files load as empty successes, missing files
+ * fail without stopping the rest. A queue shallower than the file list
+ * makes the loader refill slots as files complete.
+ */
+
+namespace {
+
+typedef AsyncFileLoader::Backend Backend;
+
+void WriteFile(const std::string& path, size_t size, unsigned seed) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        out.put(static_cast<char>(seed >> 16));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path directory = argc > 1 ? std::filesystem::path(argv[1])
+                                               : std::filesystem::temp_directory_path() / "AsyncFileLoaderTest";
+    std::filesystem::create_directories(directory);
+
+    const size_t sizes[] = { 0, 1, 4095, 4096, 4097, 65536 + 3, 0, (1 << 20) + 17, 12 };
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        std::string path = (directory / ("file" + std::to_string(i) + ".bin")).string();
+        WriteFile(path, sizes[i], static_cast<unsigned>(i + 1));
+        paths.push_back(path);
+    }
+    size_t missing = 3;
+    paths.insert(paths.begin() + missing, (directory / "missing.bin").string());
+    std::filesystem::remove(paths[missing]);
+
+    std::vector<FileBuffer> expected(paths.size());
+    size_t expectedBytes = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::string error;
+        bool read = AsyncFileLoader::ReadWholeFile(paths[i], expected[i], error);
+        Check(read == (i != missing), "ReadWholeFile result for %s", paths[i].c_str());
+        expectedBytes += expected[i].size();
+    }
+
+    int compared = 0;
+    for (Backend backend : { Backend::IoUring, Backend::ThreadPool }) {
+        const char* name = AsyncFileLoader::GetBackendName(backend);
+        if (backend == Backend::IoUring && !AsyncFileLoader::IsIoUringAvailable()) {
+            std::printf("%s not available, skipped\n", name);
+            continue;
+        }
+        compared++;
+
+        for (unsigned queueDepth : { 1u, 3u, AsyncFileLoader::DEFAULT_QUEUE_DEPTH }) {
+            AsyncFileLoader loader(queueDepth);
+            loader.SetBackend(backend);
+
+            std::vector<int> deliveries(paths.size(), 0);
+            bool allLoaded = loader.LoadAll(paths, [&](LoadedFile& file) {
+                if (file.index >= paths.size()) {
+                    Check(false, "%s: file index %zu out of range", name, file.index);
+                    return;
+                }
+                deliveries[file.index]++;
+                Check(file.path == paths[file.index], "%s: path of file %zu", name, file.index);
+                if (file.index == missing) {
+                    Check(!file.success && !file.error.empty(), "%s: missing file reported as loaded", name);
+                    Check(file.data.empty(), "%s: missing file kept data", name);
+                } else {
+                    Check(file.success, "%s: %s failed: %s", name, file.path.c_str(), file.error.c_str());
+                    Check(file.data == expected[file.index], "%s: %s differs from ReadWholeFile", name, file.path.c_str());
+                }
+            });
+
+            for (size_t i = 0; i < paths.size(); i++) {
+                Check(deliveries[i] == 1, "%s, depth %u: file %zu delivered %d times", name, queueDepth, i, deliveries[i]);
+            }
+            Check(!allLoaded && loader.GetFilesFailed() == 1, "%s, depth %u: missing file not counted", name, queueDepth);
+            Check(loader.GetBytesLoaded() == expectedBytes, "%s, depth %u: %zu bytes loaded, expected %zu",
+                  name, queueDepth, loader.GetBytesLoaded(), expectedBytes);
+        }
+    }
+
+    std::filesystem::remove_all(directory);
+    return Finish("Loaded files match ReadWholeFile (%d backend run(s))", compared);
+}
@@ -0,0 +1,24 @@
+# Convert INPUT with --weld, then require the expected vertex and face counts
+# Usage: cmake -DCONVERTER=<3GM2OBJ> -DINPUT=<file.3GM> -DWORK_DIR=<dir>
+#              -DVERTICES=<count> -DFACES=<count> -P CheckWelded.cmake
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+execute_process(
+    COMMAND "${CONVERTER}" --weld -o welded "${INPUT}"
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE result
+    OUTPUT_QUIET ERROR_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Welded conversion of ${INPUT} failed (${result})")
+endif()
+
+file(STRINGS "${WORK_DIR}/welded.obj" vertices REGEX "^v ")
+file(STRINGS "${WORK_DIR}/welded.obj" faces REGEX "^f ")
+list(LENGTH vertices vertex_count)
+list(LENGTH faces face_count)
+
+if(NOT vertex_count EQUAL VERTICES OR NOT face_count EQUAL FACES)
+    message(FATAL_ERROR "Welded ${INPUT}: ${vertex_count} vertices and ${face_count} faces, "
+                        "expected ${VERTICES} and ${FACES}")
+endif()
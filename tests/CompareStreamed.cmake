@@ -0,0 +1,36 @@
+# Convert INPUT buffered and with --stream, then require identical vertex and face lists
+# Usage: cmake -DCONVERTER=<3GM2OBJ> -DINPUT=<file.3GM> -DWORK_DIR=<dir> -P CompareStreamed.cmake
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+foreach(mode buffered streamed)
+    if(mode STREQUAL "streamed")
+        set(extra_args --stream)
+    else()
+        set(extra_args)
+    endif()
+
+    execute_process(
+        COMMAND "${CONVERTER}" ${extra_args} -o "${mode}" "${INPUT}"
+        WORKING_DIRECTORY "${WORK_DIR}"
+        RESULT_VARIABLE result
+        OUTPUT_QUIET ERROR_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${mode} conversion of ${INPUT} failed (${result})")
+    endif()
+
+    file(STRINGS "${WORK_DIR}/${mode}.obj" vertices_${mode} REGEX "^v ")
+    file(STRINGS "${WORK_DIR}/${mode}.obj" faces_${mode} REGEX "^f ")
+endforeach()
+
+if(NOT vertices_buffered STREQUAL vertices_streamed)
+    list(LENGTH vertices_buffered buffered_count)
+    list(LENGTH vertices_streamed streamed_count)
+    message(FATAL_ERROR "Vertex lists differ for ${INPUT}: ${buffered_count} buffered, ${streamed_count} streamed")
+endif()
+
+if(NOT faces_buffered STREQUAL faces_streamed)
+    list(LENGTH faces_buffered buffered_count)
+    list(LENGTH faces_streamed streamed_count)
+    message(FATAL_ERROR "Face lists differ for ${INPUT}: ${buffered_count} buffered, ${streamed_count} streamed")
+endif()
@@ -0,0 +1,93 @@
+#include "FaceDeduplicator.h"
+#include "TestSupport.h"
+#include <cstdint>
+
+/**
+ * A face is the same whichever corner it starts from. Reversed, it is a
+ * different face unless winding is ignored. Faces inserted past the
+ * reserved size force rehashes that must keep every earlier face, and
+ * faces using the table's empty marker as an index are never keyed.
+ */
+
+namespace {
+
+typedef FaceDeduplicator::Winding Winding;
+
+const uint32_t EMPTY_INDEX = 0xFFFFFFFF;
+
+} // namespace
+
+int main() {
+    // Rotations are one face in both modes
+    for (Winding winding : { Winding::Preserve, Winding::Ignore }) {
+        const char* mode = winding == Winding::Preserve ? "Preserve" : "Ignore";
+        FaceDeduplicator faces(std::pmr::get_default_resource(), winding);
+        Check(faces.Insert(7, 3, 9), "%s: new face reported as duplicate", mode);
+        Check(!faces.Insert(3, 9, 7), "%s: rotation (3, 9, 7) not a duplicate", mode);
+        Check(!faces.Insert(9, 7, 3), "%s: rotation (9, 7, 3) not a duplicate", mode);
+        Check(!faces.Insert(7, 3, 9), "%s: same face not a duplicate", mode);
+        Check(faces.GetCount() == 1, "%s: %zu faces kept, expected 1", mode, faces.GetCount());
+
+        // Degenerate faces with a repeated smallest index rotate the same way
+        Check(faces.Insert(2, 2, 5), "%s: new degenerate face reported as duplicate", mode);
+        Check(!faces.Insert(2, 5, 2) && !faces.Insert(5, 2, 2), "%s: degenerate rotation not a duplicate", mode);
+    }
+
+    // Reversed winding: distinct when preserved, the same face when ignored
+    {
+        FaceDeduplicator preserve(std::pmr::get_default_resource(), Winding::Preserve);
+        preserve.Insert(1, 2, 3);
+        Check(preserve.Insert(3, 2, 1), "Preserve: reversed face reported as duplicate");
+        Check(!preserve.Insert(1, 3, 2), "Preserve: rotation of the reversed face reported as new");
+
+        FaceDeduplicator ignore(std::pmr::get_default_resource(), Winding::Ignore);
+        ignore.Insert(1, 2, 3);
+        Check(!ignore.Insert(3, 2, 1), "Ignore: reversed face not a duplicate");
+        Check(!ignore.Insert(2, 1, 3), "Ignore: reversed rotation not a duplicate");
+        Check(ignore.GetCount() == 1, "Ignore: %zu faces kept, expected 1", ignore.GetCount());
+
+        // Switching modes forgets faces keyed the other way
+        preserve.SetWinding(Winding::Ignore);
+        Check(preserve.GetCount() == 0 && preserve.Insert(3, 2, 1), "mode switch kept old keys");
+    }
+
+    // Inserting well past the reserved size rehashes without losing faces
+    {
+        const uint32_t faceCount = 5000;
+        FaceDeduplicator faces;
+        faces.Reserve(10);
+        size_t reserved = faces.GetCapacity();
+        for (uint32_t i = 0; i < faceCount; i++) {
+            Check(faces.Insert(i, i + 1, i + 2), "face %u reported as duplicate while growing", i);
+        }
+        Check(faces.GetCapacity() >= faceCount && faces.GetCapacity() > reserved, "table did not grow");
+        uint32_t found = 0;
+        for (uint32_t i = 0; i < faceCount; i++) {
+            found += faces.Insert(i + 2, i, i + 1) ? 0 : 1;
+        }
+        Check(found == faceCount, "%u of %u faces found after rehashing", found, faceCount);
+        Check(faces.GetCount() == faceCount, "rotations added faces after rehashing");
+
+        faces.Clear();
+        Check(faces.GetCount() == 0 && faces.Insert(0, 1, 2), "Clear kept faces");
+        faces.Release();
+        Check(faces.GetCapacity() == 0 && faces.Insert(0, 1, 2), "Release left the set unusable");
+    }
+
+    // The empty marker cannot be keyed: such faces are always new and never stored
+    for (Winding winding : { Winding::Preserve, Winding::Ignore }) {
+        const char* mode = winding == Winding::Preserve ? "Preserve" : "Ignore";
+        FaceDeduplicator faces(std::pmr::get_default_resource(), winding);
+        faces.Insert(0, 1, 2);
+        Check(faces.Insert(EMPTY_INDEX, 1, 2) && faces.Insert(EMPTY_INDEX, 1, 2), "%s: empty-marker face deduplicated", mode);
+        Check(faces.Insert(0, EMPTY_INDEX, EMPTY_INDEX) && faces.Insert(EMPTY_INDEX, EMPTY_INDEX, EMPTY_INDEX),
+              "%s: empty-marker face deduplicated", mode);
+        Check(faces.GetCount() == 1, "%s: empty-marker faces stored", mode);
+        Check(!faces.Insert(1, 2, 0), "%s: lookup broken after empty-marker faces", mode);
+
+        // The largest real index still works
+        Check(faces.Insert(EMPTY_INDEX - 1, 0, 1) && !faces.Insert(0, 1, EMPTY_INDEX - 1), "%s: index 0xFFFFFFFE", mode);
+    }
+
+    return Finish("Face sets find rotations, respect winding and survive rehashing");
+}
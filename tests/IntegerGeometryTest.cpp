@@ -0,0 +1,154 @@
+#include "IntegerGeometry.h"
+#include "VertexDecoder.h"
+#include "ByteSwap.h"
+#include "TestSupport.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Welded integer positions must reach the OBJ as the same floats the
+ * float decoders write: ToFloat is compared bit for bit against the Dot2
+ * and cDot decoders under every kernel, for every int16 and for tenths
+ * around 2^24 where floats stop holding every integer. The cDot -1 marker
+ * decodes to 0, and Weld numbers positions by first occurrence across
+ * Dot2 and cDot chunks.
+ */
+
+namespace {
+
+typedef PackedVertexKernel::Kernel Kernel;
+
+std::vector<uint8_t> PackDot2(const std::vector<int32_t>& tenths) {
+    std::vector<uint8_t> records(tenths.size() * 4);
+    for (size_t i = 0; i < tenths.size(); i++) {
+        ByteSwap::WriteLittleEndian32(records.data() + i * 4, ByteSwap::LittleToBigEndian32(static_cast<uint32_t>(tenths[i])));
+    }
+    return records;
+}
+
+std::vector<uint8_t> PackCDot(const std::vector<int16_t>& hundredths) {
+    std::vector<uint8_t> records(hundredths.size() * 2);
+    for (size_t i = 0; i < hundredths.size(); i++) {
+        ByteSwap::WriteLittleEndian16(records.data() + i * 2, static_cast<uint16_t>(hundredths[i]));
+    }
+    return records;
+}
+
+/**
+ * Compare ToFloat of every decoded coordinate with the float decoder's output
+ * @return Index of the first coordinate that differs, or -1
+ */
+long FirstMismatch(const IntegerVertexArray& positions, const std::vector<float>& decoded) {
+    for (size_t i = 0; i < positions.size(); i++) {
+        const int64_t coordinates[3] = { positions[i].x, positions[i].y, positions[i].z };
+        for (size_t axis = 0; axis < 3; axis++) {
+            float value = IntegerGeometry::ToFloat(coordinates[axis]);
+            if (std::memcmp(&value, &decoded[i * 3 + axis], sizeof(float)) != 0) {
+                return static_cast<long>(i * 3 + axis);
+            }
+        }
+    }
+    return -1;
+}
+
+IntegerVertex Vertex(int64_t x, int64_t y, int64_t z) {
+    IntegerVertex vertex = { x, y, z };
+    return vertex;
+}
+
+} // namespace
+
+int main() {
+    // Dot2 tenths: small values, a sweep, and both sides of 2^24 and the int32 limits
+    std::vector<int32_t> tenths = { 0, 1, -1, 3, -7, 9, 10, 11, 99, 100, 12345, -98765 };
+    for (int32_t value = -2000000; value <= 2000000; value += 997) {
+        tenths.push_back(value);
+    }
+    for (int32_t center : { 1 << 23, 1 << 24, 1 << 25, 100000000 }) {
+        for (int32_t delta = -40; delta <= 40; delta++) {
+            tenths.push_back(center + delta);
+            tenths.push_back(-center - delta);
+        }
+    }
+    tenths.push_back(INT32_MAX);
+    tenths.push_back(INT32_MIN);
+    tenths.push_back(INT32_MAX - 5);
+    while (tenths.size() % 3 != 0) {
+        tenths.push_back(0);
+    }
+
+    // cDot hundredths: every int16, -1 included
+    std::vector<int16_t> hundredths;
+    for (int32_t value = INT16_MIN; value <= INT16_MAX; value++) {
+        hundredths.push_back(static_cast<int16_t>(value));
+    }
+    while (hundredths.size() % 3 != 0) {
+        hundredths.push_back(0);
+    }
+
+    std::vector<uint8_t> dot2Records = PackDot2(tenths);
+    std::vector<uint8_t> cdotRecords = PackCDot(hundredths);
+    size_t dot2Count = tenths.size() / 3;
+    size_t cdotCount = hundredths.size() / 3;
+
+    IntegerVertexArray dot2Positions;
+    IntegerVertexArray cdotPositions;
+    IntegerGeometry::DecodeDot2(dot2Records.data(), dot2Count, dot2Positions);
+    IntegerGeometry::DecodeCDot(cdotRecords.data(), cdotCount, cdotPositions);
+    Check(dot2Positions.size() == dot2Count && cdotPositions.size() == cdotCount, "decoded vertex counts wrong");
+
+    for (Kernel kernel : { Kernel::Scalar, Kernel::SSSE3, Kernel::AVX2 }) {
+        PackedVertexKernel::SetKernel(kernel);
+        const char* name = PackedVertexKernel::GetKernelName(PackedVertexKernel::GetKernel());
+
+        std::vector<float> dot2Floats(dot2Count * 3);
+        VertexDecoding::Dot2::Run(dot2Records.data(), dot2Floats.data(), 3, dot2Count);
+        long mismatch = FirstMismatch(dot2Positions, dot2Floats);
+        Check(mismatch < 0, "%s: ToFloat differs from the Dot2 decoder for %d tenths", name,
+              mismatch < 0 ? 0 : tenths[mismatch]);
+
+        std::vector<float> cdotFloats(cdotCount * 3);
+        VertexDecoding::CDot::Run(cdotRecords.data(), cdotFloats.data(), 3, cdotCount);
+        mismatch = FirstMismatch(cdotPositions, cdotFloats);
+        Check(mismatch < 0, "%s: ToFloat differs from the cDot decoder for %d hundredths", name,
+              mismatch < 0 ? 0 : hundredths[mismatch]);
+    }
+    PackedVertexKernel::SetKernel(Kernel::AVX2);
+
+    // The cDot marker is an unused axis, not -0.01
+    {
+        IntegerVertexArray positions;
+        std::vector<uint8_t> records = PackCDot({ -1, 5, -1, -2, -1, 0 });
+        IntegerGeometry::DecodeCDot(records.data(), 2, positions);
+        Check(positions[0] == Vertex(0, 5, 0) && positions[1] == Vertex(-2, 0, 0), "cDot -1 not decoded as 0");
+    }
+
+    // Mixed chunks: Dot2 tenths and cDot hundredths that land on the same point weld together
+    {
+        IntegerVertexArray positions;
+        std::vector<uint8_t> first = PackDot2({ 15, 0, -20,     7, 7, 7,     15, 0, -20 });
+        std::vector<uint8_t> second = PackCDot({ 150, -1, -200,  70, 70, 70,  71, 70, 70,  5, 5, 5 });
+        std::vector<uint8_t> third = PackDot2({ 0, 0, 0,         7, 7, 7,     3, 0, 0 });
+        IntegerGeometry::DecodeDot2(first.data(), 3, positions);
+        IntegerGeometry::DecodeCDot(second.data(), 4, positions);
+        IntegerGeometry::DecodeDot2(third.data(), 3, positions);
+
+        IntegerVertexArray unique;
+        std::pmr::vector<uint32_t> remap;
+        size_t count = IntegerGeometry::Weld(positions, unique, remap);
+
+        const std::vector<uint32_t> expectedRemap = { 0, 1, 0,   0, 1, 2, 3,   4, 1, 5 };
+        const IntegerVertex expectedUnique[] = { Vertex(150, 0, -200), Vertex(70, 70, 70), Vertex(71, 70, 70),
+                                                 Vertex(5, 5, 5), Vertex(0, 0, 0), Vertex(30, 0, 0) };
+        Check(count == 6 && unique.size() == 6, "mixed weld kept %zu positions, expected 6", count);
+        Check(std::vector<uint32_t>(remap.begin(), remap.end()) == expectedRemap, "mixed weld remap out of order");
+        bool ordered = unique.size() == 6;
+        for (size_t i = 0; ordered && i < 6; i++) {
+            ordered = unique[i] == expectedUnique[i];
+        }
+        Check(ordered, "welded positions not in first-occurrence order");
+    }
+
+    return Finish("Integer positions convert like the float decoders and weld across chunk types");
+}
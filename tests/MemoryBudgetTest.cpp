@@ -0,0 +1,62 @@
+#include "MemoryTracker.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * Buffers a worker keeps for its next job are tracked but must not count
+ * against the budget: with warm workers, jobs that fit next to each other
+ * are admitted together instead of one at a time.
+ */
+
+namespace {
+
+/**
+ * Acquire on another thread while holderBytes are held, then release them
+ * @return false if the acquire had to wait for the release
+ */
+bool AcquireWithoutWaiting(MemoryBudget& budget, size_t holderBytes, size_t bytes) {
+    size_t throttled = budget.GetThrottleCount();
+    std::atomic<bool> admitted(false);
+    std::thread second([&]() {
+        budget.Acquire(bytes);
+        admitted = true;
+        budget.Release(bytes);
+    });
+    for (int i = 0; i < 400 && !admitted && budget.GetThrottleCount() == throttled; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    budget.Release(holderBytes);
+    second.join();
+    return budget.GetThrottleCount() == throttled;
+}
+
+} // namespace
+
+int main() {
+    const size_t limit = 1024 * 1024;
+    const size_t job = 300 * 1024;
+    const size_t warm = 600 * 1024;
+
+    // Two idle workers holding arenas grown by earlier files
+    MemoryTracker::OnAllocate(MemorySubsystem::ParseArena, warm);
+    MemoryBudget budget(limit);
+
+    budget.Acquire(job);
+    Check(!AcquireWithoutWaiting(budget, job, job), "retained bytes not counted before they are reported");
+
+    budget.UpdateRetained(0, warm / 2);
+    budget.UpdateRetained(0, warm / 2);
+    budget.Acquire(job);
+    Check(AcquireWithoutWaiting(budget, job, job), "retained bytes throttled a job that fits");
+
+    // A worker that trims reports less; the rest counts again
+    budget.UpdateRetained(warm / 2, 0);
+    budget.Acquire(job);
+    Check(!AcquireWithoutWaiting(budget, job, 2 * job), "trimmed worker's bytes still left out");
+
+    MemoryTracker::OnDeallocate(MemorySubsystem::ParseArena, warm);
+
+    return Finish("Retained parse buffers do not throttle warm workers");
+}
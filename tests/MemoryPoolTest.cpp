@@ -0,0 +1,152 @@
+#include "MemoryPool.h"
+#include "MemoryTracker.h"
+#include "ShapeLoaderAPI.h"
+#include "TestSupport.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * Blocks freed on another thread must go back to the allocator that owns
+ * them, and a retired thread cache must be released once its last block
+ * is freed (run under ASan/LSan to see the release).
+ * A reset parse arena bumps through the blocks it kept, skipping those too
+ * small for a request, before it asks the heap for more.
+ */
+
+namespace {
+
+bool IsAligned(const void* pointer, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+size_t ArenaTrackedBytes() {
+    return MemoryTracker::GetUsage(MemorySubsystem::ParseArena).currentBytes;
+}
+
+} // namespace
+
+int main() {
+    const size_t blockCount = 1000;
+
+    // Freed on another thread, reused by the owner without new pages
+    {
+        FreeListAllocator owner;
+        std::vector<void*> blocks;
+        for (size_t i = 0; i < blockCount; i++) {
+            blocks.push_back(owner.Allocate(64));
+        }
+        size_t pageBytes = owner.GetPageBytes();
+
+        std::thread([&]() {
+            FreeListAllocator other;
+            for (void* block : blocks) {
+                other.Deallocate(block);
+            }
+            Check(other.GetPageBytes() == 0, "remote frees joined the freeing thread's allocator");
+        }).join();
+
+        for (size_t i = 0; i < blockCount; i++) {
+            owner.Allocate(64);
+        }
+        Check(owner.GetPageBytes() == pageBytes, "blocks freed on another thread were not reused");
+    }
+
+    // A thread cache outlived by its blocks is released by the last free
+    std::vector<void*> orphans;
+    std::thread([&]() {
+        for (size_t i = 0; i < blockCount; i++) {
+            orphans.push_back(ShapeLoader::Memory::AllocateFromFreeList(i % 200 + 1));
+        }
+        ShapeLoader::Memory::DeallocateToFreeList(orphans.back());
+        orphans.pop_back();
+    }).join();
+    for (void* block : orphans) {
+        ShapeLoader::Memory::DeallocateToFreeList(block);
+    }
+
+    // Retired with nothing in use, so deleted at once
+    FreeListAllocator* idle = new FreeListAllocator();
+    idle->Deallocate(idle->Allocate(32));
+    idle->Retire();
+
+    // Blocks from several threads freed concurrently into one owner
+    {
+        FreeListAllocator owner;
+        std::vector<void*> blocks;
+        for (size_t i = 0; i < blockCount * 4; i++) {
+            blocks.push_back(owner.Allocate(16 << (i % 4)));
+        }
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; t++) {
+            threads.emplace_back([&, t]() {
+                FreeListAllocator freeing;
+                for (size_t i = t; i < blocks.size(); i += 4) {
+                    freeing.Deallocate(blocks[i]);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        size_t pageBytes = owner.GetPageBytes();
+        for (size_t i = 0; i < blockCount * 4; i++) {
+            owner.Allocate(16 << (i % 4));
+        }
+        Check(owner.GetPageBytes() == pageBytes, "concurrent remote frees lost blocks");
+    }
+
+    // Arena accounting: used bytes include alignment padding, reserved bytes are whole blocks
+    size_t trackedBefore = ArenaTrackedBytes();
+    {
+        ParseArena arena(1024);
+        Check(arena.GetBytesUsed() == 0 && arena.GetBytesReserved() == 0, "new arena holds memory");
+        void* first = arena.allocate(100, 8);
+        arena.allocate(1, 1);
+        void* padded = arena.allocate(8, 8);
+        Check(static_cast<uint8_t*>(padded) - static_cast<uint8_t*>(first) == 104, "8-byte allocation not padded to 104");
+        Check(arena.GetBytesUsed() == 112, "%zu bytes used, expected 112", arena.GetBytesUsed());
+        Check(arena.GetBytesReserved() == 1024, "%zu bytes reserved, expected one 1024-byte block", arena.GetBytesReserved());
+        Check(ArenaTrackedBytes() - trackedBefore == arena.GetBytesReserved(), "tracker disagrees with the arena's blocks");
+    }
+    Check(ArenaTrackedBytes() == trackedBefore, "destroyed arena still tracked");
+
+    // Reset reuses the retained blocks; a retained block too small for a request is skipped
+    {
+        ParseArena arena(1024);
+        arena.allocate(1000, 8);                    // Block 0: 1024 bytes
+        arena.allocate(4000, 8);                    // Block 1: 4008 bytes
+        void* large = arena.allocate(5000, 8);      // Block 2: 8016 bytes
+        size_t reserved = arena.GetBytesReserved();
+        size_t tracked = ArenaTrackedBytes();
+
+        arena.Reset();
+        Check(arena.GetBytesUsed() == 0 && arena.GetBytesReserved() == reserved, "Reset changed the blocks");
+        arena.allocate(100, 8);
+        void* skipped = arena.allocate(6000, 8);
+        Check(skipped == large, "6000 bytes not placed at the start of the 8016-byte block");
+        Check(arena.GetBytesReserved() == reserved && ArenaTrackedBytes() == tracked, "reset arena allocated new blocks");
+
+        arena.Reset();
+        void* again = nullptr;
+        for (size_t i = 0; i < 3; i++) {
+            again = arena.allocate(1000 + i * 2000, 8);
+        }
+        Check(again == large && arena.GetBytesReserved() == reserved, "replaying the first pass allocated new blocks");
+
+        // Alignments past the block alignment get a fresh block, never a misaligned retained one
+        arena.Reset();
+        for (size_t alignment : { size_t(128), size_t(256), size_t(4096) }) {
+            void* aligned = arena.allocate(24, alignment);
+            Check(IsAligned(aligned, alignment), "allocation not aligned to %zu", alignment);
+            static_cast<uint8_t*>(aligned)[23] = 1;
+        }
+        Check(IsAligned(arena.allocate(3, 1024), 1024), "allocation not aligned to 1024 after larger alignments");
+
+        arena.Release();
+        Check(arena.GetBytesReserved() == 0 && ArenaTrackedBytes() == trackedBefore, "Release kept blocks");
+        Check(IsAligned(arena.allocate(64, 64), 64) && arena.GetBytesUsed() == 64, "released arena unusable");
+    }
+
+    return Finish("Free-list blocks return to their owner from any thread; arenas reuse their blocks");
+}
@@ -0,0 +1,150 @@
+#include "PackedVertexKernel.h"
+#include "ByteSwap.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * Every SIMD kernel must write exactly what the scalar loop writes: the
+ * same float bits, the same untouched floats between vertices, and the
+ * same bounds and invalid mask. Vertex counts cover the SIMD tails on
+ * either side of the 4- and 8-vertex steps.
+ */
+
+namespace {
+
+typedef PackedVertexKernel::Kernel Kernel;
+typedef PackedVertexKernel::ByteOrder ByteOrder;
+
+bool SameStats(const PackedVertexKernel::DecodeStats& a, const PackedVertexKernel::DecodeStats& b) {
+    if (a.validCount != b.validCount || a.invalidCount != b.invalidCount || a.invalidMask != b.invalidMask) {
+        return false;
+    }
+    return !a.HasBounds() || (std::memcmp(a.min, b.min, sizeof(a.min)) == 0 && std::memcmp(a.max, b.max, sizeof(a.max)) == 0);
+}
+
+std::vector<uint8_t> MakeBytes(size_t size, unsigned seed) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = static_cast<uint8_t>(seed >> 16);
+    }
+    return bytes;
+}
+
+/**
+ * Decoded output of one entry point under the current kernel
+ */
+struct Result {
+    std::vector<float> output;
+    PackedVertexKernel::DecodeStats stats;
+};
+
+enum class Decode {
+    ConvertBigEndian,
+    ConvertLittleEndian,
+    FloatBigEndian,
+    FloatLittleEndian,
+    Decompress,
+    Short,
+    DequantizeHalf
+};
+
+const char* GetDecodeName(Decode decode) {
+    switch (decode) {
+        case Decode::ConvertBigEndian:    return "Convert BE";
+        case Decode::ConvertLittleEndian: return "Convert LE";
+        case Decode::FloatBigEndian:      return "Float BE";
+        case Decode::FloatLittleEndian:   return "Float LE";
+        case Decode::Decompress:          return "Decompress";
+        case Decode::Short:               return "Short";
+        default:                          return "DequantizeHalf";
+    }
+}
+
+Result Run(Decode decode, const std::vector<uint8_t>& input, size_t stride, size_t count) {
+    // A z scale large enough to overflow makes some vertices invalid
+    PackedVertexKernel::CompressionParams params = { { 0.01f, -0.25f, 1.0e36f }, { 1.0f, -2.0f, 0.5f } };
+
+    Result result;
+    // Poisoned so a float one kernel writes and another skips shows up
+    result.output.assign(count * stride + 1, -123.0f);
+    float* out = result.output.data();
+    switch (decode) {
+        case Decode::ConvertBigEndian:
+            PackedVertexKernel::ConvertVertices(input.data(), ByteOrder::BigEndian, out, stride, count, &result.stats);
+            break;
+        case Decode::ConvertLittleEndian:
+            PackedVertexKernel::ConvertVertices(input.data(), ByteOrder::LittleEndian, out, stride, count, &result.stats);
+            break;
+        case Decode::FloatBigEndian:
+            PackedVertexKernel::ConvertFloatVertices(input.data(), ByteOrder::BigEndian, out, stride, count, &result.stats);
+            break;
+        case Decode::FloatLittleEndian:
+            PackedVertexKernel::ConvertFloatVertices(input.data(), ByteOrder::LittleEndian, out, stride, count, &result.stats);
+            break;
+        case Decode::Decompress:
+            PackedVertexKernel::DecompressVertices(params, input.data(), out, stride, count, &result.stats);
+            break;
+        case Decode::Short:
+            PackedVertexKernel::ConvertShortVertices(input.data(), out, stride, count, &result.stats);
+            break;
+        case Decode::DequantizeHalf:
+            PackedVertexKernel::DequantizeHalfVertices(params, input.data(), out, stride, count);
+            break;
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    const Decode decodes[] = {
+        Decode::ConvertBigEndian, Decode::ConvertLittleEndian, Decode::FloatBigEndian, Decode::FloatLittleEndian,
+        Decode::Decompress, Decode::Short, Decode::DequantizeHalf
+    };
+    const size_t strides[] = { 3, 8 };
+    const size_t counts[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 65, 1000, 1027 };
+
+    Kernel detected = PackedVertexKernel::GetKernel();
+    int compared = 0;
+
+    for (Kernel kernel : { Kernel::SSSE3, Kernel::AVX2 }) {
+        PackedVertexKernel::SetKernel(kernel);
+        if (PackedVertexKernel::GetKernel() != kernel) {
+            std::printf("%s not supported, skipped\n", PackedVertexKernel::GetKernelName(kernel));
+            continue;
+        }
+        compared++;
+
+        for (Decode decode : decodes) {
+            for (size_t stride : strides) {
+                for (size_t count : counts) {
+                    size_t vertexSize = (decode == Decode::Decompress || decode == Decode::Short ||
+                                         decode == Decode::DequantizeHalf) ? 6 : 12;
+                    std::vector<uint8_t> input = MakeBytes(count * vertexSize, static_cast<unsigned>(count * 31 + stride));
+                    if (decode == Decode::Short) {
+                        // Unused-axis markers
+                        for (size_t v = 0; v < count; v += 5) {
+                            ByteSwap::WriteLittleEndian16(input.data() + v * 6 + 2, 0xFFFF);
+                        }
+                    }
+
+                    PackedVertexKernel::SetKernel(Kernel::Scalar);
+                    Result expected = Run(decode, input, stride, count);
+                    PackedVertexKernel::SetKernel(kernel);
+                    Result actual = Run(decode, input, stride, count);
+
+                    const char* name = PackedVertexKernel::GetKernelName(kernel);
+                    Check(std::memcmp(actual.output.data(), expected.output.data(), expected.output.size() * sizeof(float)) == 0,
+                          "%s %s: stride %zu, %zu vertices", name, GetDecodeName(decode), stride, count);
+                    Check(SameStats(actual.stats, expected.stats), "%s stats: stride %zu, %zu vertices", name, stride, count);
+                }
+            }
+        }
+    }
+    PackedVertexKernel::SetKernel(detected);
+
+    return Finish("%d SIMD kernel(s) match the scalar loop bit for bit", compared);
+}
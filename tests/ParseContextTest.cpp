@@ -0,0 +1,41 @@
+#include "ParseContext.h"
+#include "SurfaceGenerator.h"
+#include "TestSupport.h"
+
+/**
+ * A context initializes its surface generator once and only resets it
+ * between parses: the same tables serve the next file, with every surface
+ * of the previous one forgotten. A trim frees the tables.
+ */
+
+int main() {
+    ParseContext context;
+    context.Begin();
+    SurfaceGenerator& first = context.GetSurfaceGenerator(100, 200);
+    Check(first.IsSystemReady(), "generator not initialized on first use");
+
+    uint16_t surface = first.GetOrCreateSurface(16646, 3, 1);
+    Check(surface == 1, "first surface is not 1");
+    Check(first.GetOrCreateSurface(16646, 3, 1) == surface, "existing surface not found");
+    Check(first.GetOrCreateSurface(16646, 4, 1) == 2, "second surface is not 2");
+    size_t tableBytes = first.GetTableBytes();
+    Check(tableBytes > 0 && context.GetRetainedBytes() >= tableBytes, "surface tables not counted as retained");
+
+    for (int parse = 0; parse < 3; parse++) {
+        context.Begin();
+        SurfaceGenerator& next = context.GetSurfaceGenerator(100, 200);
+        Check(&next == &first, "generator not kept across parses");
+        Check(next.GetTableBytes() == tableBytes, "surface tables reallocated");
+        Check(next.GetStatistics().allocatedSurfaces == 0, "surfaces of the previous parse still allocated");
+        Check(next.GetSurfaceHash(16646, 3, 1) == 0xFFFF, "surface of the previous parse still hashed");
+        Check(next.GetOrCreateSurface(16646, 4, 1) == 1, "surface IDs not restarted");
+        Check(next.ValidateSystem(), "generator inconsistent after reset");
+    }
+
+    // Other limits initialize again; a trim frees the tables
+    Check(context.GetSurfaceGenerator(50, 100).GetStatistics().maxSurfaces == 100, "new limits not applied");
+    context.Trim();
+    Check(context.GetRetainedBytes() == 0, "trim kept the surface tables");
+
+    return Finish("Parse contexts reuse their surface generator");
+}
@@ -0,0 +1,140 @@
+#include "3GMParser.h"
+#include "ChunkHeader.h"
+#include "ShapeData.h"
+#include "TestSupport.h"
+#include <cstring>
+#include <vector>
+
+/**
+ * Parser3GM must merge a shape with several vertex and primitive chunks
+ * the same way whether the chunks are processed inline, on the thread
+ * pool, or deferred until their stream is first read: every vertex chunk
+ * is kept, and primitive indices are rebased onto the last vertex chunk
+ * before them in the file.
+ */
+
+namespace {
+
+/**
+ * Test vertex chunk: little-endian float x/y/z triples
+ */
+class FloatVertexProcessor : public ChunkProcessor {
+public:
+    bool ProcessChunk(const ChunkHeader&, ByteSpan data, ShapeData& shape) override {
+        size_t count = data.size() / 12;
+        shape.SetVertexFormat(VertexFormat::Positions());
+        shape.AllocateVertexBuffer(count);
+        std::memcpy(shape.GetVertexBuffer(), data.data(), count * 12);
+        shape.SetVertexCount(count);
+        return true;
+    }
+    ChunkType GetChunkType() const override { return ChunkType::Dot2; }
+    const char* GetChunkName() const override { return "Dot2"; }
+    bool ValidateChunkData(const ChunkHeader&, ByteSpan data) const override { return data.size() % 12 == 0; }
+};
+
+/**
+ * Test primitive chunk: little-endian uint16 indices into the preceding vertex chunk
+ */
+class IndexProcessor : public ChunkProcessor {
+public:
+    bool ProcessChunk(const ChunkHeader&, ByteSpan data, ShapeData& shape) override {
+        size_t count = data.size() / 2;
+        shape.AllocatePrimitiveBuffer(count);
+        std::memcpy(shape.GetPrimitiveBuffer(), data.data(), count * 2);
+        return true;
+    }
+    ChunkType GetChunkType() const override { return ChunkType::Prim; }
+    const char* GetChunkName() const override { return "Prim"; }
+    bool ValidateChunkData(const ChunkHeader&, ByteSpan data) const override { return data.size() % 2 == 0; }
+};
+
+void AppendChunk(std::vector<uint8_t>& file, const char* tag, const std::vector<uint8_t>& payload) {
+    file.insert(file.end(), tag, tag + 4);
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    for (int i = 0; i < 4; i++) {
+        file.push_back(static_cast<uint8_t>(size >> (8 * i)));
+    }
+    file.insert(file.end(), payload.begin(), payload.end());
+}
+
+std::vector<uint8_t> MakeVertices(size_t count, float seed) {
+    std::vector<uint8_t> payload(count * 12);
+    for (size_t i = 0; i < count * 3; i++) {
+        float value = seed + static_cast<float>(i) * 0.25f;
+        std::memcpy(payload.data() + i * 4, &value, 4);
+    }
+    return payload;
+}
+
+std::vector<uint8_t> MakeIndices(size_t vertexCount) {
+    std::vector<uint8_t> payload;
+    for (size_t i = 0; i < 30; i++) {
+        uint16_t index = static_cast<uint16_t>((i * 7) % vertexCount);
+        payload.push_back(static_cast<uint8_t>(index));
+        payload.push_back(static_cast<uint8_t>(index >> 8));
+    }
+    return payload;
+}
+
+struct Parsed {
+    bool succeeded = false;
+    std::vector<float> positions;
+    std::vector<uint16_t> indices;
+};
+
+Parsed Parse(const std::vector<uint8_t>& file, unsigned threadCount, bool lazy) {
+    Parser3GM parser;
+    parser.RegisterChunkProcessor(ChunkType::Dot2, std::unique_ptr<ChunkProcessor>(new FloatVertexProcessor()));
+    parser.RegisterChunkProcessor(ChunkType::Prim, std::unique_ptr<ChunkProcessor>(new IndexProcessor()));
+    parser.SetThreadCount(threadCount);
+    parser.SetLazyDecoding(lazy);
+
+    Parsed parsed;
+    parsed.succeeded = parser.ParseBuffer(file.data(), file.size(), "synthetic");
+    const ShapeData& shape = parser.GetParsedShape();
+    ConstAttributeSpan x = shape.GetAttribute(VertexAttribute::X);
+    ConstAttributeSpan y = shape.GetAttribute(VertexAttribute::Y);
+    ConstAttributeSpan z = shape.GetAttribute(VertexAttribute::Z);
+    for (size_t i = 0; i < x.size(); i++) {
+        parsed.positions.push_back(x[i]);
+        parsed.positions.push_back(y[i]);
+        parsed.positions.push_back(z[i]);
+    }
+    parsed.indices.assign(shape.GetPrimitiveBuffer(), shape.GetPrimitiveBuffer() + shape.GetPrimitiveCount());
+    parsed.succeeded = parsed.succeeded && shape.DecodeAll();
+    return parsed;
+}
+
+} // namespace
+
+int main() {
+    // Three vertex and two primitive chunks, large enough for the pool (64 KB)
+    const size_t counts[3] = { 3000, 2500, 2000 };
+    std::vector<uint8_t> file = { '3', 'D', 'G', 'M', 0, 1, 0, 3, 0, 0, 0, 0 };
+    AppendChunk(file, "Dot2", MakeVertices(counts[0], 1.0f));
+    AppendChunk(file, "Prim", MakeIndices(counts[0]));
+    AppendChunk(file, "Dot2", MakeVertices(counts[1], -5.0f));
+    AppendChunk(file, "Dot2", MakeVertices(counts[2], 9.0f));
+    AppendChunk(file, "Prim", MakeIndices(counts[2]));
+    AppendChunk(file, "End ", {});
+
+    Parsed serial = Parse(file, 1, false);
+    Parsed pooled = Parse(file, 4, false);
+    Parsed lazy = Parse(file, 1, true);
+
+    Check(serial.succeeded, "serial parse failed");
+    Check(serial.positions.size() == (counts[0] + counts[1] + counts[2]) * 3, "a vertex chunk was lost");
+    Check(serial.indices.size() == 60, "a primitive chunk was lost");
+    Check(serial.indices.size() == 60 && serial.indices[30] == counts[0] + counts[1] && serial.indices[31] == counts[0] + counts[1] + 7,
+          "second primitive chunk not rebased onto the third vertex chunk");
+
+    Check(pooled.succeeded, "pooled parse failed");
+    Check(pooled.positions == serial.positions && pooled.indices == serial.indices, "pooled parse differs from serial");
+
+    Check(lazy.succeeded, "lazy parse failed");
+    Check(lazy.positions == serial.positions, "lazy parse kept different vertices");
+    Check(lazy.indices == serial.indices, "lazy parse rebased indices differently");
+
+    return Finish("Serial, pooled and lazy parses merge identically");
+}
@@ -0,0 +1,195 @@
+#include "QuantizedPositions.h"
+#include "ByteSwap.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/**
+ * Positions come back within the documented limits: bit-identical when
+ * Dot2 tenths or cDot hundredths fit the integer range, otherwise within
+ * half a step of the bounds-based scale for int16 and int32, and within
+ * half an fp16 ulp of the value relative to the centre for fp16. The bulk
+ * decode and the single-position accessor agree bit for bit.
+ */
+
+namespace {
+
+/**
+ * Interleaved x/y/z positions
+ */
+struct Positions {
+    std::vector<float> xyz;
+
+    size_t GetCount() const { return xyz.size() / 3; }
+    ConstAttributeSpan Axis(int axis) const { return ConstAttributeSpan(xyz.data() + axis, 3, GetCount()); }
+};
+
+/**
+ * Dot2 positions decoded the way the parser decodes them
+ */
+Positions MakeDot2(const std::vector<int32_t>& tenths) {
+    std::vector<uint8_t> packed(tenths.size() * 4);
+    for (size_t i = 0; i < tenths.size(); i++) {
+        ByteSwap::WriteLittleEndian32(packed.data() + i * 4, static_cast<uint32_t>(tenths[i]));
+    }
+    Positions positions;
+    positions.xyz.resize(tenths.size());
+    PackedVertexKernel::ConvertVertices(packed.data(), PackedVertexKernel::ByteOrder::LittleEndian,
+                                        positions.xyz.data(), 3, tenths.size() / 3);
+    return positions;
+}
+
+/**
+ * cDot positions decoded the way the parser decodes them
+ */
+Positions MakeCDot(const std::vector<int16_t>& hundredths) {
+    std::vector<uint8_t> packed(hundredths.size() * 2);
+    for (size_t i = 0; i < hundredths.size(); i++) {
+        ByteSwap::WriteLittleEndian16(packed.data() + i * 2, static_cast<uint16_t>(hundredths[i]));
+    }
+    Positions positions;
+    positions.xyz.resize(hundredths.size());
+    PackedVertexKernel::ConvertShortVertices(packed.data(), positions.xyz.data(), 3, hundredths.size() / 3);
+    return positions;
+}
+
+Positions MakeScattered(size_t count, float low, float high) {
+    Positions positions;
+    unsigned seed = 12345;
+    for (size_t i = 0; i < count * 3; i++) {
+        seed = seed * 1103515245 + 12345;
+        positions.xyz.push_back(low + (high - low) * static_cast<float>(seed >> 8) / 16777216.0f);
+    }
+    return positions;
+}
+
+/**
+ * Encode, then decode in bulk (stride 4 to leave a gap) and one at a time
+ * @return Largest error per axis, or -1 if encoding or decoding failed
+ */
+double RoundTrip(const Positions& positions, PositionEncoding encoding, QuantizedPositions& quantized, bool& exact) {
+    size_t count = positions.GetCount();
+    exact = false;
+    if (!quantized.Encode(positions.Axis(0), positions.Axis(1), positions.Axis(2), encoding)) {
+        return -1.0;
+    }
+
+    std::vector<float> bulk(count * 4, -123.0f);
+    if (quantized.Decode(0, count, bulk.data(), 4) != count) {
+        return -1.0;
+    }
+
+    exact = true;
+    double error = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        float single[3];
+        quantized.GetPosition(i, single);
+        if (std::memcmp(single, &bulk[i * 4], sizeof(single)) != 0 || bulk[i * 4 + 3] != -123.0f) {
+            return -1.0;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            float source = positions.xyz[i * 3 + axis];
+            exact = exact && std::memcmp(&single[axis], &source, sizeof(float)) == 0;
+            error = std::max(error, std::fabs(static_cast<double>(single[axis]) - source));
+        }
+    }
+    return error;
+}
+
+} // namespace
+
+int main() {
+    QuantizedPositions quantized;
+    bool exact = false;
+
+    // int32: Dot2 tenths up to 2^23 - 1 come back bit-identical
+    std::vector<int32_t> tenths = { 0, 1, -1, 5, -5, 9, 12345, -98765, 1048575, -1048577,
+                                    8388607, -8388607, 8388606, 4194305, -7777777 };
+    for (int32_t value = -300000; value <= 300000; value += 1237) {
+        tenths.push_back(value);
+    }
+    while (tenths.size() % 3 != 0) {
+        tenths.push_back(7);
+    }
+    Check(RoundTrip(MakeDot2(tenths), PositionEncoding::Int32, quantized, exact) == 0.0 && exact,
+          "int32 Dot2 tenths below 2^23 not bit-identical");
+    Check(quantized.GetGrid() == PositionGrid::Tenths && quantized.GetParams().offset[0] == 0.0f,
+          "int32 Dot2 tenths not kept on the tenths grid");
+
+    // int16: Dot2 tenths within +-32767 are kept on the grid as well
+    std::vector<int32_t> smallTenths = { 0, 1, -1, 32767, -32767, 12345, -20000, 9, 3 };
+    Check(RoundTrip(MakeDot2(smallTenths), PositionEncoding::Int16, quantized, exact) == 0.0 && exact,
+          "int16 Dot2 tenths not bit-identical");
+    Check(quantized.GetGrid() == PositionGrid::Tenths, "int16 Dot2 tenths not kept on the tenths grid");
+
+    // cDot hundredths: int16 and int32 keep them exactly, -1 (unused axis) already decoded to 0
+    std::vector<int16_t> hundredths = { 0, 1, -2, 5, -5, 99, 12345, -32768, 32767, -1, 250, -7 };
+    for (int32_t value = -32000; value <= 32000; value += 917) {
+        hundredths.push_back(static_cast<int16_t>(value));
+    }
+    while (hundredths.size() % 3 != 0) {
+        hundredths.push_back(3);
+    }
+    Positions cdot = MakeCDot(hundredths);
+    Check(RoundTrip(cdot, PositionEncoding::Int16, quantized, exact) == 0.0 && exact,
+          "int16 cDot hundredths not bit-identical");
+    Check(quantized.GetGrid() == PositionGrid::Hundredths && quantized.GetParams().scale[1] == 0.01f,
+          "int16 cDot hundredths not kept on the hundredths grid");
+    Check(RoundTrip(cdot, PositionEncoding::Int32, quantized, exact) == 0.0 && exact,
+          "int32 cDot hundredths not bit-identical");
+    Check(quantized.GetGrid() == PositionGrid::Hundredths, "int32 cDot hundredths not kept on the hundredths grid");
+
+    // -0.01 is the cDot unused-axis marker in int16, so only int32 keeps it on the grid
+    Positions marker = MakeCDot({ 10, 20, 30, 40, 50, 60 });
+    marker.xyz[4] = -1.0f / 100.0f;
+    Check(RoundTrip(marker, PositionEncoding::Int32, quantized, exact) == 0.0 && exact &&
+          quantized.GetGrid() == PositionGrid::Hundredths, "int32 lost -0.01");
+    Check(RoundTrip(marker, PositionEncoding::Int16, quantized, exact) >= 0.0 &&
+          quantized.GetGrid() == PositionGrid::None, "int16 stored -0.01 as the cDot marker");
+
+    // int32 off the grid: half a step of the bounds-based scale plus the float rounding of the result
+    Positions offGrid = MakeScattered(100, -500.0f, 500.0f);
+    double error = RoundTrip(offGrid, PositionEncoding::Int32, quantized, exact);
+    Check(quantized.GetGrid() == PositionGrid::None, "scattered positions taken for a grid");
+    Check(error >= 0.0 && error <= 500.0 / 2147483647.0 + 500.0 / 8388608.0, "int32 off-grid error above half a step");
+
+    // int32 takes values far beyond 2^31 tenths
+    Positions huge = MakeScattered(100, -3.0e9f, 1.0e9f);
+    error = RoundTrip(huge, PositionEncoding::Int32, quantized, exact);
+    Check(error >= 0.0 && error <= 2.0e9 / 2147483647.0 + 3.0e9 / 8388608.0, "int32 refused or mangled huge positions");
+
+    // int16: at most half a step of the bounds-based scale
+    Positions scattered = MakeScattered(1000, -2000.0f, 300.0f);
+    error = RoundTrip(scattered, PositionEncoding::Int16, quantized, exact);
+    double halfStep = 0.0;
+    for (int axis = 0; axis < 3; axis++) {
+        halfStep = std::max(halfStep, 0.5 * quantized.GetParams().scale[axis]);
+    }
+    // plus the float rounding of offset + value * scale at |position| <= 2000
+    Check(error >= 0.0 && error <= halfStep + 2000.0 / 8388608.0, "int16 error above half a step");
+    Check(quantized.GetByteCount() == scattered.GetCount() * 6, "int16 not 6 bytes per vertex");
+
+    // int16 re-quantises Dot2 values beyond its range over the bounds: close, not exact
+    error = RoundTrip(MakeDot2(tenths), PositionEncoding::Int16, quantized, exact);
+    Check(error >= 0.0 && !exact && quantized.GetGrid() == PositionGrid::None,
+          "int16 claimed to keep wide Dot2 tenths exactly");
+
+    // fp16: half an ulp of the value relative to the centre (11-bit significand)
+    error = RoundTrip(scattered, PositionEncoding::Float16, quantized, exact);
+    Check(error >= 0.0 && error <= 1150.0 / 2048.0 + 2000.0 / 8388608.0, "fp16 error above half an ulp");
+
+    // Limits refused instead of wrapped
+    Positions wide = MakeScattered(10, -10.0f, 10.0f);
+    wide.xyz[0] = -70000.0f;
+    wide.xyz[3] = 70000.0f;
+    Check(!quantized.Encode(wide.Axis(0), wide.Axis(1), wide.Axis(2), PositionEncoding::Float16),
+          "fp16 accepted a half-extent beyond 65504");
+    Check(quantized.GetEncoding() == PositionEncoding::Float32 && quantized.IsEmpty(), "refused encode kept data");
+    Positions bad = MakeScattered(2, 0.0f, 1.0f);
+    bad.xyz[4] = std::nanf("");
+    Check(!quantized.Encode(bad.Axis(0), bad.Axis(1), bad.Axis(2), PositionEncoding::Int16), "NaN quantised");
+
+    return Finish("Quantised positions round-trip within their limits");
+}
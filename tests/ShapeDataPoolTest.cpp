@@ -0,0 +1,84 @@
+#include "ShapeDataPool.h"
+#include "TestSupport.h"
+#include <memory_resource>
+
+/**
+ * A released shape comes back from the next Acquire recycled: empty, but
+ * with its buffers' capacity, so decoding the same size again allocates
+ * nothing. A pool that is full destroys released shapes instead.
+ */
+
+namespace {
+
+/**
+ * Counts the allocations it passes to the heap and the bytes outstanding
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t bytesInUse = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        bytesInUse += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+        bytesInUse -= bytes;
+        std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+} // namespace
+
+int main() {
+    CountingResource resource;
+    ShapeDataPool pool(1, &resource);
+
+    // Recycled, the same shape keeps its buffers
+    ShapeData* first = nullptr;
+    {
+        ShapeDataPool::Handle shape = pool.Acquire();
+        first = shape.get();
+        shape->AllocateVertexBuffer(1000);
+        shape->AllocatePrimitiveBuffer(3000);
+    }
+    Check(pool.GetIdleCount() == 1, "released shape not pooled");
+
+    size_t allocations = resource.allocations;
+    {
+        ShapeDataPool::Handle shape = pool.Acquire();
+        Check(shape.get() == first, "Acquire did not return the released shape");
+        Check(pool.GetReuseCount() == 1, "reuse not counted");
+        Check(shape->GetVertexCount() == 0 && shape->GetPrimitiveCount() == 0, "recycled shape not empty");
+
+        shape->AllocateVertexBuffer(1000);
+        shape->AllocatePrimitiveBuffer(3000);
+        Check(resource.allocations == allocations, "recycled shape allocated again (%zu allocations)",
+              resource.allocations - allocations);
+    }
+
+    // A full pool drops the extra shape
+    {
+        ShapeDataPool::Handle kept = pool.Acquire();
+        ShapeDataPool::Handle extra = pool.Acquire();
+        Check(extra.get() != kept.get(), "one shape handed out twice");
+        extra->AllocateVertexBuffer(1000);
+        ShapeData* keptShape = kept.get();
+        kept.reset();
+        size_t bytesInUse = resource.bytesInUse;
+        extra.reset();
+        Check(pool.GetIdleCount() == 1, "full pool kept %zu shapes", pool.GetIdleCount());
+        Check(resource.bytesInUse < bytesInUse, "dropped shape kept its buffers");
+        Check(pool.Acquire().get() == keptShape, "full pool replaced its idle shape");
+    }
+
+    pool.Trim();
+    Check(pool.GetIdleCount() == 0, "Trim kept idle shapes");
+
+    return Finish("Pooled shapes come back with their buffers");
+}
@@ -0,0 +1,325 @@
+#include "ShapeData.h"
+#include "TestSupport.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * Deferred decoders may read earlier streams of their shape, which are
+ * then decoded first, and never later ones: a later stream could be half
+ * decoded further up the stack (Positions -> Primitives -> Positions) or
+ * locked by another thread. Such an access fails the decoder's stream
+ * instead of deadlocking or returning partial data.
+ *
+ * Vertex formats convert attribute by attribute: what the output lacks is
+ * dropped, what the input lacks is zero. A merged slice widens the shape's
+ * format to the union of both, each attribute moving to its packed offset.
+ * The SoA layout holds the same vertices: splitting into streams and
+ * interleaving again is bit-exact, attribute spans read the same values in
+ * either layout, and interleaved slices merge into SoA shapes.
+ */
+
+namespace {
+
+/**
+ * Defer one vertex and one primitive, the primitive decoder reading the vertex count
+ */
+void DeferVertexAndPrimitive(ShapeData& shape, bool positionsReadPrimitives, int& positionsRuns, int& primitivesRuns) {
+    shape.DeferChunk(ShapeStream::Positions, ChunkHeader(), ByteSpan(), [&, positionsReadPrimitives](const ChunkHeader&, ByteSpan, ShapeData& target) {
+        positionsRuns++;
+        target.AllocateVertexBuffer(1);
+        target.SetVertexCount(1);
+        return !positionsReadPrimitives || target.GetPrimitiveCount() == 1;
+    });
+    shape.DeferChunk(ShapeStream::Primitives, ChunkHeader(), ByteSpan(), [&](const ChunkHeader&, ByteSpan, ShapeData& target) {
+        primitivesRuns++;
+        size_t vertexCount = target.GetVertexCount();
+        target.AllocatePrimitiveBuffer(1);
+        target.GetPrimitiveBuffer()[0] = static_cast<uint16_t>(vertexCount - 1);
+        return vertexCount == 1;
+    });
+}
+
+/**
+ * Distinct value for every attribute of every vertex
+ */
+float AttributeValue(size_t vertex, VertexAttribute attribute) {
+    return static_cast<float>(vertex) * 10.0f + static_cast<float>(attribute) + 0.25f;
+}
+
+/**
+ * Interleaved vertices of a format, filled with AttributeValue
+ */
+std::vector<float> MakeVertices(const VertexFormat& format, size_t vertexCount, size_t firstVertex = 0) {
+    std::vector<float> vertices(vertexCount * format.GetFloatStride());
+    for (size_t i = 0; i < vertexCount; i++) {
+        for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+            VertexAttribute attribute = static_cast<VertexAttribute>(a);
+            if (format.Has(attribute)) {
+                vertices[i * format.GetFloatStride() + format.GetFloatOffset(attribute)] = AttributeValue(firstVertex + i, attribute);
+            }
+        }
+    }
+    return vertices;
+}
+
+/**
+ * Decode vertices of a format into a shape, the way a chunk processor does
+ */
+void FillShape(ShapeData& shape, const VertexFormat& format, size_t vertexCount, size_t firstVertex = 0) {
+    std::vector<float> vertices = MakeVertices(format, vertexCount, firstVertex);
+    shape.SetVertexFormat(format);
+    shape.AllocateVertexBuffer(vertexCount);
+    std::memcpy(shape.GetVertexBuffer(), vertices.data(), vertices.size() * sizeof(float));
+    shape.SetVertexCount(vertexCount);
+}
+
+/**
+ * @return false unless every attribute span of the format reads AttributeValue, and the others are empty
+ */
+bool AttributesMatch(const ShapeData& shape, const VertexFormat& format, size_t vertexCount) {
+    for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+        VertexAttribute attribute = static_cast<VertexAttribute>(a);
+        ConstAttributeSpan span = shape.GetAttribute(attribute);
+        if (!format.Has(attribute)) {
+            if (!span.empty()) {
+                return false;
+            }
+            continue;
+        }
+        if (span.size() != vertexCount) {
+            return false;
+        }
+        for (size_t i = 0; i < vertexCount; i++) {
+            if (span[i] != AttributeValue(i, attribute)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+VertexFormat TexCoords() {
+    VertexFormat format;
+    format.Add(VertexAttribute::U).Add(VertexAttribute::V);
+    return format;
+}
+
+} // namespace
+
+int main() {
+    // Earlier stream from a later decoder: decoded first, nested
+    {
+        ShapeData shape;
+        int positionsRuns = 0;
+        int primitivesRuns = 0;
+        DeferVertexAndPrimitive(shape, false, positionsRuns, primitivesRuns);
+
+        Check(shape.DecodeStream(ShapeStream::Primitives), "primitive decode failed");
+        Check(shape.IsStreamDecoded(ShapeStream::Positions), "positions not decoded for the primitive decoder");
+        Check(positionsRuns == 1 && primitivesRuns == 1, "a decoder ran more than once");
+        Check(shape.GetPrimitiveCount() == 1 && shape.GetPrimitiveBuffer()[0] == 0, "primitive saw partial positions");
+    }
+
+    // Later stream from an earlier decoder: refused, the decoder's stream fails
+    {
+        ShapeData shape;
+        int positionsRuns = 0;
+        int primitivesRuns = 0;
+        DeferVertexAndPrimitive(shape, true, positionsRuns, primitivesRuns);
+
+        Check(!shape.DecodeStream(ShapeStream::Positions), "out-of-order access did not fail the stream");
+        Check(primitivesRuns == 0, "later stream decoded from an earlier decoder");
+        Check(shape.DecodeStream(ShapeStream::Primitives), "primitive decode failed after the refused access");
+        Check(positionsRuns == 1 && primitivesRuns == 1, "a decoder ran more than once");
+        Check(!shape.DecodeAll(), "failed stream reported as decoded");
+    }
+
+    // Both streams requested from two threads at once
+    for (int round = 0; round < 200; round++) {
+        ShapeData shape;
+        int positionsRuns = 0;
+        int primitivesRuns = 0;
+        DeferVertexAndPrimitive(shape, false, positionsRuns, primitivesRuns);
+
+        bool primitivesDecoded = false;
+        std::thread reader([&]() { primitivesDecoded = shape.DecodeStream(ShapeStream::Primitives); });
+        bool positionsDecoded = shape.DecodeStream(ShapeStream::Positions);
+        reader.join();
+        Check(positionsDecoded && primitivesDecoded, "concurrent decode failed");
+        Check(positionsRuns == 1 && primitivesRuns == 1, "a decoder ran more than once concurrently");
+    }
+
+    const VertexFormat positions = VertexFormat::Positions();
+    const VertexFormat legacy = VertexFormat::Legacy();
+    const size_t vertexCount = 37;
+    {
+        ShapeData shape;
+        shape.SetVertexFormat(positions);
+        Check(shape.vertexStride == positions.GetFloatStride(), "vertexStride not derived from the format");
+        shape.Reset();
+        Check(shape.vertexStride == legacy.GetFloatStride(), "vertexStride not reset with the format");
+    }
+
+    // Unions pack the attributes of both formats in attribute order
+    {
+        Check(VertexFormat::Union(positions, legacy) == legacy && VertexFormat::Union(legacy, positions) == legacy,
+              "Positions and Legacy do not union to Legacy");
+        VertexFormat mixed = VertexFormat::Union(positions, TexCoords());
+        Check(mixed.GetAttributeCount() == 5 && mixed.GetFloatStride() == 5, "Positions + UV: %zu attributes, stride %zu",
+              mixed.GetAttributeCount(), mixed.GetFloatStride());
+        Check(mixed.GetFloatOffset(VertexAttribute::U) == 3 && mixed.GetFloatOffset(VertexAttribute::V) == 4,
+              "Positions + UV: UV at %zu/%zu, expected 3/4", mixed.GetFloatOffset(VertexAttribute::U),
+              mixed.GetFloatOffset(VertexAttribute::V));
+        Check(!mixed.Has(VertexAttribute::NX) && VertexFormat::Union(TexCoords(), positions) == mixed,
+              "union depends on operand order");
+    }
+
+    // Positions -> Legacy -> Positions: every attribute at its offset, the round trip bit-exact
+    {
+        std::vector<float> input = MakeVertices(positions, vertexCount);
+        std::vector<float> wide(vertexCount * legacy.GetFloatStride(), -1.0f);
+        VertexFormat::Convert(input.data(), positions, wide.data(), legacy, vertexCount);
+        bool placed = true;
+        for (size_t i = 0; i < vertexCount; i++) {
+            for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+                VertexAttribute attribute = static_cast<VertexAttribute>(a);
+                float expected = positions.Has(attribute) ? AttributeValue(i, attribute) : 0.0f;
+                placed &= wide[i * 8 + a] == expected;
+            }
+        }
+        Check(placed, "Positions -> Legacy misplaced an attribute or left one unwritten");
+
+        std::vector<float> back(input.size());
+        VertexFormat::Convert(wide.data(), legacy, back.data(), positions, vertexCount);
+        Check(std::memcmp(back.data(), input.data(), input.size() * sizeof(float)) == 0, "Positions -> Legacy -> Positions changed positions");
+
+        // Legacy -> UV only -> Legacy keeps UVs and zeroes the rest
+        std::vector<float> full = MakeVertices(legacy, vertexCount);
+        std::vector<float> uv(vertexCount * 2);
+        std::vector<float> restored(full.size(), -1.0f);
+        VertexFormat::Convert(full.data(), legacy, uv.data(), TexCoords(), vertexCount);
+        VertexFormat::Convert(uv.data(), TexCoords(), restored.data(), legacy, vertexCount);
+        bool uvKept = true;
+        for (size_t i = 0; i < vertexCount; i++) {
+            for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+                VertexAttribute attribute = static_cast<VertexAttribute>(a);
+                float expected = TexCoords().Has(attribute) ? AttributeValue(i, attribute) : 0.0f;
+                uvKept &= restored[i * 8 + a] == expected;
+            }
+        }
+        Check(uvKept, "Legacy -> UV -> Legacy lost UVs or kept dropped attributes");
+    }
+
+    // Merging slices of different formats widens the shape to their union
+    for (int order = 0; order < 2; order++) {
+        const VertexFormat& first = order == 0 ? positions : legacy;
+        const VertexFormat& second = order == 0 ? legacy : positions;
+        ShapeData shape;
+        ShapeData firstSlice;
+        ShapeData secondSlice;
+        FillShape(firstSlice, first, vertexCount);
+        FillShape(secondSlice, second, vertexCount, vertexCount);
+        shape.MergeSlice(firstSlice, 0);
+        shape.MergeSlice(secondSlice, vertexCount);
+
+        Check(shape.GetVertexFormat() == legacy && shape.vertexStride == 8, "merged format is not Legacy (order %d)", order);
+        Check(shape.GetVertexCount() == 2 * vertexCount, "%zu vertices merged (order %d)", shape.GetVertexCount(), order);
+        const float* vertices = shape.GetVertexBuffer();
+        bool placed = true;
+        for (size_t i = 0; i < 2 * vertexCount; i++) {
+            const VertexFormat& source = i < vertexCount ? first : second;
+            for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+                VertexAttribute attribute = static_cast<VertexAttribute>(a);
+                float expected = source.Has(attribute) ? AttributeValue(i, attribute) : 0.0f;
+                placed &= vertices[i * 8 + a] == expected;
+            }
+        }
+        Check(placed, "merged Positions/Legacy vertices not at their Legacy offsets (order %d)", order);
+    }
+    {
+        ShapeData shape;
+        ShapeData slice;
+        FillShape(shape, positions, vertexCount);
+        FillShape(slice, TexCoords(), vertexCount, vertexCount);
+        shape.MergeSlice(slice, vertexCount);
+
+        VertexFormat mixed = VertexFormat::Union(positions, TexCoords());
+        Check(shape.GetVertexFormat() == mixed && shape.vertexStride == 5, "Positions + UV slice: merged stride %u",
+              shape.vertexStride);
+        const float* vertices = shape.GetVertexBuffer();
+        bool placed = true;
+        for (size_t i = 0; i < 2 * vertexCount; i++) {
+            const VertexFormat& source = i < vertexCount ? positions : TexCoords();
+            for (VertexAttribute attribute : { VertexAttribute::X, VertexAttribute::Y, VertexAttribute::Z,
+                                               VertexAttribute::U, VertexAttribute::V }) {
+                float expected = source.Has(attribute) ? AttributeValue(i, attribute) : 0.0f;
+                placed &= vertices[i * 5 + mixed.GetFloatOffset(attribute)] == expected;
+            }
+        }
+        Check(placed, "Positions + UV slice: attributes not at their union offsets");
+    }
+
+    // Interleaved -> SoA -> interleaved is bit-exact; spans read the same values in both layouts
+    for (const VertexFormat& format : { legacy, positions, VertexFormat::Union(positions, TexCoords()) }) {
+        ShapeData shape;
+        FillShape(shape, format, vertexCount);
+        std::vector<float> interleaved(shape.GetVertexBuffer(), shape.GetVertexBuffer() + vertexCount * format.GetFloatStride());
+        Check(AttributesMatch(shape, format, vertexCount), "interleaved spans (stride %zu)", format.GetFloatStride());
+        Check(shape.GetAttribute(VertexAttribute::X).stride == format.GetFloatStride(), "interleaved span not strided");
+
+        shape.SetVertexLayout(VertexLayout::SoA);
+        Check(shape.GetVertexLayout() == VertexLayout::SoA && shape.GetVertexCount() == vertexCount, "SoA conversion lost vertices");
+        Check(AttributesMatch(shape, format, vertexCount), "SoA spans (stride %zu)", format.GetFloatStride());
+        Check(shape.GetAttribute(VertexAttribute::X).IsContiguous() && shape.GetAttribute(VertexAttribute::Y).IsContiguous(),
+              "SoA position spans not contiguous");
+
+        shape.SetVertexLayout(VertexLayout::Interleaved);
+        Check(shape.GetVertexFormat() == format, "round trip changed the format");
+        Check(std::memcmp(shape.GetVertexBuffer(), interleaved.data(), interleaved.size() * sizeof(float)) == 0,
+              "interleaved -> SoA -> interleaved not bit-exact (stride %zu)", format.GetFloatStride());
+    }
+
+    // A decode into an SoA shape lands in the streams directly
+    {
+        ShapeData shape;
+        shape.SetVertexLayout(VertexLayout::SoA);
+        FillShape(shape, legacy, vertexCount);
+        Check(AttributesMatch(shape, legacy, vertexCount), "SoA decode: spans differ from the decoded vertices");
+        Check(shape.GetVertexByteCount() == vertexCount * legacy.GetStride(), "SoA decode kept the interleaved buffer");
+    }
+
+    // Interleaved slices merge into an SoA shape, widening its streams
+    for (const VertexFormat& sliceFormat : { legacy, positions }) {
+        ShapeData shape;
+        shape.SetVertexLayout(VertexLayout::SoA);
+        ShapeData first;
+        ShapeData second;
+        FillShape(first, positions, vertexCount);
+        FillShape(second, sliceFormat, vertexCount, vertexCount);
+        shape.MergeSlice(first, 0);
+        shape.MergeSlice(second, vertexCount);
+
+        Check(shape.GetVertexLayout() == VertexLayout::SoA, "merge changed the layout");
+        Check(shape.GetVertexFormat() == sliceFormat && shape.GetVertexCount() == 2 * vertexCount,
+              "SoA merge: format or count wrong (slice stride %zu)", sliceFormat.GetFloatStride());
+        const ShapeData& merged = shape;
+        bool matches = true;
+        for (size_t a = 0; a < VertexFormat::ATTRIBUTE_COUNT; a++) {
+            VertexAttribute attribute = static_cast<VertexAttribute>(a);
+            ConstAttributeSpan span = merged.GetAttribute(attribute);
+            if (!sliceFormat.Has(attribute)) {
+                matches &= span.empty();
+                continue;
+            }
+            matches &= span.IsContiguous() && span.size() == 2 * vertexCount;
+            for (size_t i = 0; matches && i < 2 * vertexCount; i++) {
+                const VertexFormat& source = i < vertexCount ? positions : sliceFormat;
+                matches &= span[i] == (source.Has(attribute) ? AttributeValue(i, attribute) : 0.0f);
+            }
+        }
+        Check(matches, "SoA merge: streams differ from the slices (slice stride %zu)", sliceFormat.GetFloatStride());
+    }
+
+    return Finish("Deferred decoders reach streams in order, without deadlock; vertex formats and layouts convert and merge");
+}
@@ -0,0 +1,124 @@
+#include "TagScanner.h"
+#include "ByteSwap.h"
+#include "ChunkTypes.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Every SIMD kernel must report exactly the tags the scalar loop reports.
+ * A tag is planted at every offset of buffers that end anywhere inside
+ * and just past a 16/32-byte step, so tags straddle step boundaries and
+ * sit in the final partial block the SIMD loops leave to the scalar tail.
+ * Backgrounds are random bytes and runs of tag prefixes, which pass the
+ * SIMD filters but must be rejected by the full compare.
+ */
+
+namespace {
+
+typedef TagScanner::Kernel Kernel;
+
+std::vector<uint8_t> MakeBytes(size_t size, unsigned seed) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = static_cast<uint8_t>(seed >> 16);
+    }
+    return bytes;
+}
+
+/**
+ * Runs of the first three bytes of each known tag
+ */
+std::vector<uint8_t> MakePrefixes(size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        uint8_t tag[4];
+        ByteSwap::WriteLittleEndian32(tag, static_cast<uint32_t>(KnownChunkTypes[(i / 3) % KnownChunkTypeCount]));
+        bytes[i] = tag[i % 3];
+    }
+    return bytes;
+}
+
+void PlantTag(std::vector<uint8_t>& bytes, size_t offset, size_t tagIndex) {
+    ByteSwap::WriteLittleEndian32(bytes.data() + offset, static_cast<uint32_t>(KnownChunkTypes[tagIndex % KnownChunkTypeCount]));
+}
+
+/**
+ * All tag offsets from start on, under the current kernel
+ */
+std::vector<size_t> FindAll(const std::vector<uint8_t>& bytes, size_t start) {
+    std::vector<size_t> found;
+    size_t pos = TagScanner::FindNextTag(bytes.data(), bytes.size(), start);
+    while (pos < bytes.size()) {
+        found.push_back(pos);
+        pos = TagScanner::FindNextTag(bytes.data(), bytes.size(), pos + 1);
+    }
+    return found;
+}
+
+/**
+ * @return false if the kernel's matches differ from the scalar loop's
+ */
+bool MatchesScalar(Kernel kernel, const std::vector<uint8_t>& bytes, size_t start) {
+    TagScanner::SetKernel(Kernel::Scalar);
+    std::vector<size_t> expected = FindAll(bytes, start);
+    TagScanner::SetKernel(kernel);
+    return FindAll(bytes, start) == expected;
+}
+
+} // namespace
+
+int main() {
+    Kernel detected = TagScanner::GetKernel();
+    int compared = 0;
+
+    // Scalar sanity: a lone planted tag is found wherever it sits
+    TagScanner::SetKernel(Kernel::Scalar);
+    std::vector<uint8_t> zeros(80, 0);
+    for (size_t offset = 0; offset + 4 <= zeros.size(); offset++) {
+        std::vector<uint8_t> bytes = zeros;
+        PlantTag(bytes, offset, offset);
+        Check(FindAll(bytes, 0) == std::vector<size_t>{ offset }, "scalar missed a tag at %zu", offset);
+    }
+
+    for (Kernel kernel : { Kernel::SSE2, Kernel::AVX2 }) {
+        TagScanner::SetKernel(kernel);
+        if (TagScanner::GetKernel() != kernel) {
+            std::printf("%s not supported, skipped\n", TagScanner::GetKernelName(kernel));
+            continue;
+        }
+        compared++;
+        const char* name = TagScanner::GetKernelName(kernel);
+
+        // One tag at every offset, buffers ending at every byte of two 32-byte steps and beyond
+        for (size_t size = 4; size <= 3 * 32 + 4; size++) {
+            for (int background = 0; background < 2; background++) {
+                std::vector<uint8_t> base = background ? MakePrefixes(size) : MakeBytes(size, static_cast<unsigned>(size));
+                for (size_t offset = 0; offset + 4 <= size; offset++) {
+                    std::vector<uint8_t> bytes = base;
+                    PlantTag(bytes, offset, offset + size);
+                    for (size_t start : { size_t(0), offset, offset / 2 + 1 }) {
+                        Check(MatchesScalar(kernel, bytes, start), "%s: %zu-byte buffer, tag at %zu, scan from %zu",
+                              name, size, offset, start);
+                    }
+                }
+            }
+        }
+
+        // Dense tags across a large buffer, scanned from every start alignment of a step
+        std::vector<uint8_t> large = MakeBytes(1 << 20, 7);
+        std::vector<uint8_t> seeds = MakeBytes(4096, 11);
+        size_t offset = 0;
+        for (size_t i = 0; i < seeds.size() && offset + 4 <= large.size(); i++) {
+            PlantTag(large, offset, seeds[i]);
+            offset += 4 + seeds[i];
+        }
+        for (size_t start = 0; start < 33; start++) {
+            Check(MatchesScalar(kernel, large, start), "%s: large buffer, scan from %zu", name, start);
+        }
+    }
+    TagScanner::SetKernel(detected);
+
+    return Finish("%d SIMD tag kernel(s) match the scalar scan", compared);
+}
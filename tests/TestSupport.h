@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+/**
+ * Check harness shared by the test executables
+ * Check prints every condition that does not hold and counts it; Finish
+ * prints the summary line when nothing failed and returns the exit code.
+ * Messages are printf formats.
+ */
+
+inline int failures = 0;
+
+inline void Check(bool condition, const char* format, ...) {
+    if (!condition) {
+        va_list args;
+        va_start(args, format);
+        std::printf("FAIL: ");
+        std::vprintf(format, args);
+        std::printf("\n");
+        va_end(args);
+        failures++;
+    }
+}
+
+/**
+ * @return Process exit code: 0 if every check held
+ */
+inline int Finish(const char* format, ...) {
+    if (failures == 0) {
+        va_list args;
+        va_start(args, format);
+        std::vprintf(format, args);
+        std::printf("\n");
+        va_end(args);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#include "VertexProcessor.h"
+#include "ByteSwap.h"
+#include "GlobalVariables.h"
+#include "ThreadPool.h"
+#include "TestSupport.h"
+#include <cstring>
+#include <vector>
+
+/**
+ * ProcessBatch must write exactly what the single-call entry points write:
+ * the same floats, one terminator after the last vertex, and the same
+ * bounds and invalid mask once the tile stats are merged. Called from a
+ * task on its own pool, it must not wait on that pool's workers.
+ */
+
+namespace {
+
+bool SameStats(const PackedVertexKernel::DecodeStats& a, const PackedVertexKernel::DecodeStats& b) {
+    if (a.validCount != b.validCount || a.invalidCount != b.invalidCount || a.invalidMask != b.invalidMask) {
+        return false;
+    }
+    return !a.HasBounds() || (std::memcmp(a.min, b.min, sizeof(a.min)) == 0 && std::memcmp(a.max, b.max, sizeof(a.max)) == 0);
+}
+
+struct Case {
+    VertexProcessor::Algorithm algorithm;
+    size_t vertexCount;
+    size_t outputStride;
+};
+
+std::vector<uint8_t> MakeInput(const Case& test, unsigned seed) {
+    std::vector<uint8_t> input(VertexProcessor::CalculateInputSize(test.algorithm, test.vertexCount));
+    size_t first = 0;
+    if (test.algorithm == VertexProcessor::Algorithm::DecrunchDots) {
+        // A z scale large enough to overflow marks every vertex with a non-zero z invalid
+        const float params[6] = { 0.01f, 0.02f, 3.0e38f, 1.0f, -2.0f, 0.5f };
+        for (int i = 0; i < 6; i++) {
+            uint32_t bits;
+            std::memcpy(&bits, &params[i], sizeof(bits));
+            ByteSwap::WriteLittleEndian32(input.data() + i * 4, bits);
+        }
+        first = PackedVertexKernel::COMPRESSION_PARAMS_SIZE;
+    }
+    for (size_t i = first; i < input.size(); i++) {
+        seed = seed * 1103515245 + 12345;
+        input[i] = static_cast<uint8_t>(seed >> 16);
+    }
+    if (test.algorithm == VertexProcessor::Algorithm::DecrunchDots) {
+        for (size_t v = 0; v < test.vertexCount; v++) {
+            ByteSwap::WriteLittleEndian16(input.data() + first + v * 6 + 4, v % 97 == 0 ? 7 : 0);
+        }
+    }
+    return input;
+}
+
+bool RunSingle(const Case& test, const std::vector<uint8_t>& input, float* output, PackedVertexKernel::DecodeStats& stats) {
+    const uint32_t* packed = reinterpret_cast<const uint32_t*>(input.data());
+    switch (test.algorithm) {
+        case VertexProcessor::Algorithm::PackedToFloat:
+            return VertexProcessor::ConvertPackedToFloatVertices(packed, output, test.vertexCount, test.outputStride, &stats);
+        case VertexProcessor::Algorithm::PackedToFloat3Comp:
+            return VertexProcessor::ConvertPackedToFloatVertices3Component(packed, output, test.vertexCount, test.outputStride, &stats);
+        default:
+            return VertexProcessor::DecrunchDotsVertices(input.data(), output, test.vertexCount, test.outputStride, &stats);
+    }
+}
+
+} // namespace
+
+int main() {
+    // Several tiles with a partial last one, one partial tile, and a single vertex
+    const Case cases[] = {
+        { VertexProcessor::Algorithm::DecrunchDots,       20011, 9 },
+        { VertexProcessor::Algorithm::PackedToFloat3Comp, 30000, 8 },
+        { VertexProcessor::Algorithm::PackedToFloat,      17000, 3 },
+        { VertexProcessor::Algorithm::DecrunchDots,       100,   8 },
+        { VertexProcessor::Algorithm::PackedToFloat3Comp, 1,     8 },
+    };
+    const size_t caseCount = sizeof(cases) / sizeof(cases[0]);
+
+    uint32_t terminator = GlobalVariables::GetVertexTerminator();
+    ThreadPool pool(4);
+
+    for (ThreadPool* runOn : { static_cast<ThreadPool*>(nullptr), &pool }) {
+        std::vector<std::vector<uint8_t>> inputs;
+        std::vector<std::vector<float>> outputs;
+        std::vector<VertexProcessor::VertexJob> jobs(caseCount + 1);
+
+        for (size_t j = 0; j < caseCount; j++) {
+            const Case& test = cases[j];
+            inputs.push_back(MakeInput(test, static_cast<unsigned>(j + 1)));
+            // Poisoned so a float the batch forgets to write shows up
+            outputs.emplace_back(VertexProcessor::CalculateOutputSize(test.vertexCount, test.outputStride) + 1, -123.0f);
+
+            VertexProcessor::VertexJob& job = jobs[j];
+            job.algorithm = test.algorithm;
+            job.input = ByteSpan(inputs[j].data(), inputs[j].size());
+            job.output = outputs[j].data();
+            job.outputSize = outputs[j].size();
+            job.vertexCount = test.vertexCount;
+            job.outputStride = test.outputStride;
+            job.gatherStats = true;
+        }
+
+        // Output without room for the terminator fails alone
+        std::vector<float> tooSmall(VertexProcessor::CalculateOutputSize(10, 8));
+        jobs[caseCount].input = ByteSpan(inputs[1].data(), inputs[1].size());
+        jobs[caseCount].output = tooSmall.data();
+        jobs[caseCount].outputSize = tooSmall.size();
+        jobs[caseCount].vertexCount = 10;
+
+        Check(!VertexProcessor::ProcessBatch(jobs, runOn), "job %zu: batch with a bad job reported success", caseCount);
+        Check(!jobs[caseCount].succeeded && jobs[caseCount].tileCount == 0, "job %zu: bad job ran", caseCount);
+
+        for (size_t j = 0; j < caseCount; j++) {
+            const Case& test = cases[j];
+            const VertexProcessor::VertexJob& job = jobs[j];
+            size_t tileVertices = VertexProcessor::GetTileVertexCount(test.outputStride);
+
+            std::vector<float> expected(outputs[j].size(), -123.0f);
+            PackedVertexKernel::DecodeStats expectedStats;
+            Check(RunSingle(test, inputs[j], expected.data(), expectedStats), "job %zu: single call failed", j);
+
+            Check(job.succeeded, "job %zu: failed", j);
+            Check(job.tileCount == (test.vertexCount + tileVertices - 1) / tileVertices, "job %zu: wrong tile count", j);
+            Check(std::memcmp(outputs[j].data(), expected.data(), outputs[j].size() * sizeof(float)) == 0,
+                  "job %zu: output differs from the single call", j);
+
+            uint32_t written;
+            std::memcpy(&written, &outputs[j][outputs[j].size() - 1], sizeof(written));
+            Check(written == terminator, "job %zu: terminator missing", j);
+            Check(SameStats(job.stats, expectedStats), "job %zu: stats differ from the single call", j);
+        }
+        Check(jobs[0].stats.invalidCount > 0, "job 0: no invalid vertices exercised");
+        Check(jobs[0].tileCount > 2, "job 0: too few tiles exercised");
+    }
+
+    // The only worker of a pool batches on that pool: tiles run on the worker itself
+    {
+        ThreadPool single(1);
+        const Case test = cases[0];
+        std::vector<uint8_t> input = MakeInput(test, 1);
+        std::vector<float> output(VertexProcessor::CalculateOutputSize(test.vertexCount, test.outputStride) + 1);
+        std::vector<VertexProcessor::VertexJob> jobs(1);
+        jobs[0].algorithm = test.algorithm;
+        jobs[0].input = ByteSpan(input.data(), input.size());
+        jobs[0].output = output.data();
+        jobs[0].outputSize = output.size();
+        jobs[0].vertexCount = test.vertexCount;
+        jobs[0].outputStride = test.outputStride;
+
+        bool succeeded = single.Submit([&]() { return VertexProcessor::ProcessBatch(jobs, &single); }).get();
+        Check(succeeded && jobs[0].tileCount > 1, "job 0: batch from a worker of its pool failed");
+    }
+
+    return Finish("ProcessBatch matches the single calls");
+}